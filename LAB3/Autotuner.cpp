@@ -0,0 +1,118 @@
+#include "Autotuner.h"
+#include "ComplexGemm.h"
+#include "LUFactorization.h"
+#include "ParallelStrassen.h"
+#include "Strassen.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+
+namespace {
+    /// @brief Shortest wall time of run over the given number of repetitions, in seconds.
+    template <typename Run>
+    double bestSeconds(int repetitions, Run run)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (int r = 0; r < std::max(1, repetitions); r++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double>(end - start).count());
+        }
+        return best;
+    }
+
+    /// @brief Activates each candidate value of one field in turn, keeps the fastest one active
+    /// and returns it. An empty candidate list leaves the field as it is.
+    template <typename Value, typename Run>
+    Value pickFastest(TuningProfile& profile, Value TuningProfile::* field, const std::vector<Value>& candidates, int repetitions, Run run)
+    {
+        Value winner = profile.*field;
+        double winnerSeconds = std::numeric_limits<double>::max();
+        for (Value candidate : candidates)
+        {
+            profile.*field = candidate;
+            TuningProfile::setActive(profile);
+            double seconds = bestSeconds(repetitions, run);
+            if (seconds < winnerSeconds)
+            {
+                winnerSeconds = seconds;
+                winner = candidate;
+            }
+        }
+        profile.*field = winner;
+        TuningProfile::setActive(profile);
+        return winner;
+    }
+
+    std::vector<unsigned int> threadCandidates(const AutotuneOptions& options)
+    {
+        if (!options.threads.empty())
+            return options.threads;
+
+        unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<unsigned int> counts;
+        for (unsigned int count = 1; count < hardware; count *= 2)
+            counts.push_back(count);
+        counts.push_back(hardware);
+        return counts;
+    }
+}
+
+TuningProfile Autotuner::tune(const AutotuneOptions& options)
+{
+    const int size = std::max(1, options.size);
+    ComplexMatrix a(size, size);
+    ComplexMatrix b(size, size);
+    ComplexMatrix c(size, size);
+    a.auto_gen(-1, 1, -1, 1);
+    b.auto_gen(-1, 1, -1, 1);
+
+    TuningProfile profile = TuningProfile::defaults();
+    TuningProfile::setActive(profile);
+
+    auto gemm = [&]() {
+        ComplexGemm::multiply(ComplexMatrixView(a), ComplexMatrixView(b), ComplexMatrixView(c));
+    };
+    pickFastest(profile, &TuningProfile::gemmRowBlock, options.gemmRowBlocks, options.repetitions, gemm);
+    pickFastest(profile, &TuningProfile::gemmDepthBlock, options.gemmDepthBlocks, options.repetitions, gemm);
+    pickFastest(profile, &TuningProfile::gemmColumnBlock, options.gemmColumnBlocks, options.repetitions, gemm);
+
+    pickFastest(profile, &TuningProfile::strassenCutoff, options.strassenCutoffs, options.repetitions, [&]() {
+        Strassen::strassenRecursion(ComplexMatrixView(a), ComplexMatrixView(b), ComplexMatrixView(c));
+    });
+
+    auto parallelMultiply = [&]() {
+        delete ParallelStrassen::parallelMultiply(&a, &b);
+    };
+    pickFastest(profile, &TuningProfile::parallelBlockSize, options.parallelBlockSizes, options.repetitions, parallelMultiply);
+
+    // Every parallel engine shares this count, so it is timed on the blocked parallel GEMM that
+    // dominates their work rather than on any one factorization.
+    pickFastest(profile, &TuningProfile::threads, threadCandidates(options), options.repetitions, parallelMultiply);
+
+    // With one thread the split of the trailing update never happens, so there is nothing to time.
+    if (profile.threadCount() > 1)
+    {
+        pickFastest(profile, &TuningProfile::luRowsPerThread, options.luRowsPerThread, options.repetitions, [&]() {
+            LUFactorization factorization(a, profile.threadCount());
+        });
+    }
+
+    auto parallelStrassen = [&]() {
+        delete ParallelStrassen::strassenMultiply(&a, &b);
+    };
+    pickFastest(profile, &TuningProfile::strassenTaskSize, options.strassenTaskSizes, options.repetitions, parallelStrassen);
+    pickFastest(profile, &TuningProfile::strassenTaskDepth, options.strassenTaskDepths, options.repetitions, parallelStrassen);
+
+    return profile;
+}
+
+TuningProfile Autotuner::tuneAndSave(const std::string& path, const AutotuneOptions& options)
+{
+    TuningProfile profile = tune(options);
+    profile.save(path);
+    return profile;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "TuningProfile.h"
+#include <string>
+#include <vector>
+
+/// @brief What the Autotuner measures: the benchmark problem and the candidates of each parameter.
+struct AutotuneOptions
+{
+    /// @brief Edge of the square complex double matrices every candidate is timed on.
+    int size = 512;
+    /// @brief Each candidate keeps its best time over this many runs.
+    int repetitions = 3;
+    std::vector<int> strassenCutoffs = { 64, 128, 192, 256, 384, 512 };
+    std::vector<int> gemmRowBlocks = { 64, 96, 128, 192, 256 };
+    std::vector<int> gemmDepthBlocks = { 128, 192, 256, 384, 512 };
+    std::vector<int> gemmColumnBlocks = { 512, 1024, 2048, 4096 };
+    std::vector<int> parallelBlockSizes = { 64, 128, 256, 512 };
+    std::vector<int> luRowsPerThread = { 16, 32, 64, 128, 256 };
+    std::vector<int> strassenTaskDepths = { 1, 2, 3 };
+    std::vector<int> strassenTaskSizes = { 128, 256, 512 };
+    /// @brief Thread counts to try; empty means powers of two up to the hardware thread count, and that count.
+    std::vector<unsigned int> threads;
+};
+
+/// @brief Picks the engine parameters of a TuningProfile by timing candidates on this machine.
+/// Parameters are tuned one after another, each with the winners so far active: the GEMM blocks
+/// first (every other engine ends in the GEMM), then the Strassen cutoff, the ParallelStrassen
+/// block size, the thread count (timed on ParallelStrassen::parallelMultiply, as every parallel
+/// engine shares it), the LU rows per thread and the task bounds of parallel Strassen. Tuning
+/// switches the active profile while it measures and leaves the winner active, so nothing else
+/// may multiply meanwhile. ThreadPool::shared() is sized once per process, so thread counts above
+/// its size time the same as its size, and a tuned count larger than the running pool only takes
+/// effect when a later process loads the saved profile.
+class Autotuner
+{
+public:
+    /// @brief Measures every candidate and returns the fastest profile.
+    static TuningProfile tune(const AutotuneOptions& options = AutotuneOptions());
+
+    /// @brief tune(), then saves the result for the engines to load on their next start.
+    static TuningProfile tuneAndSave(const std::string& path = TuningProfile::hostPath(), const AutotuneOptions& options = AutotuneOptions());
+};
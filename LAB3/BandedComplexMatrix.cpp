@@ -0,0 +1,203 @@
+#include "BandedComplexMatrix.h"
+#include <algorithm>
+#include <cstdlib>
+
+template <typename T>
+BasicBandedComplexMatrix<T>::BasicBandedComplexMatrix(int size, int lower, int upper)
+    : size(size), lower(lower), upper(upper),
+    band(static_cast<std::size_t>(size) * (lower + upper + 1))
+{
+    assert(size >= 0 && lower >= 0 && upper >= 0);
+}
+
+template <typename T>
+BasicBandedComplexMatrix<T> BasicBandedComplexMatrix<T>::fromDense(const BasicComplexMatrix<T>& dense, int lower, int upper)
+{
+    assert(dense.getRows() == dense.getColumns());
+    const int n = dense.getRows();
+
+    BasicBandedComplexMatrix<T> result(n, lower, upper);
+    for (int i = 0; i < n; i++)
+        for (int j = std::max(0, i - lower); j <= std::min(n - 1, i + upper); j++)
+            result.set(i, j, dense.get(i, j));
+    return result;
+}
+
+template <typename T>
+void BasicBandedComplexMatrix<T>::bandwidth(const BasicComplexMatrix<T>& dense, int& lower, int& upper)
+{
+    assert(dense.getRows() == dense.getColumns());
+    const int n = dense.getRows();
+
+    lower = 0;
+    upper = 0;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < i - lower; j++)
+        {
+            if (!dense.get(i, j).isNull())
+            {
+                lower = i - j;
+                break;
+            }
+        }
+        for (int j = n - 1; j > i + upper; j--)
+        {
+            if (!dense.get(i, j).isNull())
+            {
+                upper = j - i;
+                break;
+            }
+        }
+    }
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicBandedComplexMatrix<T>::toDense() const
+{
+    BasicComplexMatrix<T> result(size, size);
+    for (int i = 0; i < size; i++)
+        for (int j = std::max(0, i - lower); j <= std::min(size - 1, i + upper); j++)
+            result.set(i, j, get(i, j));
+    return result;
+}
+
+template <typename T>
+int BasicBandedComplexMatrix<T>::getSize() const
+{
+    return size;
+}
+
+template <typename T>
+int BasicBandedComplexMatrix<T>::getLower() const
+{
+    return lower;
+}
+
+template <typename T>
+int BasicBandedComplexMatrix<T>::getUpper() const
+{
+    return upper;
+}
+
+template <typename T>
+bool BasicBandedComplexMatrix<T>::inBand(int i, int j) const
+{
+    return j - i <= upper && i - j <= lower;
+}
+
+template <typename T>
+BasicComplexNum<T> BasicBandedComplexMatrix<T>::get(int i, int j) const
+{
+    assert(i >= 0 && i < size && j >= 0 && j < size);
+    if (!inBand(i, j))
+        return BasicComplexNum<T>();
+    return band[static_cast<std::size_t>(i) * (lower + upper + 1) + (j - i + lower)];
+}
+
+template <typename T>
+void BasicBandedComplexMatrix<T>::set(int i, int j, BasicComplexNum<T> num)
+{
+    assert(i >= 0 && i < size && j >= 0 && j < size);
+    assert(inBand(i, j));
+    band[static_cast<std::size_t>(i) * (lower + upper + 1) + (j - i + lower)] = num;
+}
+
+template <typename T>
+void BasicBandedComplexMatrix<T>::multiply(const BasicComplexNum<T>* x, BasicComplexNum<T>* y) const
+{
+    const int width = lower + upper + 1;
+    for (int i = 0; i < size; i++)
+    {
+        const BasicComplexNum<T>* row = band.data() + static_cast<std::size_t>(i) * width;
+        BasicComplexNum<T> sum;
+        for (int j = std::max(0, i - lower); j <= std::min(size - 1, i + upper); j++)
+            sum.addProduct(row[j - i + lower], x[j]);
+        y[i] = sum;
+    }
+}
+
+template <typename T>
+BasicTridiagonalComplexMatrix<T>::BasicTridiagonalComplexMatrix(int size)
+    : subDiagonal(std::max(0, size - 1)), diagonal(size), superDiagonal(std::max(0, size - 1))
+{
+    assert(size >= 0);
+}
+
+template <typename T>
+int BasicTridiagonalComplexMatrix<T>::getSize() const
+{
+    return static_cast<int>(diagonal.size());
+}
+
+template <typename T>
+BasicComplexNum<T> BasicTridiagonalComplexMatrix<T>::get(int i, int j) const
+{
+    assert(i >= 0 && i < getSize() && j >= 0 && j < getSize());
+    if (i == j)
+        return diagonal[i];
+    if (j == i + 1)
+        return superDiagonal[i];
+    if (j == i - 1)
+        return subDiagonal[j];
+    return BasicComplexNum<T>();
+}
+
+template <typename T>
+void BasicTridiagonalComplexMatrix<T>::set(int i, int j, BasicComplexNum<T> num)
+{
+    assert(i >= 0 && i < getSize() && j >= 0 && j < getSize());
+    assert(std::abs(i - j) <= 1);
+    if (i == j)
+        diagonal[i] = num;
+    else if (j == i + 1)
+        superDiagonal[i] = num;
+    else
+        subDiagonal[j] = num;
+}
+
+template <typename T>
+BasicBandedComplexMatrix<T> BasicTridiagonalComplexMatrix<T>::toBanded() const
+{
+    const int n = getSize();
+    BasicBandedComplexMatrix<T> result(n, 1, 1);
+    for (int i = 0; i < n; i++)
+    {
+        result.set(i, i, diagonal[i]);
+        if (i + 1 < n)
+        {
+            result.set(i, i + 1, superDiagonal[i]);
+            result.set(i + 1, i, subDiagonal[i]);
+        }
+    }
+    return result;
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicTridiagonalComplexMatrix<T>::toDense() const
+{
+    return toBanded().toDense();
+}
+
+template <typename T>
+void BasicTridiagonalComplexMatrix<T>::multiply(const BasicComplexNum<T>* x, BasicComplexNum<T>* y) const
+{
+    const int n = getSize();
+    for (int i = 0; i < n; i++)
+    {
+        BasicComplexNum<T> sum = diagonal[i] * x[i];
+        if (i > 0)
+            sum.addProduct(subDiagonal[i - 1], x[i - 1]);
+        if (i + 1 < n)
+            sum.addProduct(superDiagonal[i], x[i + 1]);
+        y[i] = sum;
+    }
+}
+
+template class BasicBandedComplexMatrix<float>;
+template class BasicBandedComplexMatrix<double>;
+template class BasicBandedComplexMatrix<long double>;
+
+template class BasicTridiagonalComplexMatrix<float>;
+template class BasicTridiagonalComplexMatrix<double>;
+template class BasicTridiagonalComplexMatrix<long double>;
@@ -0,0 +1,79 @@
+#pragma once
+#include "ComplexMatrix.h"
+#include <vector>
+
+/// @brief Square complex band matrix with kl sub-diagonals and ku super-diagonals.
+/// Row i keeps the kl + ku + 1 entries of columns [i - kl, i + ku] contiguously, so memory is
+/// O(n * (kl + ku)) and a row of the band is one cache-friendly run.
+template <typename T>
+class BasicBandedComplexMatrix
+{
+private:
+    int size;
+    int lower;
+    int upper;
+    std::vector<BasicComplexNum<T>> band;
+
+public:
+    BasicBandedComplexMatrix(int size = 0, int lower = 0, int upper = 0);
+
+    /// @brief Copies the band of a square dense matrix; entries outside it must be zero.
+    static BasicBandedComplexMatrix fromDense(const BasicComplexMatrix<T>& dense, int lower, int upper);
+
+    /// @brief Number of non-zero sub- and super-diagonals of a square dense matrix.
+    static void bandwidth(const BasicComplexMatrix<T>& dense, int& lower, int& upper);
+
+    BasicComplexMatrix<T> toDense() const;
+
+    int getSize() const;
+
+    int getLower() const;
+
+    int getUpper() const;
+
+    bool inBand(int i, int j) const;
+
+    /// @brief Element (i, j); zero outside the band.
+    BasicComplexNum<T> get(int i, int j) const;
+
+    /// @brief Sets element (i, j), which must lie inside the band.
+    void set(int i, int j, BasicComplexNum<T> num);
+
+    /// @brief y = A * x in O(n * (kl + ku)).
+    void multiply(const BasicComplexNum<T>* x, BasicComplexNum<T>* y) const;
+};
+
+/// @brief Tridiagonal complex matrix: sub-diagonal (n - 1), diagonal (n) and super-diagonal (n - 1).
+template <typename T>
+class BasicTridiagonalComplexMatrix
+{
+private:
+    std::vector<BasicComplexNum<T>> subDiagonal;
+    std::vector<BasicComplexNum<T>> diagonal;
+    std::vector<BasicComplexNum<T>> superDiagonal;
+
+public:
+    explicit BasicTridiagonalComplexMatrix(int size = 0);
+
+    int getSize() const;
+
+    BasicComplexNum<T> get(int i, int j) const;
+
+    /// @brief Sets element (i, j); |i - j| must be at most one.
+    void set(int i, int j, BasicComplexNum<T> num);
+
+    /// @brief The same matrix as a band with kl = ku = 1, for factorization.
+    BasicBandedComplexMatrix<T> toBanded() const;
+
+    BasicComplexMatrix<T> toDense() const;
+
+    void multiply(const BasicComplexNum<T>* x, BasicComplexNum<T>* y) const;
+};
+
+using BandedComplexMatrixF = BasicBandedComplexMatrix<float>;
+using BandedComplexMatrix = BasicBandedComplexMatrix<double>;
+using BandedComplexMatrixL = BasicBandedComplexMatrix<long double>;
+
+using TridiagonalComplexMatrixF = BasicTridiagonalComplexMatrix<float>;
+using TridiagonalComplexMatrix = BasicTridiagonalComplexMatrix<double>;
+using TridiagonalComplexMatrixL = BasicTridiagonalComplexMatrix<long double>;
@@ -0,0 +1,149 @@
+#include "BandedLUFactorization.h"
+#include <algorithm>
+
+namespace {
+    template <typename T>
+    T magnitude(const BasicComplexNum<T>& value)
+    {
+        return std::abs(value.getReal()) + std::abs(value.getImag());
+    }
+}
+
+template <typename T>
+BasicBandedLUFactorization<T>::BasicBandedLUFactorization(const BasicBandedComplexMatrix<T>& matrix)
+    : size(matrix.getSize()), lower(matrix.getLower()), upper(matrix.getUpper()),
+    width(2 * matrix.getLower() + matrix.getUpper() + 1),
+    work(static_cast<std::size_t>(matrix.getSize()) * (2 * matrix.getLower() + matrix.getUpper() + 1)),
+    pivots(matrix.getSize()), invertible(false)
+{
+    for (int i = 0; i < size; i++)
+        for (int j = std::max(0, i - lower); j <= std::min(size - 1, i + upper); j++)
+            at(i, j) = matrix.get(i, j);
+
+    for (int k = 0; k < size; k++)
+    {
+        const int lastRow = std::min(size - 1, k + lower);
+        const int lastColumn = std::min(size - 1, k + lower + upper);
+
+        int pivot = k;
+        T best = magnitude(at(k, k));
+        for (int i = k + 1; i <= lastRow; i++)
+        {
+            T candidate = magnitude(at(i, k));
+            if (candidate > best)
+            {
+                best = candidate;
+                pivot = i;
+            }
+        }
+
+        pivots[k] = pivot;
+        if (at(pivot, k).isNull())
+            return;
+        if (pivot != k)
+            for (int j = k; j <= lastColumn; j++)
+                std::swap(at(k, j), at(pivot, j));
+
+        const BasicComplexNum<T> diagonal = at(k, k);
+        for (int i = k + 1; i <= lastRow; i++)
+        {
+            BasicComplexNum<T> factor = at(i, k) / diagonal;
+            at(i, k) = factor;
+            if (factor.isNull())
+                continue;
+            for (int j = k + 1; j <= lastColumn; j++)
+                at(i, j).subtractProduct(factor, at(k, j));
+        }
+    }
+
+    invertible = true;
+}
+
+template <typename T>
+BasicBandedLUFactorization<T>::BasicBandedLUFactorization(const BasicTridiagonalComplexMatrix<T>& matrix)
+    : BasicBandedLUFactorization(matrix.toBanded()) {}
+
+template <typename T>
+BasicComplexNum<T>& BasicBandedLUFactorization<T>::at(int i, int j)
+{
+    return work[static_cast<std::size_t>(i) * width + (j - i + lower)];
+}
+
+template <typename T>
+const BasicComplexNum<T>& BasicBandedLUFactorization<T>::at(int i, int j) const
+{
+    return work[static_cast<std::size_t>(i) * width + (j - i + lower)];
+}
+
+template <typename T>
+int BasicBandedLUFactorization<T>::getSize() const
+{
+    return size;
+}
+
+template <typename T>
+bool BasicBandedLUFactorization<T>::isInvertible() const
+{
+    return invertible;
+}
+
+template <typename T>
+const std::vector<int>& BasicBandedLUFactorization<T>::getPivots() const
+{
+    return pivots;
+}
+
+template <typename T>
+void BasicBandedLUFactorization<T>::solve(BasicComplexNum<T>* vector) const
+{
+    assert(invertible);
+
+    for (int k = 0; k < size; k++)
+    {
+        if (pivots[k] != k)
+            std::swap(vector[k], vector[pivots[k]]);
+        const BasicComplexNum<T> value = vector[k];
+        if (value.isNull())
+            continue;
+        for (int i = k + 1; i <= std::min(size - 1, k + lower); i++)
+            vector[i].subtractProduct(at(i, k), value);
+    }
+
+    for (int i = size - 1; i >= 0; i--)
+    {
+        BasicComplexNum<T> toAdd = vector[i];
+        for (int j = i + 1; j <= std::min(size - 1, i + lower + upper); j++)
+            toAdd.subtractProduct(at(i, j), vector[j]);
+        vector[i] = toAdd / at(i, i);
+    }
+}
+
+template <typename T>
+std::vector<BasicComplexNum<T>> BasicBandedLUFactorization<T>::solve(const std::vector<BasicComplexNum<T>>& rhs) const
+{
+    assert(static_cast<int>(rhs.size()) == size);
+    std::vector<BasicComplexNum<T>> result(rhs);
+    solve(result.data());
+    return result;
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicBandedLUFactorization<T>::inverse() const
+{
+    assert(invertible);
+
+    BasicComplexMatrix<T> result(size, size);
+    std::vector<BasicComplexNum<T>> column(size);
+    for (int c = 0; c < size; c++)
+    {
+        std::fill(column.begin(), column.end(), BasicComplexNum<T>());
+        column[c] = BasicComplexNum<T>(1, 0);
+        solve(column.data());
+        result.setColumn(c, column.data());
+    }
+    return result;
+}
+
+template class BasicBandedLUFactorization<float>;
+template class BasicBandedLUFactorization<double>;
+template class BasicBandedLUFactorization<long double>;
@@ -0,0 +1,47 @@
+#pragma once
+#include "BandedComplexMatrix.h"
+#include <vector>
+
+/// @brief Band LU with partial pivoting in O(n * kl * (kl + ku)) time and O(n * (2kl + ku)) memory.
+/// Row i of the work array holds columns [i - kl, i + ku + kl]: pivoting can push U's fill up to
+/// kl extra super-diagonals. The multipliers of step k stay in column k of rows k + 1 .. k + kl
+/// and are applied as a sequence of Gauss transforms interleaved with the row interchanges
+/// (as in LAPACK gbtrf/gbtrs), so rows are only ever swapped to the right of the pivot column.
+template <typename T>
+class BasicBandedLUFactorization
+{
+private:
+    int size;
+    int lower;
+    int upper;
+    int width;
+    std::vector<BasicComplexNum<T>> work;
+    std::vector<int> pivots;
+    bool invertible;
+
+    BasicComplexNum<T>& at(int i, int j);
+
+    const BasicComplexNum<T>& at(int i, int j) const;
+
+public:
+    explicit BasicBandedLUFactorization(const BasicBandedComplexMatrix<T>& matrix);
+
+    explicit BasicBandedLUFactorization(const BasicTridiagonalComplexMatrix<T>& matrix);
+
+    int getSize() const;
+
+    /// @brief False when a pivot column has no non-zero entry.
+    bool isInvertible() const;
+
+    const std::vector<int>& getPivots() const;
+
+    /// @brief Solves A * x = b in place in O(n * (kl + ku)): vector holds b on entry and x on return.
+    void solve(BasicComplexNum<T>* vector) const;
+
+    std::vector<BasicComplexNum<T>> solve(const std::vector<BasicComplexNum<T>>& rhs) const;
+
+    /// @brief Dense A^-1, one band solve per column: O(n^2 * (kl + ku)) instead of O(n^3).
+    BasicComplexMatrix<T> inverse() const;
+};
+
+using BandedLUFactorization = BasicBandedLUFactorization<double>;
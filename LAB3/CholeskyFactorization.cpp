@@ -0,0 +1,158 @@
+#include "CholeskyFactorization.h"
+#include "ComplexGemv.h"
+#include "ComplexKernels.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+    template <typename T>
+    BasicComplexNum<T> divideByReal(const BasicComplexNum<T>& value, T divisor)
+    {
+        return BasicComplexNum<T>(value.getReal() / divisor, value.getImag() / divisor);
+    }
+}
+
+template <typename T>
+BasicCholeskyFactorization<T>::BasicCholeskyFactorization(const BasicComplexMatrix<T>& matrix)
+    : factor(), size(matrix.getRows()), positiveDefinite(false)
+{
+    if (matrix.getRows() != matrix.getColumns())
+    {
+        size = 0;
+        return;
+    }
+
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    factor = BasicComplexMatrix<T>(size, size);
+    for (int i = 0; i < size; i++)
+    {
+        BasicComplexNum<T>* row = factor.row(i);
+        for (int j = 0; j <= i; j++)
+            row[j] = matrix.get(i, j);
+
+        // l_ij = (a_ij - sum_k l_ik * conj(l_jk)) / l_jj over the prefixes of rows i and j.
+        for (int j = 0; j < i; j++)
+        {
+            const BasicComplexNum<T>* pivotRow = factor.row(j);
+            row[j] = divideByReal(row[j] - kernels.dotc(j, pivotRow, row), pivotRow[j].getReal());
+        }
+
+        const T pivot = row[i].getReal() - kernels.dotc(i, row, row).getReal();
+        if (!(pivot > T()))
+            return;
+        row[i] = BasicComplexNum<T>(std::sqrt(pivot), 0);
+    }
+    positiveDefinite = true;
+}
+
+template <typename T>
+int BasicCholeskyFactorization<T>::getSize() const
+{
+    return size;
+}
+
+template <typename T>
+bool BasicCholeskyFactorization<T>::isPositiveDefinite() const
+{
+    return positiveDefinite;
+}
+
+template <typename T>
+const BasicComplexMatrix<T>& BasicCholeskyFactorization<T>::lower() const
+{
+    return factor;
+}
+
+template <typename T>
+void BasicCholeskyFactorization<T>::solve(BasicComplexNum<T>* vector) const
+{
+    assert(positiveDefinite);
+
+    // L * y = b, then L^H * x = y. As in LUFactorization::solve, each SOLVE_BLOCK rows take the
+    // part outside their diagonal block in one GEMV; L^H is applied by reading L's rows.
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    const BasicComplexNum<T> minusOne(-1, 0);
+    const BasicComplexNum<T> one(1, 0);
+    BasicComplexMatrixView<T> factors(const_cast<BasicComplexMatrix<T>&>(factor));
+
+    for (int blockStart = 0; blockStart < size; blockStart += SOLVE_BLOCK)
+    {
+        const int blockEnd = std::min(size, blockStart + SOLVE_BLOCK);
+        if (blockStart > 0)
+            BasicComplexGemv<T>::multiply(GemvOperation::NoTranspose, minusOne,
+                factors.block(blockStart, 0, blockEnd - blockStart, blockStart), vector, one, vector + blockStart);
+        for (int i = blockStart; i < blockEnd; i++)
+        {
+            const BasicComplexNum<T>* row = factor.row(i);
+            vector[i] = divideByReal(vector[i] - kernels.dot(i - blockStart, row + blockStart, vector + blockStart), row[i].getReal());
+        }
+    }
+
+    for (int blockEnd = size; blockEnd > 0; blockEnd -= SOLVE_BLOCK)
+    {
+        const int blockStart = std::max(0, blockEnd - SOLVE_BLOCK);
+        if (blockEnd < size)
+            BasicComplexGemv<T>::multiply(GemvOperation::ConjugateTranspose, minusOne,
+                factors.block(blockEnd, blockStart, size - blockEnd, blockEnd - blockStart), vector + blockEnd, one, vector + blockStart);
+        for (int i = blockEnd - 1; i >= blockStart; i--)
+        {
+            BasicComplexNum<T> sum = vector[i];
+            for (int k = i + 1; k < blockEnd; k++)
+            {
+                BasicComplexNum<T> element = factor.row(k)[i];
+                sum -= BasicComplexNum<T>(element.getReal(), -element.getImag()) * vector[k];
+            }
+            vector[i] = divideByReal(sum, factor.row(i)[i].getReal());
+        }
+    }
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicCholeskyFactorization<T>::inverse(unsigned int threads) const
+{
+    assert(positiveDefinite);
+
+    BasicComplexMatrix<T> result(size, size);
+    auto solveColumns = [&](int firstColumn, int lastColumn) {
+        std::vector<BasicComplexNum<T>> column(size);
+        for (int c = firstColumn; c < lastColumn; c++)
+        {
+            std::fill(column.begin(), column.end(), BasicComplexNum<T>());
+            column[c] = BasicComplexNum<T>(1, 0);
+            solve(column.data());
+            result.setColumn(c, column.data());
+        }
+    };
+
+    int workers = std::max(1, std::min<int>(threads, size));
+    if (workers == 1)
+        solveColumns(0, size);
+    else
+    {
+        int chunk = (size + workers - 1) / workers;
+        ThreadPool::shared().parallelFor((size + chunk - 1) / chunk, [&](int part) {
+            solveColumns(part * chunk, std::min((part + 1) * chunk, size));
+        }, workers);
+    }
+
+    // The columns are solved independently, so mirror the lower triangle to make the result
+    // exactly Hermitian, as MatrixInverseFactory checks before trusting the flag.
+    for (int i = 0; i < size; i++)
+    {
+        BasicComplexNum<T>* row = result.row(i);
+        row[i] = BasicComplexNum<T>(row[i].getReal(), 0);
+        for (int j = i + 1; j < size; j++)
+        {
+            BasicComplexNum<T> value = result.row(j)[i];
+            row[j] = BasicComplexNum<T>(value.getReal(), -value.getImag());
+        }
+    }
+    result.setHermitian(true);
+    return result;
+}
+
+template class BasicCholeskyFactorization<float>;
+template class BasicCholeskyFactorization<double>;
+template class BasicCholeskyFactorization<long double>;
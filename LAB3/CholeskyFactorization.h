@@ -0,0 +1,39 @@
+#pragma once
+#include "ComplexMatrix.h"
+
+/// @brief Cholesky factorization A = L * L^H of a Hermitian positive definite matrix, for the
+/// Gram and covariance matrices ComplexHerk produces. Only the lower triangle of the input is
+/// read. L is formed row by row (the Cholesky-Crout order), so every update is a conjugated dot
+/// product of two contiguous row prefixes; it needs no pivoting and half the work of LU.
+template <typename T>
+class BasicCholeskyFactorization
+{
+private:
+    BasicComplexMatrix<T> factor;
+    int size;
+    bool positiveDefinite;
+
+public:
+    /// @brief Rows of a triangle solved directly in solve(); the rest is applied with ComplexGemv.
+    static constexpr int SOLVE_BLOCK = 64;
+
+    explicit BasicCholeskyFactorization(const BasicComplexMatrix<T>& matrix);
+
+    int getSize() const;
+
+    /// @brief False for non-square input or when a pivot is not positive, i.e. the matrix is not
+    /// Hermitian positive definite (up to rounding).
+    bool isPositiveDefinite() const;
+
+    /// @brief L on and below the diagonal (with a real, positive diagonal); zeros above it.
+    const BasicComplexMatrix<T>& lower() const;
+
+    /// @brief Solves A * x = b in place: vector holds b on entry and x on return.
+    void solve(BasicComplexNum<T>* vector) const;
+
+    /// @brief A^-1, flagged Hermitian, one solve per column of the identity; columns are split
+    /// between up to threads workers of the shared ThreadPool.
+    BasicComplexMatrix<T> inverse(unsigned int threads = 1) const;
+};
+
+using CholeskyFactorization = BasicCholeskyFactorization<double>;
@@ -0,0 +1,537 @@
+#include "ComplexBatch.h"
+#include "ComplexKernels.h"
+#include "ThreadPool.h"
+#include "TuningProfile.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define COMPLEX_BATCH_X86
+#endif
+
+// The lane kernels must be inlined into each ISA-specific caller to take on its registers.
+#if defined(__GNUC__) || defined(__clang__)
+#define COMPLEX_BATCH_INLINE inline __attribute__((always_inline))
+#else
+#define COMPLEX_BATCH_INLINE inline
+#endif
+
+namespace {
+    constexpr int LANES = BasicComplexBatch<double>::LANES;
+
+    /// @brief Groups of LANES matrices one thread task takes at least; keeps tasks well above
+    /// the cost of handing them out even for 4 x 4 matrices.
+    constexpr int MIN_GROUPS_PER_TASK = 16;
+
+    /// @brief Portable lane vector, used where the compiler has no vector type for T.
+    template <typename T>
+    struct LaneArray {
+        T v[LANES];
+
+        friend LaneArray operator +(const LaneArray& x, const LaneArray& y) { LaneArray r; for (int l = 0; l < LANES; l++) r.v[l] = x.v[l] + y.v[l]; return r; }
+        friend LaneArray operator -(const LaneArray& x, const LaneArray& y) { LaneArray r; for (int l = 0; l < LANES; l++) r.v[l] = x.v[l] - y.v[l]; return r; }
+        friend LaneArray operator *(const LaneArray& x, const LaneArray& y) { LaneArray r; for (int l = 0; l < LANES; l++) r.v[l] = x.v[l] * y.v[l]; return r; }
+        friend LaneArray operator /(const LaneArray& x, const LaneArray& y) { LaneArray r; for (int l = 0; l < LANES; l++) r.v[l] = x.v[l] / y.v[l]; return r; }
+    };
+
+    /// @brief LANES values of T as one vector. GCC and Clang vector extensions lower to the
+    /// widest registers of the function they end up in, so one kernel body serves every ISA.
+    template <typename T>
+    struct Lanes {
+        using Vector = LaneArray<T>;
+    };
+
+#if defined(__GNUC__) || defined(__clang__)
+    template <>
+    struct Lanes<double> {
+        typedef double Vector __attribute__((vector_size(LANES * sizeof(double))));
+    };
+
+    template <>
+    struct Lanes<float> {
+        typedef float Vector __attribute__((vector_size(LANES * sizeof(float))));
+    };
+#endif
+
+    // Vectors are passed by reference only: by value, a 64-byte vector changes the calling
+    // convention between ISAs.
+    template <typename V, typename T>
+    inline void load(V& vector, const T* lanes)
+    {
+        std::memcpy(&vector, lanes, sizeof(V));
+    }
+
+    template <typename V, typename T>
+    inline void store(T* lanes, const V& vector)
+    {
+        std::memcpy(lanes, &vector, sizeof(V));
+    }
+
+    /// @brief Real part of element index in lane order; the imaginary part follows LANES later.
+    template <typename T>
+    inline T* laneElement(T* lanes, std::size_t index)
+    {
+        return lanes + index * 2 * LANES;
+    }
+
+    /// @brief c = a * b for one group in lane order: a is m x n, b n x q, c m x q.
+    /// Four columns of c are accumulated at once so each loaded element of a feeds eight FMAs.
+    template <typename T>
+    COMPLEX_BATCH_INLINE void gemmLanes(int m, int n, int q, const T* a, const T* b, T* c)
+    {
+        using V = typename Lanes<T>::Vector;
+        constexpr int COLUMNS = 4;
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = 0; j < q; j += COLUMNS)
+            {
+                const int width = std::min(COLUMNS, q - j);
+                V accRe[COLUMNS] = {};
+                V accIm[COLUMNS] = {};
+                for (int p = 0; p < n; p++)
+                {
+                    V ar, ai;
+                    const T* x = laneElement(a, static_cast<std::size_t>(i) * n + p);
+                    load(ar, x);
+                    load(ai, x + LANES);
+                    const T* row = laneElement(b, static_cast<std::size_t>(p) * q + j);
+                    if (width == COLUMNS)
+                    {
+                        for (int w = 0; w < COLUMNS; w++)
+                        {
+                            V br, bi;
+                            load(br, row + w * 2 * LANES);
+                            load(bi, row + w * 2 * LANES + LANES);
+                            accRe[w] = accRe[w] + ar * br - ai * bi;
+                            accIm[w] = accIm[w] + ar * bi + ai * br;
+                        }
+                    }
+                    else
+                    {
+                        for (int w = 0; w < width; w++)
+                        {
+                            V br, bi;
+                            load(br, row + w * 2 * LANES);
+                            load(bi, row + w * 2 * LANES + LANES);
+                            accRe[w] = accRe[w] + ar * br - ai * bi;
+                            accIm[w] = accIm[w] + ar * bi + ai * br;
+                        }
+                    }
+                }
+                T* z = laneElement(c, static_cast<std::size_t>(i) * q + j);
+                for (int w = 0; w < width; w++)
+                {
+                    store(z + w * 2 * LANES, accRe[w]);
+                    store(z + w * 2 * LANES + LANES, accIm[w]);
+                }
+            }
+        }
+    }
+
+    /// @brief In-place Gauss-Jordan inverse of one group of n x n matrices in lane order.
+    /// Each lane pivots on its own column maximum, so rows are swapped lane by lane, and the
+    /// column swaps that undo the pivoting at the end likewise. A lane without a non-zero pivot
+    /// is flagged in singular and continues on a unit pivot so the other lanes are unaffected.
+    template <typename T>
+    COMPLEX_BATCH_INLINE void invertLanes(int n, T* a, int* pivots, bool* singular)
+    {
+        using V = typename Lanes<T>::Vector;
+        auto at = [a, n](int i, int j) { return laneElement(a, static_cast<std::size_t>(i) * n + j); };
+
+        for (int k = 0; k < n; k++)
+        {
+            for (int l = 0; l < LANES; l++)
+            {
+                int best = k;
+                T bestMagnitude = std::abs(at(k, k)[l]) + std::abs(at(k, k)[l + LANES]);
+                for (int i = k + 1; i < n; i++)
+                {
+                    T magnitude = std::abs(at(i, k)[l]) + std::abs(at(i, k)[l + LANES]);
+                    if (magnitude > bestMagnitude)
+                    {
+                        bestMagnitude = magnitude;
+                        best = i;
+                    }
+                }
+
+                pivots[k * LANES + l] = best;
+                if (bestMagnitude == T())
+                {
+                    singular[l] = true;
+                    at(k, k)[l] = T(1);
+                    continue;
+                }
+                if (best != k)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        std::swap(at(k, j)[l], at(best, j)[l]);
+                        std::swap(at(k, j)[l + LANES], at(best, j)[l + LANES]);
+                    }
+                }
+            }
+
+            // Row k becomes row k / pivot, with the pivot's own slot holding 1 / pivot.
+            V pr, pi;
+            load(pr, at(k, k));
+            load(pi, at(k, k) + LANES);
+            V zero{};
+            V norm = pr * pr + pi * pi;
+            V ir = pr / norm;
+            V ii = (zero - pi) / norm;
+            for (int l = 0; l < LANES; l++)
+            {
+                at(k, k)[l] = T(1);
+                at(k, k)[l + LANES] = T();
+            }
+            for (int j = 0; j < n; j++)
+            {
+                V xr, xi;
+                load(xr, at(k, j));
+                load(xi, at(k, j) + LANES);
+                store(at(k, j), xr * ir - xi * ii);
+                store(at(k, j) + LANES, xr * ii + xi * ir);
+            }
+
+            for (int i = 0; i < n; i++)
+            {
+                if (i == k)
+                    continue;
+                V fr, fi;
+                load(fr, at(i, k));
+                load(fi, at(i, k) + LANES);
+                store(at(i, k), zero);
+                store(at(i, k) + LANES, zero);
+                for (int j = 0; j < n; j++)
+                {
+                    V xr, xi, yr, yi;
+                    load(xr, at(k, j));
+                    load(xi, at(k, j) + LANES);
+                    load(yr, at(i, j));
+                    load(yi, at(i, j) + LANES);
+                    store(at(i, j), yr - (fr * xr - fi * xi));
+                    store(at(i, j) + LANES, yi - (fr * xi + fi * xr));
+                }
+            }
+        }
+
+        for (int k = n - 1; k >= 0; k--)
+        {
+            for (int l = 0; l < LANES; l++)
+            {
+                int p = pivots[k * LANES + l];
+                if (p == k)
+                    continue;
+                for (int i = 0; i < n; i++)
+                {
+                    std::swap(at(i, k)[l], at(i, p)[l]);
+                    std::swap(at(i, k)[l + LANES], at(i, p)[l + LANES]);
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    struct BatchKernels {
+        void (*gemm)(int m, int n, int q, const T* a, const T* b, T* c);
+        void (*invert)(int n, T* a, int* pivots, bool* singular);
+    };
+
+    template <typename T>
+    void gemmLanesGeneric(int m, int n, int q, const T* a, const T* b, T* c) { gemmLanes(m, n, q, a, b, c); }
+
+    template <typename T>
+    void invertLanesGeneric(int n, T* a, int* pivots, bool* singular) { invertLanes(n, a, pivots, singular); }
+
+#ifdef COMPLEX_BATCH_X86
+    template <typename T>
+    __attribute__((target("avx2,fma")))
+    void gemmLanesAvx2(int m, int n, int q, const T* a, const T* b, T* c) { gemmLanes(m, n, q, a, b, c); }
+
+    template <typename T>
+    __attribute__((target("avx2,fma")))
+    void invertLanesAvx2(int n, T* a, int* pivots, bool* singular) { invertLanes(n, a, pivots, singular); }
+
+    template <typename T>
+    __attribute__((target("avx512f")))
+    void gemmLanesAvx512(int m, int n, int q, const T* a, const T* b, T* c) { gemmLanes(m, n, q, a, b, c); }
+
+    template <typename T>
+    __attribute__((target("avx512f")))
+    void invertLanesAvx512(int n, T* a, int* pivots, bool* singular) { invertLanes(n, a, pivots, singular); }
+#endif
+
+    /// @brief Lane kernels for the widest instruction set of this machine. The generic build
+    /// already uses SSE2 on x86-64; long double has no vector registers and always runs generic.
+    template <typename T>
+    const BatchKernels<T>& batchKernels()
+    {
+        static const BatchKernels<T> kernels = [] {
+            BatchKernels<T> chosen = { &gemmLanesGeneric<T>, &invertLanesGeneric<T> };
+#ifdef COMPLEX_BATCH_X86
+            if (!std::is_same<T, long double>::value)
+            {
+                SimdIsa isa = detectSimdIsa();
+                if (isa == SimdIsa::Avx512)
+                    chosen = { &gemmLanesAvx512<T>, &invertLanesAvx512<T> };
+                else if (isa == SimdIsa::Avx2)
+                    chosen = { &gemmLanesAvx2<T>, &invertLanesAvx2<T> };
+            }
+#endif
+            return chosen;
+        }();
+        return kernels;
+    }
+
+    /// @brief Copies rows x columns matrices into lane order. Lanes without a matrix are padded
+    /// with zeros, or with the identity when padding is 1, so they stay harmless to invert.
+    template <typename T>
+    void gather(const BasicComplexNum<T>* const* sources, std::size_t elements, T* lanes, T padding, int columns)
+    {
+        bool full = true;
+        for (int l = 0; l < LANES; l++)
+            full = full && sources[l] != nullptr;
+
+        if (full)
+        {
+            for (std::size_t e = 0; e < elements; e++)
+            {
+                T* target = laneElement(lanes, e);
+                for (int l = 0; l < LANES; l++)
+                {
+                    target[l] = sources[l][e].getReal();
+                    target[l + LANES] = sources[l][e].getImag();
+                }
+            }
+            return;
+        }
+
+        for (std::size_t e = 0; e < elements; e++)
+        {
+            T* target = laneElement(lanes, e);
+            for (int l = 0; l < LANES; l++)
+            {
+                if (sources[l])
+                {
+                    target[l] = sources[l][e].getReal();
+                    target[l + LANES] = sources[l][e].getImag();
+                }
+                else
+                {
+                    target[l] = e / columns == e % columns ? padding : T();
+                    target[l + LANES] = T();
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void scatter(const T* lanes, std::size_t elements, BasicComplexNum<T>* const* targets)
+    {
+        for (std::size_t e = 0; e < elements; e++)
+        {
+            const T* source = laneElement(lanes, e);
+            for (int l = 0; l < LANES; l++)
+            {
+                if (targets[l])
+                    targets[l][e] = BasicComplexNum<T>(source[l], source[l + LANES]);
+            }
+        }
+    }
+
+    /// @brief Runs group(first, last) over [0, count) in chunks of whole lane groups on the pool.
+    template <typename Group>
+    void forEachGroup(int count, Group group)
+    {
+        int groups = (count + LANES - 1) / LANES;
+        unsigned int threads = TuningProfile::active().threadCount();
+        int groupsPerTask = std::max(MIN_GROUPS_PER_TASK, groups / static_cast<int>(4 * threads));
+        int tasks = (groups + groupsPerTask - 1) / groupsPerTask;
+        ThreadPool::shared().parallelFor(tasks, [&](int task) {
+            int first = task * groupsPerTask * LANES;
+            group(first, std::min(count, first + groupsPerTask * LANES));
+        }, threads);
+    }
+
+    /// @brief Fixed-shape products; aAt(k), bAt(k) and cAt(k) locate the matrices of product k.
+    template <typename T, typename AAt, typename BAt, typename CAt>
+    void multiplyShape(int count, int m, int n, int q, AAt aAt, BAt bAt, CAt cAt)
+    {
+        const BatchKernels<T>& kernels = batchKernels<T>();
+        const std::size_t sizeA = static_cast<std::size_t>(m) * n;
+        const std::size_t sizeB = static_cast<std::size_t>(n) * q;
+        const std::size_t sizeC = static_cast<std::size_t>(m) * q;
+
+        forEachGroup(count, [&](int first, int last) {
+            thread_local std::vector<T> scratch;
+            scratch.resize(std::max(scratch.size(), 2 * LANES * (sizeA + sizeB + sizeC)));
+            T* lanesA = scratch.data();
+            T* lanesB = lanesA + 2 * LANES * sizeA;
+            T* lanesC = lanesB + 2 * LANES * sizeB;
+
+            for (int group = first; group < last; group += LANES)
+            {
+                const BasicComplexNum<T>* sourcesA[LANES];
+                const BasicComplexNum<T>* sourcesB[LANES];
+                BasicComplexNum<T>* targets[LANES];
+                for (int l = 0; l < LANES; l++)
+                {
+                    bool present = group + l < last;
+                    sourcesA[l] = present ? aAt(group + l) : nullptr;
+                    sourcesB[l] = present ? bAt(group + l) : nullptr;
+                    targets[l] = present ? cAt(group + l) : nullptr;
+                }
+                gather(sourcesA, sizeA, lanesA, T(), n);
+                gather(sourcesB, sizeB, lanesB, T(), q);
+                kernels.gemm(m, n, q, lanesA, lanesB, lanesC);
+                scatter(lanesC, sizeC, targets);
+            }
+        });
+    }
+
+    /// @brief Fixed-size inverses; returns how many were invertible.
+    template <typename T, typename AAt, typename InverseAt>
+    int invertShape(int count, int n, AAt aAt, InverseAt inverseAt, bool* invertible)
+    {
+        const BatchKernels<T>& kernels = batchKernels<T>();
+        const std::size_t size = static_cast<std::size_t>(n) * n;
+        std::atomic<int> singularCount(0);
+
+        forEachGroup(count, [&](int first, int last) {
+            thread_local std::vector<T> scratch;
+            thread_local std::vector<int> pivots;
+            scratch.resize(std::max(scratch.size(), 2 * LANES * size));
+            pivots.resize(std::max(pivots.size(), static_cast<std::size_t>(n) * LANES));
+
+            for (int group = first; group < last; group += LANES)
+            {
+                const BasicComplexNum<T>* sources[LANES];
+                BasicComplexNum<T>* targets[LANES];
+                bool singular[LANES] = {};
+                for (int l = 0; l < LANES; l++)
+                {
+                    bool present = group + l < last;
+                    sources[l] = present ? aAt(group + l) : nullptr;
+                    targets[l] = present ? inverseAt(group + l) : nullptr;
+                }
+                gather(sources, size, scratch.data(), T(1), n);
+                kernels.invert(n, scratch.data(), pivots.data(), singular);
+                scatter(scratch.data(), size, targets);
+
+                for (int l = 0; l < LANES && group + l < last; l++)
+                {
+                    if (singular[l])
+                    {
+                        std::fill_n(targets[l], size, BasicComplexNum<T>());
+                        singularCount++;
+                    }
+                    if (invertible)
+                        invertible[group + l] = !singular[l];
+                }
+            }
+        });
+        return count - singularCount.load();
+    }
+
+    /// @brief Indices of entries ordered so that equal shapes are adjacent.
+    template <typename Entry, typename Key>
+    std::vector<int> orderByShape(const std::vector<Entry>& entries, Key key)
+    {
+        std::vector<int> order(entries.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int x, int y) { return key(entries[x]) < key(entries[y]); });
+        return order;
+    }
+}
+
+template <typename T>
+void BasicComplexBatch<T>::multiply(int count, int rows, int depth, int columns,
+    const BasicComplexNum<T>* a, std::size_t strideA,
+    const BasicComplexNum<T>* b, std::size_t strideB,
+    BasicComplexNum<T>* c, std::size_t strideC)
+{
+    if (count <= 0 || rows <= 0 || columns <= 0)
+        return;
+    multiplyShape<T>(count, rows, depth, columns,
+        [=](int k) { return a + k * strideA; },
+        [=](int k) { return b + k * strideB; },
+        [=](int k) { return c + k * strideC; });
+}
+
+template <typename T>
+void BasicComplexBatch<T>::multiply(const std::vector<BatchProduct>& products, const BasicComplexNum<T>* a, const BasicComplexNum<T>* b, BasicComplexNum<T>* c)
+{
+    std::vector<int> order = orderByShape(products, [](const BatchProduct& p) {
+        return std::make_tuple(p.rows, p.depth, p.columns);
+    });
+
+    for (std::size_t first = 0; first < order.size();)
+    {
+        const BatchProduct& shape = products[order[first]];
+        std::size_t last = first + 1;
+        while (last < order.size() && products[order[last]].rows == shape.rows
+            && products[order[last]].depth == shape.depth && products[order[last]].columns == shape.columns)
+            last++;
+
+        const int* run = order.data() + first;
+        if (shape.rows > 0 && shape.columns > 0)
+        {
+            multiplyShape<T>(static_cast<int>(last - first), shape.rows, shape.depth, shape.columns,
+                [&](int k) { return a + products[run[k]].a; },
+                [&](int k) { return b + products[run[k]].b; },
+                [&](int k) { return c + products[run[k]].c; });
+        }
+        first = last;
+    }
+}
+
+template <typename T>
+int BasicComplexBatch<T>::invert(int count, int size, const BasicComplexNum<T>* a, std::size_t strideA,
+    BasicComplexNum<T>* inverse, std::size_t strideInverse, bool* invertible)
+{
+    if (count <= 0)
+        return 0;
+    return invertShape<T>(count, size,
+        [=](int k) { return a + k * strideA; },
+        [=](int k) { return inverse + k * strideInverse; },
+        invertible);
+}
+
+template <typename T>
+int BasicComplexBatch<T>::invert(const std::vector<BatchInverse>& inverses, const BasicComplexNum<T>* a, BasicComplexNum<T>* inverse, bool* invertible)
+{
+    std::vector<int> order = orderByShape(inverses, [](const BatchInverse& entry) { return entry.size; });
+    int total = 0;
+
+    for (std::size_t first = 0; first < order.size();)
+    {
+        int size = inverses[order[first]].size;
+        std::size_t last = first + 1;
+        while (last < order.size() && inverses[order[last]].size == size)
+            last++;
+
+        const int* run = order.data() + first;
+        std::unique_ptr<bool[]> flags(new bool[last - first]);
+        total += invertShape<T>(static_cast<int>(last - first), size,
+            [&](int k) { return a + inverses[run[k]].a; },
+            [&](int k) { return inverse + inverses[run[k]].inverse; },
+            flags.get());
+        if (invertible)
+        {
+            for (std::size_t k = 0; k < last - first; k++)
+                invertible[run[k]] = flags[k];
+        }
+        first = last;
+    }
+    return total;
+}
+
+template class BasicComplexBatch<float>;
+template class BasicComplexBatch<double>;
+template class BasicComplexBatch<long double>;
@@ -0,0 +1,60 @@
+#pragma once
+#include "ComplexNum.h"
+#include <cstddef>
+#include <vector>
+
+/// @brief One product of a variable-size batch: c = a * b with a rows x depth and b depth x columns.
+/// a, b and c are element offsets into the batch arrays; each matrix is dense and row-major.
+struct BatchProduct {
+    int rows;
+    int depth;
+    int columns;
+    std::size_t a;
+    std::size_t b;
+    std::size_t c;
+};
+
+/// @brief One inversion of a variable-size batch: the size x size matrix at element offset a is
+/// inverted into element offset inverse. Both are dense and row-major.
+struct BatchInverse {
+    int size;
+    std::size_t a;
+    std::size_t inverse;
+};
+
+/// @brief Products and inverses of many small independent complex matrices (roughly 4 x 4 to
+/// 32 x 32), without a ComplexMatrix or a call per matrix. Matrices are taken LANES at a time and
+/// transposed into lane order, where element (i, j) of all of them is one SIMD vector per real and
+/// imaginary part; the arithmetic then runs one matrix per lane, so its width does not depend on
+/// how small each matrix is. The lane kernels are compiled for SSE2, AVX2 and AVX-512 and picked
+/// at run time like ComplexKernels. Groups of LANES matrices are split across the shared ThreadPool.
+/// The fixed-stride forms take count matrices of one shape spaced stride elements apart; the
+/// variable-size forms take a list of shapes and offsets and batch equal shapes together.
+template <typename T>
+class BasicComplexBatch
+{
+public:
+    /// @brief Matrices processed together, one per SIMD lane.
+    static constexpr int LANES = 8;
+
+    /// @brief c[k] = a[k] * b[k] for k < count, where matrix k of a starts at a + k * strideA
+    /// (rows x depth), of b at b + k * strideB (depth x columns) and of c at c + k * strideC.
+    static void multiply(int count, int rows, int depth, int columns,
+        const BasicComplexNum<T>* a, std::size_t strideA,
+        const BasicComplexNum<T>* b, std::size_t strideB,
+        BasicComplexNum<T>* c, std::size_t strideC);
+
+    static void multiply(const std::vector<BatchProduct>& products, const BasicComplexNum<T>* a, const BasicComplexNum<T>* b, BasicComplexNum<T>* c);
+
+    /// @brief inverse[k] = a[k]^-1 for count size x size matrices, by Gauss-Jordan elimination with
+    /// partial pivoting chosen per matrix. A matrix that meets an exactly zero pivot column gets an
+    /// all-zero result and, when invertible is given, invertible[k] = false. Returns how many
+    /// matrices were invertible.
+    static int invert(int count, int size, const BasicComplexNum<T>* a, std::size_t strideA,
+        BasicComplexNum<T>* inverse, std::size_t strideInverse, bool* invertible = nullptr);
+
+    static int invert(const std::vector<BatchInverse>& inverses, const BasicComplexNum<T>* a, BasicComplexNum<T>* inverse, bool* invertible = nullptr);
+};
+
+using ComplexBatch = BasicComplexBatch<double>;
+using ComplexBatchF = BasicComplexBatch<float>;
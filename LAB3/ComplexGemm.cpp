@@ -0,0 +1,367 @@
+#include "ComplexGemm.h"
+#include <algorithm>
+
+namespace {
+    /// @brief Per-thread packing buffers, grown on demand and reused across calls.
+    template <typename T>
+    struct PackBuffers {
+        std::vector<T> a;
+        std::vector<T> b;
+    };
+
+    template <typename T>
+    PackBuffers<T>& packBuffers()
+    {
+        thread_local PackBuffers<T> buffers;
+        return buffers;
+    }
+}
+
+template <typename T>
+void BasicComplexGemm<T>::multiply(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> c, bool accumulate, MultiplyMode mode)
+{
+    assert(a.getColumns() == b.getRows());
+    assert(a.getRows() == c.getRows() && b.getColumns() == c.getColumns());
+
+    if (!accumulate)
+    {
+        for (int i = 0; i < c.getValidRows(); i++)
+        {
+            if (c.getLayout() == StorageLayout::Split)
+            {
+                std::fill_n(c.realRow(i), c.getValidColumns(), T());
+                std::fill_n(c.imagRow(i), c.getValidColumns(), T());
+            }
+            else
+                std::fill_n(c.row(i), c.getValidColumns(), BasicComplexNum<T>());
+        }
+    }
+
+    const int m = std::min(a.getValidRows(), c.getValidRows());
+    const int n = std::min(b.getValidColumns(), c.getValidColumns());
+    const int k = std::min(a.getValidColumns(), b.getValidRows());
+    if (m == 0 || n == 0 || k == 0)
+        return;
+
+    if (mode == MultiplyMode::ThreeM)
+    {
+        multiplyThreeM(a, b, c, m, n, k);
+        return;
+    }
+
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    PackBuffers<T>& buffers = packBuffers<T>();
+    const TuningProfile& tuning = TuningProfile::active();
+    const int mcBlock = tuning.gemmRowBlock;
+    const int kcBlock = tuning.gemmDepthBlock;
+    const int ncBlock = tuning.gemmColumnBlock;
+    const int kcMax = std::min(kcBlock, k);
+    const int mcMax = (std::min(mcBlock, m) + MR - 1) / MR * MR;
+    const int ncMax = (std::min(ncBlock, n) + NR - 1) / NR * NR;
+    buffers.a.resize(std::max(buffers.a.size(), static_cast<std::size_t>(2) * mcMax * kcMax));
+    buffers.b.resize(std::max(buffers.b.size(), static_cast<std::size_t>(2) * ncMax * kcMax));
+    T* packedA = buffers.a.data();
+    T* packedB = buffers.b.data();
+
+    for (int jc = 0; jc < n; jc += ncBlock)
+    {
+        const int nc = std::min(ncBlock, n - jc);
+        for (int pc = 0; pc < k; pc += kcBlock)
+        {
+            const int kc = std::min(kcBlock, k - pc);
+            packB(b, pc, jc, kc, nc, packedB);
+
+            for (int ic = 0; ic < m; ic += mcBlock)
+            {
+                const int mc = std::min(mcBlock, m - ic);
+                packA(a, ic, pc, mc, kc, packedA);
+
+                for (int jr = 0; jr < nc; jr += NR)
+                {
+                    const T* slivB = packedB + static_cast<std::size_t>(jr) * 2 * kc;
+                    for (int ir = 0; ir < mc; ir += MR)
+                    {
+                        const T* slivA = packedA + static_cast<std::size_t>(ir) * 2 * kc;
+                        microKernel(kernels, kc, slivA, slivB, c, ic + ir, jc + jr, std::min(MR, mc - ir), std::min(NR, nc - jr));
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void BasicComplexGemm<T>::multiplyThreeM(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T>& c, int m, int n, int k)
+{
+    constexpr int RR = BasicComplexKernels<T>::REAL_TILE_ROWS;
+    constexpr int RC = BasicComplexKernels<T>::REAL_TILE_COLUMNS;
+
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    PackBuffers<T>& buffers = packBuffers<T>();
+    const TuningProfile& tuning = TuningProfile::active();
+    const int mcBlock = tuning.gemmRowBlock;
+    const int kcBlock = std::max(1, tuning.gemmDepthBlock / 2);
+    const int ncBlock = tuning.gemmColumnBlock;
+    const int kcMax = std::min(kcBlock, k);
+    const int mcMax = (std::min(mcBlock, m) + RR - 1) / RR * RR;
+    const int ncMax = (std::min(ncBlock, n) + RC - 1) / RC * RC;
+    buffers.a.resize(std::max(buffers.a.size(), static_cast<std::size_t>(3) * mcMax * kcMax));
+    buffers.b.resize(std::max(buffers.b.size(), static_cast<std::size_t>(3) * ncMax * kcMax));
+    T* packedA = buffers.a.data();
+    T* packedB = buffers.b.data();
+
+    for (int jc = 0; jc < n; jc += ncBlock)
+    {
+        const int nc = std::min(ncBlock, n - jc);
+        for (int pc = 0; pc < k; pc += kcBlock)
+        {
+            const int kc = std::min(kcBlock, k - pc);
+            const std::size_t planeB = static_cast<std::size_t>((nc + RC - 1) / RC * RC) * kc;
+            packThreeB(b, pc, jc, kc, nc, packedB);
+
+            for (int ic = 0; ic < m; ic += mcBlock)
+            {
+                const int mc = std::min(mcBlock, m - ic);
+                const std::size_t planeA = static_cast<std::size_t>((mc + RR - 1) / RR * RR) * kc;
+                packThreeA(a, ic, pc, mc, kc, packedA);
+
+                for (int jr = 0; jr < nc; jr += RC)
+                {
+                    const T* slivB = packedB + static_cast<std::size_t>(jr) * kc;
+                    const int columns = std::min(RC, nc - jr);
+                    for (int ir = 0; ir < mc; ir += RR)
+                    {
+                        const T* slivA = packedA + static_cast<std::size_t>(ir) * kc;
+                        T p1[RR * RC];
+                        T p2[RR * RC];
+                        T p3[RR * RC];
+                        kernels.realGemmTile(kc, slivA, slivB, p1);
+                        kernels.realGemmTile(kc, slivA + planeA, slivB + planeB, p2);
+                        kernels.realGemmTile(kc, slivA + 2 * planeA, slivB + 2 * planeB, p3);
+
+                        for (int i = 0; i < std::min(RR, mc - ir); i++)
+                        {
+                            const int row = ic + ir + i;
+                            const int t = i * RC;
+                            if (c.getLayout() == StorageLayout::Split)
+                            {
+                                T* re = c.realRow(row) + jc + jr;
+                                T* im = c.imagRow(row) + jc + jr;
+                                for (int j = 0; j < columns; j++)
+                                {
+                                    re[j] += p1[t + j] - p2[t + j];
+                                    im[j] += p3[t + j] - p1[t + j] - p2[t + j];
+                                }
+                            }
+                            else
+                            {
+                                BasicComplexNum<T>* out = c.row(row) + jc + jr;
+                                for (int j = 0; j < columns; j++)
+                                    out[j] += BasicComplexNum<T>(p1[t + j] - p2[t + j], p3[t + j] - p1[t + j] - p2[t + j]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void BasicComplexGemm<T>::packThreeA(const BasicComplexMatrixView<T>& a, int row, int col, int mc, int kc, T* buffer)
+{
+    constexpr int RR = BasicComplexKernels<T>::REAL_TILE_ROWS;
+    const std::size_t plane = static_cast<std::size_t>((mc + RR - 1) / RR * RR) * kc;
+    const bool split = a.getLayout() == StorageLayout::Split;
+
+    for (int ir = 0; ir < mc; ir += RR)
+    {
+        T* real = buffer + static_cast<std::size_t>(ir) * kc;
+        T* imag = real + plane;
+        T* sum = imag + plane;
+        for (int i = 0; i < RR; i++)
+        {
+            if (ir + i >= mc)
+            {
+                for (int p = 0; p < kc; p++)
+                    real[p * RR + i] = imag[p * RR + i] = sum[p * RR + i] = T();
+                continue;
+            }
+
+            for (int p = 0; p < kc; p++)
+            {
+                T re, im;
+                if (split)
+                {
+                    re = a.realRow(row + ir + i)[col + p];
+                    im = a.imagRow(row + ir + i)[col + p];
+                }
+                else
+                {
+                    const BasicComplexNum<T>& value = a.row(row + ir + i)[col + p];
+                    re = value.getReal();
+                    im = value.getImag();
+                }
+                real[p * RR + i] = re;
+                imag[p * RR + i] = im;
+                sum[p * RR + i] = re + im;
+            }
+        }
+    }
+}
+
+template <typename T>
+void BasicComplexGemm<T>::packThreeB(const BasicComplexMatrixView<T>& b, int row, int col, int kc, int nc, T* buffer)
+{
+    constexpr int RC = BasicComplexKernels<T>::REAL_TILE_COLUMNS;
+    const std::size_t plane = static_cast<std::size_t>((nc + RC - 1) / RC * RC) * kc;
+    const bool split = b.getLayout() == StorageLayout::Split;
+
+    for (int jr = 0; jr < nc; jr += RC)
+    {
+        const int columns = std::min(RC, nc - jr);
+        for (int p = 0; p < kc; p++)
+        {
+            T* real = buffer + static_cast<std::size_t>(jr) * kc + static_cast<std::size_t>(p) * RC;
+            T* imag = real + plane;
+            T* sum = imag + plane;
+            for (int j = 0; j < columns; j++)
+            {
+                T re, im;
+                if (split)
+                {
+                    re = b.realRow(row + p)[col + jr + j];
+                    im = b.imagRow(row + p)[col + jr + j];
+                }
+                else
+                {
+                    const BasicComplexNum<T>& value = b.row(row + p)[col + jr + j];
+                    re = value.getReal();
+                    im = value.getImag();
+                }
+                real[j] = re;
+                imag[j] = im;
+                sum[j] = re + im;
+            }
+            for (int j = columns; j < RC; j++)
+                real[j] = imag[j] = sum[j] = T();
+        }
+    }
+}
+
+template <typename T>
+void BasicComplexGemm<T>::packA(const BasicComplexMatrixView<T>& a, int row, int col, int mc, int kc, T* buffer)
+{
+    const bool split = a.getLayout() == StorageLayout::Split;
+    for (int ir = 0; ir < mc; ir += MR)
+    {
+        T* sliver = buffer + static_cast<std::size_t>(ir) * 2 * kc;
+        const int rows = std::min(MR, mc - ir);
+        for (int i = 0; i < MR; i++)
+        {
+            if (i >= rows)
+            {
+                for (int p = 0; p < kc; p++)
+                {
+                    sliver[p * 2 * MR + i] = T();
+                    sliver[p * 2 * MR + MR + i] = T();
+                }
+                continue;
+            }
+
+            if (split)
+            {
+                const T* re = a.realRow(row + ir + i) + col;
+                const T* im = a.imagRow(row + ir + i) + col;
+                for (int p = 0; p < kc; p++)
+                {
+                    sliver[p * 2 * MR + i] = re[p];
+                    sliver[p * 2 * MR + MR + i] = im[p];
+                }
+            }
+            else
+            {
+                const BasicComplexNum<T>* source = a.row(row + ir + i) + col;
+                for (int p = 0; p < kc; p++)
+                {
+                    sliver[p * 2 * MR + i] = source[p].getReal();
+                    sliver[p * 2 * MR + MR + i] = source[p].getImag();
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void BasicComplexGemm<T>::packB(const BasicComplexMatrixView<T>& b, int row, int col, int kc, int nc, T* buffer)
+{
+    const bool split = b.getLayout() == StorageLayout::Split;
+    for (int jr = 0; jr < nc; jr += NR)
+    {
+        T* sliver = buffer + static_cast<std::size_t>(jr) * 2 * kc;
+        const int columns = std::min(NR, nc - jr);
+        for (int p = 0; p < kc; p++)
+        {
+            T* re = sliver + p * 2 * NR;
+            T* im = re + NR;
+            if (split)
+            {
+                const T* sourceRe = b.realRow(row + p) + col + jr;
+                const T* sourceIm = b.imagRow(row + p) + col + jr;
+                for (int j = 0; j < columns; j++)
+                {
+                    re[j] = sourceRe[j];
+                    im[j] = sourceIm[j];
+                }
+            }
+            else
+            {
+                const BasicComplexNum<T>* source = b.row(row + p) + col + jr;
+                for (int j = 0; j < columns; j++)
+                {
+                    re[j] = source[j].getReal();
+                    im[j] = source[j].getImag();
+                }
+            }
+            for (int j = columns; j < NR; j++)
+            {
+                re[j] = T();
+                im[j] = T();
+            }
+        }
+    }
+}
+
+template <typename T>
+void BasicComplexGemm<T>::microKernel(const BasicComplexKernels<T>& kernels, int kc, const T* a, const T* b, BasicComplexMatrixView<T>& c, int row, int col, int mr, int nr)
+{
+    T tileRe[MR * NR];
+    T tileIm[MR * NR];
+    kernels.gemmTile(kc, a, b, tileRe, tileIm);
+
+    for (int i = 0; i < mr; i++)
+    {
+        const T* accRe = tileRe + i * NR;
+        const T* accIm = tileIm + i * NR;
+        if (c.getLayout() == StorageLayout::Split)
+        {
+            T* re = c.realRow(row + i) + col;
+            T* im = c.imagRow(row + i) + col;
+            for (int j = 0; j < nr; j++)
+            {
+                re[j] += accRe[j];
+                im[j] += accIm[j];
+            }
+        }
+        else
+        {
+            BasicComplexNum<T>* out = c.row(row + i) + col;
+            for (int j = 0; j < nr; j++)
+                out[j] += BasicComplexNum<T>(accRe[j], accIm[j]);
+        }
+    }
+}
+
+template class BasicComplexGemm<float>;
+template class BasicComplexGemm<double>;
+template class BasicComplexGemm<long double>;
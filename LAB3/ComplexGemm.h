@@ -0,0 +1,56 @@
+#pragma once
+#include "ComplexMatrixView.h"
+#include "ComplexKernels.h"
+#include "MultiplyMode.h"
+#include "TuningProfile.h"
+#include <vector>
+
+/// @brief Cache-blocked complex GEMM in the GotoBLAS style; the one multiply primitive behind
+/// ComplexMatrix::operator*, ComplexMatrixView::multiply, the Strassen leaf and ParallelStrassen.
+/// B is packed KC x NC at a time into NR-column slivers (sized for L3), A MC x KC at a time into
+/// MR-row slivers (sized for L2), and an MR x NR register-blocked microkernel walks both packed
+/// buffers contiguously. Packed slivers are split: per k, MR (or NR) real parts then as many
+/// imaginary parts, whatever the layout of the operands, so the microkernel is plain real FMAs;
+/// it is the gemmTile entry of the ComplexKernels table picked for this CPU.
+template <typename T>
+class BasicComplexGemm
+{
+public:
+    static constexpr int MR = BasicComplexKernels<T>::TILE_ROWS;
+    static constexpr int NR = BasicComplexKernels<T>::TILE_COLUMNS;
+    /// @brief Default MC, KC and NC; each call uses the blocks of the active TuningProfile.
+    /// The 3M path halves KC: its B slivers carry three planes, so this keeps a sliver of each in L1.
+    static constexpr int MC = TuningProfile::DEFAULT_GEMM_ROW_BLOCK;
+    static constexpr int KC = TuningProfile::DEFAULT_GEMM_DEPTH_BLOCK;
+    static constexpr int NC = TuningProfile::DEFAULT_GEMM_COLUMN_BLOCK;
+
+    /// @brief c = a * b, or c += a * b when accumulate is set, over the backed extent of c.
+    /// Operands may use either storage layout; elements outside their backed extents read as zero.
+    /// MultiplyMode::ThreeM runs the same blocking over real planes, see multiplyThreeM.
+    static void multiply(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> c, bool accumulate = false, MultiplyMode mode = MultiplyMode::Classic);
+
+private:
+    /// @brief c += a * b over the leading m x n x k extents with three real GEMMs. Packing splits
+    /// each block into its real plane, imaginary plane and their sum (so either layout works),
+    /// the real microkernel forms the three products per tile, and the write-back combines them.
+    static void multiplyThreeM(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T>& c, int m, int n, int k);
+
+    /// @brief Packs rows [row, row + mc) x columns [col, col + kc) of a into REAL_TILE_ROWS-row
+    /// slivers of its real part, imaginary part and their sum, one plane after the other.
+    static void packThreeA(const BasicComplexMatrixView<T>& a, int row, int col, int mc, int kc, T* buffer);
+
+    /// @brief Packs rows [row, row + kc) x columns [col, col + nc) of b into REAL_TILE_COLUMNS-column
+    /// slivers of its real part, imaginary part and their sum, one plane after the other.
+    static void packThreeB(const BasicComplexMatrixView<T>& b, int row, int col, int kc, int nc, T* buffer);
+
+    /// @brief Packs rows [row, row + mc) x columns [col, col + kc) of a into MR-row slivers, zero-padding the last.
+    static void packA(const BasicComplexMatrixView<T>& a, int row, int col, int mc, int kc, T* buffer);
+
+    /// @brief Packs rows [row, row + kc) x columns [col, col + nc) of b into NR-column slivers, zero-padding the last.
+    static void packB(const BasicComplexMatrixView<T>& b, int row, int col, int kc, int nc, T* buffer);
+
+    /// @brief c[row .. row + mr, col .. col + nr) += packed A sliver * packed B sliver.
+    static void microKernel(const BasicComplexKernels<T>& kernels, int kc, const T* a, const T* b, BasicComplexMatrixView<T>& c, int row, int col, int mr, int nr);
+};
+
+using ComplexGemm = BasicComplexGemm<double>;
@@ -0,0 +1,198 @@
+#include "ComplexGemv.h"
+#include "ThreadPool.h"
+#include "TuningProfile.h"
+#include <cassert>
+#include <algorithm>
+#include <vector>
+
+namespace {
+    /// @brief Per-thread scratch: an interleaved copy of a split row segment, and the
+    /// accumulators of the transposed products.
+    template <typename T>
+    struct GemvBuffers {
+        std::vector<BasicComplexNum<T>> row;
+        std::vector<BasicComplexNum<T>> sum;
+        std::vector<T> sumReal;
+        std::vector<T> sumImag;
+    };
+
+    template <typename T>
+    GemvBuffers<T>& gemvBuffers()
+    {
+        thread_local GemvBuffers<T> buffers;
+        return buffers;
+    }
+
+    /// @brief Columns [first, first + width) of row i of a, interleaved.
+    template <typename T>
+    const BasicComplexNum<T>* rowSegment(const BasicComplexMatrixView<T>& a, int i, int first, int width, GemvBuffers<T>& buffers)
+    {
+        if (a.getLayout() == StorageLayout::Interleaved)
+            return a.row(i) + first;
+
+        const T* real = a.realRow(i) + first;
+        const T* imag = a.imagRow(i) + first;
+        buffers.row.resize(std::max<std::size_t>(buffers.row.size(), width));
+        for (int j = 0; j < width; j++)
+            buffers.row[j] = BasicComplexNum<T>(real[j], imag[j]);
+        return buffers.row.data();
+    }
+
+    template <typename T>
+    BasicComplexNum<T> conjugate(const BasicComplexNum<T>& value)
+    {
+        return BasicComplexNum<T>(value.getReal(), -value.getImag());
+    }
+
+    /// @brief Runs task(0 .. count) on the shared pool when the product is large enough.
+    template <typename Task>
+    void forEachBlock(int count, long long work, long long threshold, Task task)
+    {
+        if (work < threshold || count <= 1)
+        {
+            for (int b = 0; b < count; b++)
+                task(b);
+            return;
+        }
+        ThreadPool::shared().parallelFor(count, task, TuningProfile::active().threadCount());
+    }
+}
+
+template <typename T>
+void BasicComplexGemv<T>::multiply(GemvOperation operation, BasicComplexNum<T> alpha, const BasicComplexMatrixView<T>& a,
+    const BasicComplexNum<T>* x, BasicComplexNum<T> beta, BasicComplexNum<T>* y)
+{
+    multiplyVectors(operation, alpha, a, 1, x, 0, beta, y, 0);
+}
+
+template <typename T>
+void BasicComplexGemv<T>::multiply(GemvOperation operation, BasicComplexNum<T> alpha, const BasicComplexMatrixView<T>& a,
+    const BasicComplexMatrixView<T>& x, BasicComplexNum<T> beta, BasicComplexMatrixView<T> y)
+{
+    const bool transposed = operation != GemvOperation::NoTranspose;
+    const int inputLength = transposed ? a.getRows() : a.getColumns();
+    const int outputLength = transposed ? a.getColumns() : a.getRows();
+    assert(x.getRows() == inputLength && y.getRows() == outputLength && x.getColumns() == y.getColumns());
+
+    // Columns of x and y are strided; the core wants each vector contiguous.
+    const int count = x.getColumns();
+    std::vector<BasicComplexNum<T>> packedX(static_cast<std::size_t>(count) * inputLength);
+    std::vector<BasicComplexNum<T>> packedY(static_cast<std::size_t>(count) * outputLength);
+    for (int r = 0; r < count; r++)
+    {
+        for (int i = 0; i < inputLength; i++)
+            packedX[static_cast<std::size_t>(r) * inputLength + i] = x.get(i, r);
+        if (!beta.isNull())
+            for (int i = 0; i < outputLength; i++)
+                packedY[static_cast<std::size_t>(r) * outputLength + i] = y.get(i, r);
+    }
+
+    multiplyVectors(operation, alpha, a, count, packedX.data(), inputLength, beta, packedY.data(), outputLength);
+
+    for (int r = 0; r < count; r++)
+        for (int i = 0; i < outputLength; i++)
+            y.set(i, r, packedY[static_cast<std::size_t>(r) * outputLength + i]);
+}
+
+template <typename T>
+void BasicComplexGemv<T>::multiplyVectors(GemvOperation operation, BasicComplexNum<T> alpha, const BasicComplexMatrixView<T>& a,
+    int count, const BasicComplexNum<T>* x, std::size_t xStride, BasicComplexNum<T> beta, BasicComplexNum<T>* y, std::size_t yStride)
+{
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    const bool transposed = operation != GemvOperation::NoTranspose;
+    const int outputLength = transposed ? a.getColumns() : a.getRows();
+    const int rows = a.getValidRows();
+    const int columns = a.getValidColumns();
+    const long long work = static_cast<long long>(rows) * columns * count;
+
+    for (int r = 0; r < count; r++)
+    {
+        BasicComplexNum<T>* target = y + r * yStride;
+        if (beta.isNull())
+            std::fill_n(target, outputLength, BasicComplexNum<T>());
+        else if (!(beta == BasicComplexNum<T>(1, 0)))
+            for (int i = 0; i < outputLength; i++)
+                target[i] = beta * target[i];
+    }
+    if (rows == 0 || columns == 0 || alpha.isNull())
+        return;
+
+    if (!transposed)
+    {
+        // Each task owns ROW_BLOCK entries of every y; the x segment of a column block is reused
+        // by all rows of the block.
+        const int blocks = (rows + ROW_BLOCK - 1) / ROW_BLOCK;
+        forEachBlock(blocks, work, PARALLEL_THRESHOLD, [&](int block) {
+            GemvBuffers<T>& buffers = gemvBuffers<T>();
+            const int firstRow = block * ROW_BLOCK;
+            const int lastRow = std::min(rows, firstRow + ROW_BLOCK);
+            for (int first = 0; first < columns; first += COLUMN_BLOCK)
+            {
+                const int width = std::min(COLUMN_BLOCK, columns - first);
+                for (int i = firstRow; i < lastRow; i++)
+                {
+                    const BasicComplexNum<T>* segment = rowSegment(a, i, first, width, buffers);
+                    for (int r = 0; r < count; r++)
+                        y[r * yStride + i] += alpha * kernels.dot(width, segment, x + r * xStride + first);
+                }
+            }
+        });
+        return;
+    }
+
+    // Each task owns one column segment of every result and sweeps all rows of a over it.
+    const unsigned int threads = TuningProfile::active().threadCount();
+    int width = std::min(COLUMN_BLOCK, std::max(64, (columns + static_cast<int>(threads) - 1) / static_cast<int>(threads)));
+    const int blocks = (columns + width - 1) / width;
+    const bool conjugated = operation == GemvOperation::ConjugateTranspose;
+    forEachBlock(blocks, work, PARALLEL_THRESHOLD, [&](int block) {
+        GemvBuffers<T>& buffers = gemvBuffers<T>();
+        const int first = block * width;
+        const int segment = std::min(width, columns - first);
+        const bool split = a.getLayout() == StorageLayout::Split;
+        if (split)
+        {
+            buffers.sumReal.resize(std::max<std::size_t>(buffers.sumReal.size(), segment));
+            buffers.sumImag.resize(std::max<std::size_t>(buffers.sumImag.size(), segment));
+        }
+        else
+            buffers.sum.resize(std::max<std::size_t>(buffers.sum.size(), segment));
+
+        for (int r = 0; r < count; r++)
+        {
+            if (split)
+            {
+                std::fill_n(buffers.sumReal.data(), segment, T());
+                std::fill_n(buffers.sumImag.data(), segment, T());
+            }
+            else
+                std::fill_n(buffers.sum.data(), segment, BasicComplexNum<T>());
+
+            const BasicComplexNum<T>* vector = x + r * xStride;
+            for (int i = 0; i < rows; i++)
+            {
+                if (vector[i].isNull())
+                    continue;
+                // sum(conj(a_ij) * s) = conj(sum(a_ij * conj(s))).
+                BasicComplexNum<T> scale = alpha * vector[i];
+                if (conjugated)
+                    scale = conjugate(scale);
+                if (split)
+                    kernels.axpySplit(segment, scale, a.realRow(i) + first, a.imagRow(i) + first, buffers.sumReal.data(), buffers.sumImag.data());
+                else
+                    kernels.axpy(segment, scale, a.row(i) + first, buffers.sum.data());
+            }
+
+            BasicComplexNum<T>* target = y + r * yStride + first;
+            for (int j = 0; j < segment; j++)
+            {
+                BasicComplexNum<T> sum = split ? BasicComplexNum<T>(buffers.sumReal[j], buffers.sumImag[j]) : buffers.sum[j];
+                target[j] += conjugated ? conjugate(sum) : sum;
+            }
+        }
+    });
+}
+
+template class BasicComplexGemv<float>;
+template class BasicComplexGemv<double>;
+template class BasicComplexGemv<long double>;
@@ -0,0 +1,51 @@
+#pragma once
+#include "ComplexMatrixView.h"
+#include "ComplexKernels.h"
+
+/// @brief The matrix a GEMV multiplies by: A, its transpose or its conjugate transpose.
+enum class GemvOperation {
+    NoTranspose,
+    Transpose,
+    ConjugateTranspose
+};
+
+/// @brief Complex matrix-vector products, y = alpha * op(A) * x + beta * y, in the BLAS GEMV
+/// convention: with beta == 0, y is overwritten without being read. A may use either storage
+/// layout and elements outside its backed extent read as zero.
+/// NoTranspose forms each y[i] as a dot product of a row of A; Transpose and ConjugateTranspose
+/// add alpha * x[i] times row i of A into the result (the conjugate case accumulates with
+/// conj(alpha * x[i]) and conjugates at the end), so A is always walked along its rows. Columns
+/// are taken COLUMN_BLOCK at a time so the segment of the vector being reused stays in L1, the
+/// inner loops are the dot / axpy entries of ComplexKernels, and large products are split over
+/// the shared ThreadPool by rows (NoTranspose) or by column blocks (otherwise).
+template <typename T>
+class BasicComplexGemv
+{
+public:
+    /// @brief Columns of A covered by one pass over a block of rows.
+    static constexpr int COLUMN_BLOCK = 1024;
+
+    /// @brief Rows of A one task takes in the NoTranspose case.
+    static constexpr int ROW_BLOCK = 64;
+
+    /// @brief Products touching fewer elements of A (times vectors) stay on the calling thread.
+    static constexpr long long PARALLEL_THRESHOLD = 1 << 16;
+
+    /// @brief y = alpha * op(a) * x + beta * y. x has as many elements as op(a) has columns, y as
+    /// many as op(a) has rows; they must not overlap.
+    static void multiply(GemvOperation operation, BasicComplexNum<T> alpha, const BasicComplexMatrixView<T>& a,
+        const BasicComplexNum<T>* x, BasicComplexNum<T> beta, BasicComplexNum<T>* y);
+
+    /// @brief y = alpha * op(a) * x + beta * y for every column of x and y at once, reading a
+    /// once for all of them. Meant for a handful of right-hand sides; ComplexGemm is the better
+    /// fit for many.
+    static void multiply(GemvOperation operation, BasicComplexNum<T> alpha, const BasicComplexMatrixView<T>& a,
+        const BasicComplexMatrixView<T>& x, BasicComplexNum<T> beta, BasicComplexMatrixView<T> y);
+
+private:
+    /// @brief The shared core: count vectors, vector r of x at x + r * xStride, of y at y + r * yStride.
+    static void multiplyVectors(GemvOperation operation, BasicComplexNum<T> alpha, const BasicComplexMatrixView<T>& a,
+        int count, const BasicComplexNum<T>* x, std::size_t xStride, BasicComplexNum<T> beta, BasicComplexNum<T>* y, std::size_t yStride);
+};
+
+using ComplexGemv = BasicComplexGemv<double>;
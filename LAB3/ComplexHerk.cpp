@@ -0,0 +1,154 @@
+#include "ComplexHerk.h"
+#include "ComplexGemm.h"
+#include "ThreadPool.h"
+#include "TuningProfile.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace {
+    /// @brief Products with fewer complex multiply-adds stay on the calling thread.
+    constexpr long long PARALLEL_THRESHOLD = 1 << 18;
+
+    /// @brief Per-thread scratch of one column block: the conjugated panel and the diagonal tile,
+    /// grown on demand and reused across calls.
+    template <typename T>
+    struct HerkBuffers {
+        std::vector<BasicComplexNum<T>> panel;
+        std::vector<BasicComplexNum<T>> diagonal;
+    };
+
+    template <typename T>
+    HerkBuffers<T>& herkBuffers()
+    {
+        thread_local HerkBuffers<T> buffers;
+        return buffers;
+    }
+
+    /// @brief c(i, j) = update(j, c(i, j)) for j in [first, last) of row i, through the row
+    /// pointers of either layout; the range must lie in the backed extent of c.
+    template <typename T, typename Update>
+    void updateRow(const BasicComplexMatrixView<T>& c, int i, int first, int last, Update update)
+    {
+        if (c.getLayout() == StorageLayout::Split)
+        {
+            T* re = c.realRow(i);
+            T* im = c.imagRow(i);
+            for (int j = first; j < last; j++)
+            {
+                BasicComplexNum<T> value = update(j, BasicComplexNum<T>(re[j], im[j]));
+                re[j] = value.getReal();
+                im[j] = value.getImag();
+            }
+        }
+        else
+        {
+            BasicComplexNum<T>* out = c.row(i);
+            for (int j = first; j < last; j++)
+                out[j] = update(j, out[j]);
+        }
+    }
+
+    /// @brief Drops the imaginary part of c(i, i) when it is backed.
+    template <typename T>
+    void realDiagonal(const BasicComplexMatrixView<T>& c, int i)
+    {
+        if (i < c.getValidRows() && i < c.getValidColumns())
+            updateRow(c, i, i, i + 1, [](int, BasicComplexNum<T> value) { return BasicComplexNum<T>(value.getReal(), 0); });
+    }
+}
+
+template <typename T>
+void BasicComplexHerk<T>::update(HermitianTriangle triangle, T alpha, const BasicComplexMatrixView<T>& a, T beta, BasicComplexMatrixView<T> c)
+{
+    const int n = a.getRows();
+    const int depth = a.getColumns();
+    assert(c.getRows() == n && c.getColumns() == n);
+
+    const bool lower = triangle == HermitianTriangle::Lower;
+    const int backedRows = std::min(n, c.getValidRows());
+    const int backedColumns = std::min(n, c.getValidColumns());
+    for (int i = 0; i < backedRows; i++)
+    {
+        const int first = lower ? 0 : i;
+        const int last = std::min(lower ? i + 1 : n, backedColumns);
+        updateRow(c, i, first, last, [beta](int, BasicComplexNum<T> value) {
+            return beta == T() ? BasicComplexNum<T>() : BasicComplexNum<T>(beta * value.getReal(), beta * value.getImag());
+        });
+        realDiagonal(c, i);
+    }
+    if (alpha == T() || depth == 0 || n == 0)
+        return;
+
+    const int blocks = (n + BLOCK - 1) / BLOCK;
+    auto columnBlock = [&](int block) {
+        const int first = block * BLOCK;
+        const int width = std::min(BLOCK, n - first);
+
+        HerkBuffers<T>& buffers = herkBuffers<T>();
+        const std::size_t panelSize = static_cast<std::size_t>(depth) * width;
+        if (buffers.panel.size() < panelSize)
+            buffers.panel.resize(panelSize);
+        if (buffers.diagonal.size() < static_cast<std::size_t>(width) * width)
+            buffers.diagonal.resize(static_cast<std::size_t>(width) * width);
+
+        // panel = alpha * a[first .. first + width)^H, so the products below are plain GEMMs.
+        BasicComplexNum<T>* panel = buffers.panel.data();
+        for (int q = 0; q < width; q++)
+            for (int p = 0; p < depth; p++)
+            {
+                BasicComplexNum<T> value = a.get(first + q, p);
+                panel[static_cast<std::size_t>(p) * width + q] = BasicComplexNum<T>(alpha * value.getReal(), -alpha * value.getImag());
+            }
+        BasicComplexMatrixView<T> panelView(panel, depth, width, width);
+
+        // The diagonal tile is formed whole and only its triangle is kept.
+        const BasicComplexNum<T>* diagonal = buffers.diagonal.data();
+        BasicComplexGemm<T>::multiply(a.block(first, 0, width, depth), panelView, BasicComplexMatrixView<T>(buffers.diagonal.data(), width, width, width));
+        for (int i = 0; i < width && first + i < backedRows; i++)
+        {
+            const BasicComplexNum<T>* tile = diagonal + static_cast<std::size_t>(i) * width;
+            const int tileFirst = lower ? 0 : i;
+            const int tileLast = std::min(lower ? i + 1 : width, backedColumns - first);
+            updateRow(c, first + i, first + tileFirst, first + tileLast, [tile, first](int j, BasicComplexNum<T> value) {
+                return value + tile[j - first];
+            });
+            realDiagonal(c, first + i);
+        }
+
+        // Below the tile for the lower triangle, above it for the upper one.
+        const int rowStart = triangle == HermitianTriangle::Lower ? first + width : 0;
+        const int rowCount = triangle == HermitianTriangle::Lower ? n - first - width : first;
+        if (rowCount > 0)
+            BasicComplexGemm<T>::multiply(a.block(rowStart, 0, rowCount, depth), panelView, c.block(rowStart, first, rowCount, width), true);
+    };
+
+    const long long work = static_cast<long long>(n) * n * depth / 2;
+    if (work < PARALLEL_THRESHOLD || blocks == 1)
+    {
+        for (int block = 0; block < blocks; block++)
+            columnBlock(block);
+        return;
+    }
+    // Blocks write disjoint columns of c; the stealing pool evens out their unequal heights.
+    ThreadPool::shared().parallelFor(blocks, columnBlock, TuningProfile::active().threadCount());
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicComplexHerk<T>::product(const BasicComplexMatrix<T>& a)
+{
+    BasicComplexMatrix<T> result(a.getRows(), a.getRows(), a.getLayout());
+    update(HermitianTriangle::Lower, T(1), BasicComplexMatrixView<T>(const_cast<BasicComplexMatrix<T>&>(a)), T(), BasicComplexMatrixView<T>(result));
+    for (int i = 0; i < result.getRows(); i++)
+        for (int j = i + 1; j < result.getColumns(); j++)
+        {
+            BasicComplexNum<T> value = result.get(j, i);
+            result.set(i, j, BasicComplexNum<T>(value.getReal(), -value.getImag()));
+        }
+    result.setHermitian(true);
+    return result;
+}
+
+template class BasicComplexHerk<float>;
+template class BasicComplexHerk<double>;
+template class BasicComplexHerk<long double>;
@@ -0,0 +1,35 @@
+#pragma once
+#include "ComplexMatrixView.h"
+
+/// @brief Which triangle of a Hermitian matrix is stored or computed; the diagonal belongs to both.
+enum class HermitianTriangle {
+    Upper,
+    Lower
+};
+
+/// @brief Hermitian rank-k update in the BLAS HERK convention: c = alpha * a * a^H + beta * c with
+/// real alpha and beta, where only one triangle of c is read or written and its diagonal comes out
+/// exactly real. a is read once and a^H is never formed as a matrix: c is swept BLOCK columns at a
+/// time, the conjugated rows of a for those columns are packed into a depth x BLOCK panel, and the
+/// part of the column block inside the triangle is one ComplexGemm product with the matching rows
+/// of a. Only the diagonal tiles compute their other half too, so the work is about half a GEMM
+/// (n^2 k / 2 + n * BLOCK * k / 2 complex multiply-adds). Column blocks are split across the
+/// shared ThreadPool; each thread packs its panels and diagonal tiles into scratch it keeps
+/// between calls, like the ComplexGemm packing buffers.
+template <typename T>
+class BasicComplexHerk
+{
+public:
+    /// @brief Columns of c per panel.
+    static constexpr int BLOCK = 128;
+
+    /// @brief c = alpha * a * a^H + beta * c on the given triangle of c (rows(a) x rows(a)); the
+    /// other triangle is left untouched. With beta == 0, c is overwritten without being read.
+    static void update(HermitianTriangle triangle, T alpha, const BasicComplexMatrixView<T>& a, T beta, BasicComplexMatrixView<T> c);
+
+    /// @brief a * a^H as a full matrix flagged Hermitian: the lower triangle is computed by update
+    /// and mirrored into the upper one.
+    static BasicComplexMatrix<T> product(const BasicComplexMatrix<T>& a);
+};
+
+using ComplexHerk = BasicComplexHerk<double>;
@@ -0,0 +1,906 @@
+#include "ComplexKernels.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define COMPLEX_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+    template <typename T>
+    void gemmTileScalar(int depth, const T* a, const T* b, T* real, T* imag)
+    {
+        constexpr int MR = BasicComplexKernels<T>::TILE_ROWS;
+        constexpr int NR = BasicComplexKernels<T>::TILE_COLUMNS;
+        T accRe[MR][NR] = {};
+        T accIm[MR][NR] = {};
+
+        for (int p = 0; p < depth; p++)
+        {
+            const T* ar = a + p * 2 * MR;
+            const T* ai = ar + MR;
+            const T* br = b + p * 2 * NR;
+            const T* bi = br + NR;
+            for (int i = 0; i < MR; i++)
+            {
+                for (int j = 0; j < NR; j++)
+                {
+                    accRe[i][j] += ar[i] * br[j] - ai[i] * bi[j];
+                    accIm[i][j] += ar[i] * bi[j] + ai[i] * br[j];
+                }
+            }
+        }
+
+        for (int i = 0; i < MR; i++)
+        {
+            for (int j = 0; j < NR; j++)
+            {
+                real[i * NR + j] = accRe[i][j];
+                imag[i * NR + j] = accIm[i][j];
+            }
+        }
+    }
+
+    template <typename T>
+    void realGemmTileScalar(int depth, const T* a, const T* b, T* c)
+    {
+        constexpr int MR = BasicComplexKernels<T>::REAL_TILE_ROWS;
+        constexpr int NR = BasicComplexKernels<T>::REAL_TILE_COLUMNS;
+        T acc[MR][NR] = {};
+
+        for (int p = 0; p < depth; p++)
+            for (int i = 0; i < MR; i++)
+                for (int j = 0; j < NR; j++)
+                    acc[i][j] += a[p * MR + i] * b[p * NR + j];
+
+        for (int i = 0; i < MR; i++)
+            for (int j = 0; j < NR; j++)
+                c[i * NR + j] = acc[i][j];
+    }
+
+    template <typename T>
+    void axpyScalar(int n, BasicComplexNum<T> alpha, const BasicComplexNum<T>* x, BasicComplexNum<T>* y)
+    {
+        for (int j = 0; j < n; j++)
+            y[j].addProduct(alpha, x[j]);
+    }
+
+    template <typename T>
+    void axpySplitScalar(int n, BasicComplexNum<T> alpha, const T* xReal, const T* xImag, T* yReal, T* yImag)
+    {
+        const T ar = alpha.getReal();
+        const T ai = alpha.getImag();
+        for (int j = 0; j < n; j++)
+        {
+            yReal[j] += ar * xReal[j] - ai * xImag[j];
+            yImag[j] += ar * xImag[j] + ai * xReal[j];
+        }
+    }
+
+    template <typename T>
+    BasicComplexNum<T> dotScalar(int n, const BasicComplexNum<T>* x, const BasicComplexNum<T>* y)
+    {
+        BasicComplexNum<T> sum;
+        for (int j = 0; j < n; j++)
+            sum.addProduct(x[j], y[j]);
+        return sum;
+    }
+
+    template <typename T>
+    BasicComplexNum<T> dotcScalar(int n, const BasicComplexNum<T>* x, const BasicComplexNum<T>* y)
+    {
+        BasicComplexNum<T> sum;
+        for (int j = 0; j < n; j++)
+            sum.addProduct(BasicComplexNum<T>(x[j].getReal(), -x[j].getImag()), y[j]);
+        return sum;
+    }
+
+    /// @brief Reduces the lane sums of a vector dot product. direct holds x * y lane by lane
+    /// ({xr * yr, xi * yi} per element), swapped holds x * swap(y) ({xr * yi, xi * yr}).
+    template <bool Conjugate, typename T>
+    BasicComplexNum<T> finishDot(const T* direct, const T* swapped, int lanes)
+    {
+        T directEven = T(), directOdd = T(), swappedEven = T(), swappedOdd = T();
+        for (int l = 0; l < lanes; l += 2)
+        {
+            directEven += direct[l];
+            directOdd += direct[l + 1];
+            swappedEven += swapped[l];
+            swappedOdd += swapped[l + 1];
+        }
+        if (Conjugate)
+            return BasicComplexNum<T>(directEven + directOdd, swappedEven - swappedOdd);
+        return BasicComplexNum<T>(directEven - directOdd, swappedEven + swappedOdd);
+    }
+
+    /// @brief Scalar tail of the vector dot products, continuing from sum.
+    template <bool Conjugate, typename T>
+    BasicComplexNum<T> dotTail(BasicComplexNum<T> sum, int first, int n, const BasicComplexNum<T>* x, const BasicComplexNum<T>* y)
+    {
+        for (int j = first; j < n; j++)
+            sum.addProduct(Conjugate ? BasicComplexNum<T>(x[j].getReal(), -x[j].getImag()) : x[j], y[j]);
+        return sum;
+    }
+
+#ifdef COMPLEX_KERNELS_X86
+    // ---- SSE2 ----
+
+    /// @brief Two rows of the double tile; a whole 4 x 4 tile needs more accumulators than the
+    /// sixteen xmm registers hold, so the tile is computed in two passes over the same slivers.
+    __attribute__((target("sse2")))
+    void gemmRowsSse2(int depth, const double* a, const double* b, int row, double* real, double* imag)
+    {
+        __m128d re00 = _mm_setzero_pd(), re01 = _mm_setzero_pd(), im00 = _mm_setzero_pd(), im01 = _mm_setzero_pd();
+        __m128d re10 = _mm_setzero_pd(), re11 = _mm_setzero_pd(), im10 = _mm_setzero_pd(), im11 = _mm_setzero_pd();
+        for (int p = 0; p < depth; p++)
+        {
+            const double* ap = a + p * 8;
+            const double* bp = b + p * 8;
+            const __m128d br0 = _mm_loadu_pd(bp), br1 = _mm_loadu_pd(bp + 2);
+            const __m128d bi0 = _mm_loadu_pd(bp + 4), bi1 = _mm_loadu_pd(bp + 6);
+
+            __m128d ar = _mm_set1_pd(ap[row]), ai = _mm_set1_pd(ap[4 + row]);
+            re00 = _mm_add_pd(re00, _mm_sub_pd(_mm_mul_pd(ar, br0), _mm_mul_pd(ai, bi0)));
+            re01 = _mm_add_pd(re01, _mm_sub_pd(_mm_mul_pd(ar, br1), _mm_mul_pd(ai, bi1)));
+            im00 = _mm_add_pd(im00, _mm_add_pd(_mm_mul_pd(ar, bi0), _mm_mul_pd(ai, br0)));
+            im01 = _mm_add_pd(im01, _mm_add_pd(_mm_mul_pd(ar, bi1), _mm_mul_pd(ai, br1)));
+
+            ar = _mm_set1_pd(ap[row + 1]);
+            ai = _mm_set1_pd(ap[4 + row + 1]);
+            re10 = _mm_add_pd(re10, _mm_sub_pd(_mm_mul_pd(ar, br0), _mm_mul_pd(ai, bi0)));
+            re11 = _mm_add_pd(re11, _mm_sub_pd(_mm_mul_pd(ar, br1), _mm_mul_pd(ai, bi1)));
+            im10 = _mm_add_pd(im10, _mm_add_pd(_mm_mul_pd(ar, bi0), _mm_mul_pd(ai, br0)));
+            im11 = _mm_add_pd(im11, _mm_add_pd(_mm_mul_pd(ar, bi1), _mm_mul_pd(ai, br1)));
+        }
+        _mm_storeu_pd(real + row * 4, re00);
+        _mm_storeu_pd(real + row * 4 + 2, re01);
+        _mm_storeu_pd(imag + row * 4, im00);
+        _mm_storeu_pd(imag + row * 4 + 2, im01);
+        _mm_storeu_pd(real + row * 4 + 4, re10);
+        _mm_storeu_pd(real + row * 4 + 6, re11);
+        _mm_storeu_pd(imag + row * 4 + 4, im10);
+        _mm_storeu_pd(imag + row * 4 + 6, im11);
+    }
+
+    __attribute__((target("sse2")))
+    void gemmTileSse2(int depth, const double* a, const double* b, double* real, double* imag)
+    {
+        gemmRowsSse2(depth, a, b, 0, real, imag);
+        gemmRowsSse2(depth, a, b, 2, real, imag);
+    }
+
+    __attribute__((target("sse2")))
+    void gemmTileSse2(int depth, const float* a, const float* b, float* real, float* imag)
+    {
+        __m128 re0 = _mm_setzero_ps(), re1 = _mm_setzero_ps(), re2 = _mm_setzero_ps(), re3 = _mm_setzero_ps();
+        __m128 im0 = _mm_setzero_ps(), im1 = _mm_setzero_ps(), im2 = _mm_setzero_ps(), im3 = _mm_setzero_ps();
+        for (int p = 0; p < depth; p++)
+        {
+            const float* ap = a + p * 8;
+            const __m128 br = _mm_loadu_ps(b + p * 8);
+            const __m128 bi = _mm_loadu_ps(b + p * 8 + 4);
+            __m128 ar = _mm_set1_ps(ap[0]), ai = _mm_set1_ps(ap[4]);
+            re0 = _mm_add_ps(re0, _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+            im0 = _mm_add_ps(im0, _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+            ar = _mm_set1_ps(ap[1]);
+            ai = _mm_set1_ps(ap[5]);
+            re1 = _mm_add_ps(re1, _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+            im1 = _mm_add_ps(im1, _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+            ar = _mm_set1_ps(ap[2]);
+            ai = _mm_set1_ps(ap[6]);
+            re2 = _mm_add_ps(re2, _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+            im2 = _mm_add_ps(im2, _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+            ar = _mm_set1_ps(ap[3]);
+            ai = _mm_set1_ps(ap[7]);
+            re3 = _mm_add_ps(re3, _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi)));
+            im3 = _mm_add_ps(im3, _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br)));
+        }
+        _mm_storeu_ps(real, re0);
+        _mm_storeu_ps(real + 4, re1);
+        _mm_storeu_ps(real + 8, re2);
+        _mm_storeu_ps(real + 12, re3);
+        _mm_storeu_ps(imag, im0);
+        _mm_storeu_ps(imag + 4, im1);
+        _mm_storeu_ps(imag + 8, im2);
+        _mm_storeu_ps(imag + 12, im3);
+    }
+
+    /// @brief Two rows of the double real tile, for the same register reason as gemmRowsSse2.
+    __attribute__((target("sse2")))
+    void realGemmRowsSse2(int depth, const double* a, const double* b, int row, double* c)
+    {
+        __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd(), c02 = _mm_setzero_pd(), c03 = _mm_setzero_pd();
+        __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd(), c12 = _mm_setzero_pd(), c13 = _mm_setzero_pd();
+        for (int p = 0; p < depth; p++)
+        {
+            const double* bp = b + p * 8;
+            const __m128d b0 = _mm_loadu_pd(bp), b1 = _mm_loadu_pd(bp + 2), b2 = _mm_loadu_pd(bp + 4), b3 = _mm_loadu_pd(bp + 6);
+            __m128d av = _mm_set1_pd(a[p * 4 + row]);
+            c00 = _mm_add_pd(c00, _mm_mul_pd(av, b0));
+            c01 = _mm_add_pd(c01, _mm_mul_pd(av, b1));
+            c02 = _mm_add_pd(c02, _mm_mul_pd(av, b2));
+            c03 = _mm_add_pd(c03, _mm_mul_pd(av, b3));
+            av = _mm_set1_pd(a[p * 4 + row + 1]);
+            c10 = _mm_add_pd(c10, _mm_mul_pd(av, b0));
+            c11 = _mm_add_pd(c11, _mm_mul_pd(av, b1));
+            c12 = _mm_add_pd(c12, _mm_mul_pd(av, b2));
+            c13 = _mm_add_pd(c13, _mm_mul_pd(av, b3));
+        }
+        double* out = c + row * 8;
+        _mm_storeu_pd(out, c00);
+        _mm_storeu_pd(out + 2, c01);
+        _mm_storeu_pd(out + 4, c02);
+        _mm_storeu_pd(out + 6, c03);
+        _mm_storeu_pd(out + 8, c10);
+        _mm_storeu_pd(out + 10, c11);
+        _mm_storeu_pd(out + 12, c12);
+        _mm_storeu_pd(out + 14, c13);
+    }
+
+    __attribute__((target("sse2")))
+    void realGemmTileSse2(int depth, const double* a, const double* b, double* c)
+    {
+        realGemmRowsSse2(depth, a, b, 0, c);
+        realGemmRowsSse2(depth, a, b, 2, c);
+    }
+
+    __attribute__((target("sse2")))
+    void realGemmTileSse2(int depth, const float* a, const float* b, float* c)
+    {
+        __m128 c00 = _mm_setzero_ps(), c01 = _mm_setzero_ps(), c10 = _mm_setzero_ps(), c11 = _mm_setzero_ps();
+        __m128 c20 = _mm_setzero_ps(), c21 = _mm_setzero_ps(), c30 = _mm_setzero_ps(), c31 = _mm_setzero_ps();
+        for (int p = 0; p < depth; p++)
+        {
+            const float* ap = a + p * 4;
+            const __m128 b0 = _mm_loadu_ps(b + p * 8), b1 = _mm_loadu_ps(b + p * 8 + 4);
+            __m128 av = _mm_set1_ps(ap[0]);
+            c00 = _mm_add_ps(c00, _mm_mul_ps(av, b0));
+            c01 = _mm_add_ps(c01, _mm_mul_ps(av, b1));
+            av = _mm_set1_ps(ap[1]);
+            c10 = _mm_add_ps(c10, _mm_mul_ps(av, b0));
+            c11 = _mm_add_ps(c11, _mm_mul_ps(av, b1));
+            av = _mm_set1_ps(ap[2]);
+            c20 = _mm_add_ps(c20, _mm_mul_ps(av, b0));
+            c21 = _mm_add_ps(c21, _mm_mul_ps(av, b1));
+            av = _mm_set1_ps(ap[3]);
+            c30 = _mm_add_ps(c30, _mm_mul_ps(av, b0));
+            c31 = _mm_add_ps(c31, _mm_mul_ps(av, b1));
+        }
+        _mm_storeu_ps(c, c00);
+        _mm_storeu_ps(c + 4, c01);
+        _mm_storeu_ps(c + 8, c10);
+        _mm_storeu_ps(c + 12, c11);
+        _mm_storeu_ps(c + 16, c20);
+        _mm_storeu_ps(c + 20, c21);
+        _mm_storeu_ps(c + 24, c30);
+        _mm_storeu_ps(c + 28, c31);
+    }
+
+    __attribute__((target("sse2")))
+    void axpySse2(int n, BasicComplexNum<double> alpha, const BasicComplexNum<double>* x, BasicComplexNum<double>* y)
+    {
+        const __m128d ar = _mm_set1_pd(alpha.getReal());
+        const __m128d ai = _mm_set1_pd(alpha.getImag());
+        // Flips the sign of the real lane: {ai * xi, ai * xr} becomes {-ai * xi, ai * xr}.
+        const __m128d sign = _mm_set_pd(0.0, -0.0);
+        const double* xs = reinterpret_cast<const double*>(x);
+        double* ys = reinterpret_cast<double*>(y);
+        for (int j = 0; j < n; j++)
+        {
+            const __m128d v = _mm_loadu_pd(xs + 2 * j);
+            const __m128d swapped = _mm_shuffle_pd(v, v, 1);
+            const __m128d product = _mm_add_pd(_mm_mul_pd(ar, v), _mm_xor_pd(_mm_mul_pd(ai, swapped), sign));
+            _mm_storeu_pd(ys + 2 * j, _mm_add_pd(_mm_loadu_pd(ys + 2 * j), product));
+        }
+    }
+
+    __attribute__((target("sse2")))
+    void axpySse2(int n, BasicComplexNum<float> alpha, const BasicComplexNum<float>* x, BasicComplexNum<float>* y)
+    {
+        const __m128 ar = _mm_set1_ps(alpha.getReal());
+        const __m128 ai = _mm_set1_ps(alpha.getImag());
+        const __m128 sign = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+        const float* xs = reinterpret_cast<const float*>(x);
+        float* ys = reinterpret_cast<float*>(y);
+        int j = 0;
+        for (; j + 2 <= n; j += 2)
+        {
+            const __m128 v = _mm_loadu_ps(xs + 2 * j);
+            const __m128 swapped = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            const __m128 product = _mm_add_ps(_mm_mul_ps(ar, v), _mm_xor_ps(_mm_mul_ps(ai, swapped), sign));
+            _mm_storeu_ps(ys + 2 * j, _mm_add_ps(_mm_loadu_ps(ys + 2 * j), product));
+        }
+        axpyScalar(n - j, alpha, x + j, y + j);
+    }
+
+    __attribute__((target("sse2")))
+    void axpySplitSse2(int n, BasicComplexNum<double> alpha, const double* xReal, const double* xImag, double* yReal, double* yImag)
+    {
+        const __m128d ar = _mm_set1_pd(alpha.getReal());
+        const __m128d ai = _mm_set1_pd(alpha.getImag());
+        int j = 0;
+        for (; j + 2 <= n; j += 2)
+        {
+            const __m128d xr = _mm_loadu_pd(xReal + j);
+            const __m128d xi = _mm_loadu_pd(xImag + j);
+            _mm_storeu_pd(yReal + j, _mm_add_pd(_mm_loadu_pd(yReal + j), _mm_sub_pd(_mm_mul_pd(ar, xr), _mm_mul_pd(ai, xi))));
+            _mm_storeu_pd(yImag + j, _mm_add_pd(_mm_loadu_pd(yImag + j), _mm_add_pd(_mm_mul_pd(ar, xi), _mm_mul_pd(ai, xr))));
+        }
+        axpySplitScalar(n - j, alpha, xReal + j, xImag + j, yReal + j, yImag + j);
+    }
+
+    __attribute__((target("sse2")))
+    void axpySplitSse2(int n, BasicComplexNum<float> alpha, const float* xReal, const float* xImag, float* yReal, float* yImag)
+    {
+        const __m128 ar = _mm_set1_ps(alpha.getReal());
+        const __m128 ai = _mm_set1_ps(alpha.getImag());
+        int j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const __m128 xr = _mm_loadu_ps(xReal + j);
+            const __m128 xi = _mm_loadu_ps(xImag + j);
+            _mm_storeu_ps(yReal + j, _mm_add_ps(_mm_loadu_ps(yReal + j), _mm_sub_ps(_mm_mul_ps(ar, xr), _mm_mul_ps(ai, xi))));
+            _mm_storeu_ps(yImag + j, _mm_add_ps(_mm_loadu_ps(yImag + j), _mm_add_ps(_mm_mul_ps(ar, xi), _mm_mul_ps(ai, xr))));
+        }
+        axpySplitScalar(n - j, alpha, xReal + j, xImag + j, yReal + j, yImag + j);
+    }
+
+    template <bool Conjugate>
+    __attribute__((target("sse2")))
+    BasicComplexNum<double> dotSse2(int n, const BasicComplexNum<double>* x, const BasicComplexNum<double>* y)
+    {
+        const double* xs = reinterpret_cast<const double*>(x);
+        const double* ys = reinterpret_cast<const double*>(y);
+        __m128d direct = _mm_setzero_pd();
+        __m128d swapped = _mm_setzero_pd();
+        for (int j = 0; j < n; j++)
+        {
+            const __m128d u = _mm_loadu_pd(xs + 2 * j);
+            const __m128d v = _mm_loadu_pd(ys + 2 * j);
+            direct = _mm_add_pd(direct, _mm_mul_pd(u, v));
+            swapped = _mm_add_pd(swapped, _mm_mul_pd(u, _mm_shuffle_pd(v, v, 1)));
+        }
+        double d[2], s[2];
+        _mm_storeu_pd(d, direct);
+        _mm_storeu_pd(s, swapped);
+        return finishDot<Conjugate>(d, s, 2);
+    }
+
+    template <bool Conjugate>
+    __attribute__((target("sse2")))
+    BasicComplexNum<float> dotSse2(int n, const BasicComplexNum<float>* x, const BasicComplexNum<float>* y)
+    {
+        const float* xs = reinterpret_cast<const float*>(x);
+        const float* ys = reinterpret_cast<const float*>(y);
+        __m128 direct = _mm_setzero_ps();
+        __m128 swapped = _mm_setzero_ps();
+        int j = 0;
+        for (; j + 2 <= n; j += 2)
+        {
+            const __m128 u = _mm_loadu_ps(xs + 2 * j);
+            const __m128 v = _mm_loadu_ps(ys + 2 * j);
+            direct = _mm_add_ps(direct, _mm_mul_ps(u, v));
+            swapped = _mm_add_ps(swapped, _mm_mul_ps(u, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+        }
+        float d[4], s[4];
+        _mm_storeu_ps(d, direct);
+        _mm_storeu_ps(s, swapped);
+        return dotTail<Conjugate>(finishDot<Conjugate>(d, s, 4), j, n, x, y);
+    }
+
+    // ---- AVX2 + FMA ----
+
+    __attribute__((target("avx2,fma")))
+    void gemmTileAvx2(int depth, const double* a, const double* b, double* real, double* imag)
+    {
+        __m256d re0 = _mm256_setzero_pd(), re1 = _mm256_setzero_pd(), re2 = _mm256_setzero_pd(), re3 = _mm256_setzero_pd();
+        __m256d im0 = _mm256_setzero_pd(), im1 = _mm256_setzero_pd(), im2 = _mm256_setzero_pd(), im3 = _mm256_setzero_pd();
+        for (int p = 0; p < depth; p++)
+        {
+            const double* ap = a + p * 8;
+            const __m256d br = _mm256_loadu_pd(b + p * 8);
+            const __m256d bi = _mm256_loadu_pd(b + p * 8 + 4);
+            __m256d ar = _mm256_broadcast_sd(ap), ai = _mm256_broadcast_sd(ap + 4);
+            re0 = _mm256_fnmadd_pd(ai, bi, _mm256_fmadd_pd(ar, br, re0));
+            im0 = _mm256_fmadd_pd(ai, br, _mm256_fmadd_pd(ar, bi, im0));
+            ar = _mm256_broadcast_sd(ap + 1);
+            ai = _mm256_broadcast_sd(ap + 5);
+            re1 = _mm256_fnmadd_pd(ai, bi, _mm256_fmadd_pd(ar, br, re1));
+            im1 = _mm256_fmadd_pd(ai, br, _mm256_fmadd_pd(ar, bi, im1));
+            ar = _mm256_broadcast_sd(ap + 2);
+            ai = _mm256_broadcast_sd(ap + 6);
+            re2 = _mm256_fnmadd_pd(ai, bi, _mm256_fmadd_pd(ar, br, re2));
+            im2 = _mm256_fmadd_pd(ai, br, _mm256_fmadd_pd(ar, bi, im2));
+            ar = _mm256_broadcast_sd(ap + 3);
+            ai = _mm256_broadcast_sd(ap + 7);
+            re3 = _mm256_fnmadd_pd(ai, bi, _mm256_fmadd_pd(ar, br, re3));
+            im3 = _mm256_fmadd_pd(ai, br, _mm256_fmadd_pd(ar, bi, im3));
+        }
+        _mm256_storeu_pd(real, re0);
+        _mm256_storeu_pd(real + 4, re1);
+        _mm256_storeu_pd(real + 8, re2);
+        _mm256_storeu_pd(real + 12, re3);
+        _mm256_storeu_pd(imag, im0);
+        _mm256_storeu_pd(imag + 4, im1);
+        _mm256_storeu_pd(imag + 8, im2);
+        _mm256_storeu_pd(imag + 12, im3);
+    }
+
+    /// @brief Float tile with one ymm per row: a packed B step {br0..3, bi0..3} is a single
+    /// register, and its half-swapped copy {bi, br} gives the cross terms, so each row costs two
+    /// FMAs per step. direct collects {ar * br, ar * bi}, swapped {ai * bi, ai * br}.
+    __attribute__((target("avx2,fma")))
+    void gemmTileAvx2(int depth, const float* a, const float* b, float* real, float* imag)
+    {
+        __m256 d0 = _mm256_setzero_ps(), d1 = _mm256_setzero_ps(), d2 = _mm256_setzero_ps(), d3 = _mm256_setzero_ps();
+        __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+        for (int p = 0; p < depth; p++)
+        {
+            const float* ap = a + p * 8;
+            const __m256 bv = _mm256_loadu_ps(b + p * 8);
+            const __m256 bs = _mm256_permute2f128_ps(bv, bv, 1);
+            d0 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap), bv, d0);
+            s0 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 4), bs, s0);
+            d1 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 1), bv, d1);
+            s1 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 5), bs, s1);
+            d2 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 2), bv, d2);
+            s2 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 6), bs, s2);
+            d3 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 3), bv, d3);
+            s3 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 7), bs, s3);
+        }
+        const __m256 direct[4] = { d0, d1, d2, d3 };
+        const __m256 swapped[4] = { s0, s1, s2, s3 };
+        for (int i = 0; i < 4; i++)
+        {
+            const __m128 dLow = _mm256_castps256_ps128(direct[i]), dHigh = _mm256_extractf128_ps(direct[i], 1);
+            const __m128 sLow = _mm256_castps256_ps128(swapped[i]), sHigh = _mm256_extractf128_ps(swapped[i], 1);
+            _mm_storeu_ps(real + i * 4, _mm_sub_ps(dLow, sLow));
+            _mm_storeu_ps(imag + i * 4, _mm_add_ps(dHigh, sHigh));
+        }
+    }
+
+    __attribute__((target("avx2,fma")))
+    void realGemmTileAvx2(int depth, const double* a, const double* b, double* c)
+    {
+        __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd(), c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+        __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd(), c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+        for (int p = 0; p < depth; p++)
+        {
+            const double* ap = a + p * 4;
+            const __m256d b0 = _mm256_loadu_pd(b + p * 8), b1 = _mm256_loadu_pd(b + p * 8 + 4);
+            __m256d av = _mm256_broadcast_sd(ap);
+            c00 = _mm256_fmadd_pd(av, b0, c00);
+            c01 = _mm256_fmadd_pd(av, b1, c01);
+            av = _mm256_broadcast_sd(ap + 1);
+            c10 = _mm256_fmadd_pd(av, b0, c10);
+            c11 = _mm256_fmadd_pd(av, b1, c11);
+            av = _mm256_broadcast_sd(ap + 2);
+            c20 = _mm256_fmadd_pd(av, b0, c20);
+            c21 = _mm256_fmadd_pd(av, b1, c21);
+            av = _mm256_broadcast_sd(ap + 3);
+            c30 = _mm256_fmadd_pd(av, b0, c30);
+            c31 = _mm256_fmadd_pd(av, b1, c31);
+        }
+        _mm256_storeu_pd(c, c00);
+        _mm256_storeu_pd(c + 4, c01);
+        _mm256_storeu_pd(c + 8, c10);
+        _mm256_storeu_pd(c + 12, c11);
+        _mm256_storeu_pd(c + 16, c20);
+        _mm256_storeu_pd(c + 20, c21);
+        _mm256_storeu_pd(c + 24, c30);
+        _mm256_storeu_pd(c + 28, c31);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void realGemmTileAvx2(int depth, const float* a, const float* b, float* c)
+    {
+        __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps(), c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+        for (int p = 0; p < depth; p++)
+        {
+            const float* ap = a + p * 4;
+            const __m256 bv = _mm256_loadu_ps(b + p * 8);
+            c0 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap), bv, c0);
+            c1 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 1), bv, c1);
+            c2 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 2), bv, c2);
+            c3 = _mm256_fmadd_ps(_mm256_broadcast_ss(ap + 3), bv, c3);
+        }
+        _mm256_storeu_ps(c, c0);
+        _mm256_storeu_ps(c + 8, c1);
+        _mm256_storeu_ps(c + 16, c2);
+        _mm256_storeu_ps(c + 24, c3);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void axpyAvx2(int n, BasicComplexNum<double> alpha, const BasicComplexNum<double>* x, BasicComplexNum<double>* y)
+    {
+        const __m256d ar = _mm256_set1_pd(alpha.getReal());
+        const __m256d ai = _mm256_set1_pd(alpha.getImag());
+        const double* xs = reinterpret_cast<const double*>(x);
+        double* ys = reinterpret_cast<double*>(y);
+        int j = 0;
+        for (; j + 2 <= n; j += 2)
+        {
+            const __m256d v = _mm256_loadu_pd(xs + 2 * j);
+            // fmaddsub: even (real) lanes ar * xr - ai * xi, odd (imaginary) lanes ar * xi + ai * xr.
+            const __m256d cross = _mm256_mul_pd(ai, _mm256_permute_pd(v, 0x5));
+            const __m256d product = _mm256_fmaddsub_pd(ar, v, cross);
+            _mm256_storeu_pd(ys + 2 * j, _mm256_add_pd(_mm256_loadu_pd(ys + 2 * j), product));
+        }
+        axpyScalar(n - j, alpha, x + j, y + j);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void axpyAvx2(int n, BasicComplexNum<float> alpha, const BasicComplexNum<float>* x, BasicComplexNum<float>* y)
+    {
+        const __m256 ar = _mm256_set1_ps(alpha.getReal());
+        const __m256 ai = _mm256_set1_ps(alpha.getImag());
+        const float* xs = reinterpret_cast<const float*>(x);
+        float* ys = reinterpret_cast<float*>(y);
+        int j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const __m256 v = _mm256_loadu_ps(xs + 2 * j);
+            const __m256 cross = _mm256_mul_ps(ai, _mm256_permute_ps(v, 0xB1));
+            const __m256 product = _mm256_fmaddsub_ps(ar, v, cross);
+            _mm256_storeu_ps(ys + 2 * j, _mm256_add_ps(_mm256_loadu_ps(ys + 2 * j), product));
+        }
+        axpyScalar(n - j, alpha, x + j, y + j);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void axpySplitAvx2(int n, BasicComplexNum<double> alpha, const double* xReal, const double* xImag, double* yReal, double* yImag)
+    {
+        const __m256d ar = _mm256_set1_pd(alpha.getReal());
+        const __m256d ai = _mm256_set1_pd(alpha.getImag());
+        int j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const __m256d xr = _mm256_loadu_pd(xReal + j);
+            const __m256d xi = _mm256_loadu_pd(xImag + j);
+            _mm256_storeu_pd(yReal + j, _mm256_fnmadd_pd(ai, xi, _mm256_fmadd_pd(ar, xr, _mm256_loadu_pd(yReal + j))));
+            _mm256_storeu_pd(yImag + j, _mm256_fmadd_pd(ai, xr, _mm256_fmadd_pd(ar, xi, _mm256_loadu_pd(yImag + j))));
+        }
+        axpySplitScalar(n - j, alpha, xReal + j, xImag + j, yReal + j, yImag + j);
+    }
+
+    __attribute__((target("avx2,fma")))
+    void axpySplitAvx2(int n, BasicComplexNum<float> alpha, const float* xReal, const float* xImag, float* yReal, float* yImag)
+    {
+        const __m256 ar = _mm256_set1_ps(alpha.getReal());
+        const __m256 ai = _mm256_set1_ps(alpha.getImag());
+        int j = 0;
+        for (; j + 8 <= n; j += 8)
+        {
+            const __m256 xr = _mm256_loadu_ps(xReal + j);
+            const __m256 xi = _mm256_loadu_ps(xImag + j);
+            _mm256_storeu_ps(yReal + j, _mm256_fnmadd_ps(ai, xi, _mm256_fmadd_ps(ar, xr, _mm256_loadu_ps(yReal + j))));
+            _mm256_storeu_ps(yImag + j, _mm256_fmadd_ps(ai, xr, _mm256_fmadd_ps(ar, xi, _mm256_loadu_ps(yImag + j))));
+        }
+        axpySplitScalar(n - j, alpha, xReal + j, xImag + j, yReal + j, yImag + j);
+    }
+
+    template <bool Conjugate>
+    __attribute__((target("avx2,fma")))
+    BasicComplexNum<double> dotAvx2(int n, const BasicComplexNum<double>* x, const BasicComplexNum<double>* y)
+    {
+        const double* xs = reinterpret_cast<const double*>(x);
+        const double* ys = reinterpret_cast<const double*>(y);
+        __m256d direct = _mm256_setzero_pd();
+        __m256d swapped = _mm256_setzero_pd();
+        int j = 0;
+        for (; j + 2 <= n; j += 2)
+        {
+            const __m256d u = _mm256_loadu_pd(xs + 2 * j);
+            const __m256d v = _mm256_loadu_pd(ys + 2 * j);
+            direct = _mm256_fmadd_pd(u, v, direct);
+            swapped = _mm256_fmadd_pd(u, _mm256_permute_pd(v, 0x5), swapped);
+        }
+        double d[4], s[4];
+        _mm256_storeu_pd(d, direct);
+        _mm256_storeu_pd(s, swapped);
+        return dotTail<Conjugate>(finishDot<Conjugate>(d, s, 4), j, n, x, y);
+    }
+
+    template <bool Conjugate>
+    __attribute__((target("avx2,fma")))
+    BasicComplexNum<float> dotAvx2(int n, const BasicComplexNum<float>* x, const BasicComplexNum<float>* y)
+    {
+        const float* xs = reinterpret_cast<const float*>(x);
+        const float* ys = reinterpret_cast<const float*>(y);
+        __m256 direct = _mm256_setzero_ps();
+        __m256 swapped = _mm256_setzero_ps();
+        int j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const __m256 u = _mm256_loadu_ps(xs + 2 * j);
+            const __m256 v = _mm256_loadu_ps(ys + 2 * j);
+            direct = _mm256_fmadd_ps(u, v, direct);
+            swapped = _mm256_fmadd_ps(u, _mm256_permute_ps(v, 0xB1), swapped);
+        }
+        float d[8], s[8];
+        _mm256_storeu_ps(d, direct);
+        _mm256_storeu_ps(s, swapped);
+        return dotTail<Conjugate>(finishDot<Conjugate>(d, s, 8), j, n, x, y);
+    }
+
+    // ---- AVX-512 ----
+
+    // The unmasked AVX-512 permutes trip a GCC -Wmaybe-uninitialized false positive on their
+    // undefined pass-through operand; a full mask over an explicit source is the same instruction.
+    __attribute__((target("avx512f")))
+    inline __m512d swapPairs(__m512d v)
+    {
+        return _mm512_mask_permute_pd(v, 0xFF, v, 0x55);
+    }
+
+    __attribute__((target("avx512f")))
+    inline __m512 swapPairs(__m512 v)
+    {
+        return _mm512_mask_permute_ps(v, 0xFFFF, v, 0xB1);
+    }
+
+    /// @brief Double tile with one zmm per row, the same half-swap scheme as the AVX2 float tile.
+    __attribute__((target("avx512f")))
+    void gemmTileAvx512(int depth, const double* a, const double* b, double* real, double* imag)
+    {
+        __m512d d0 = _mm512_setzero_pd(), d1 = _mm512_setzero_pd(), d2 = _mm512_setzero_pd(), d3 = _mm512_setzero_pd();
+        __m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd(), s2 = _mm512_setzero_pd(), s3 = _mm512_setzero_pd();
+        const __m512i halves = _mm512_set_epi64(3, 2, 1, 0, 7, 6, 5, 4);
+        for (int p = 0; p < depth; p++)
+        {
+            const double* ap = a + p * 8;
+            const __m512d bv = _mm512_loadu_pd(b + p * 8);
+            const __m512d bs = _mm512_mask_permutexvar_pd(bv, 0xFF, halves, bv);
+            d0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[0]), bv, d0);
+            s0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[4]), bs, s0);
+            d1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[1]), bv, d1);
+            s1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[5]), bs, s1);
+            d2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[2]), bv, d2);
+            s2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[6]), bs, s2);
+            d3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[3]), bv, d3);
+            s3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[7]), bs, s3);
+        }
+        // Lanes 0-3 of direct - swapped are the real row, lanes 4-7 of direct + swapped the imaginary one.
+        const __m512d direct[4] = { d0, d1, d2, d3 };
+        const __m512d swapped[4] = { s0, s1, s2, s3 };
+        for (int i = 0; i < 4; i++)
+        {
+            double row[8];
+            _mm512_storeu_pd(row, _mm512_mask_sub_pd(_mm512_add_pd(direct[i], swapped[i]), 0x0F, direct[i], swapped[i]));
+            for (int j = 0; j < 4; j++)
+            {
+                real[i * 4 + j] = row[j];
+                imag[i * 4 + j] = row[4 + j];
+            }
+        }
+    }
+
+    /// @brief One zmm per tile row leaves only four accumulators, too few to cover the FMA latency,
+    /// so even and odd depth steps accumulate separately and are summed at the end.
+    __attribute__((target("avx512f")))
+    void realGemmTileAvx512(int depth, const double* a, const double* b, double* c)
+    {
+        __m512d c0 = _mm512_setzero_pd(), c1 = _mm512_setzero_pd(), c2 = _mm512_setzero_pd(), c3 = _mm512_setzero_pd();
+        __m512d e0 = _mm512_setzero_pd(), e1 = _mm512_setzero_pd(), e2 = _mm512_setzero_pd(), e3 = _mm512_setzero_pd();
+        int p = 0;
+        for (; p + 2 <= depth; p += 2)
+        {
+            const double* ap = a + p * 4;
+            const __m512d bv = _mm512_loadu_pd(b + p * 8);
+            const __m512d bw = _mm512_loadu_pd(b + p * 8 + 8);
+            c0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[0]), bv, c0);
+            c1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[1]), bv, c1);
+            c2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[2]), bv, c2);
+            c3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[3]), bv, c3);
+            e0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[4]), bw, e0);
+            e1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[5]), bw, e1);
+            e2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[6]), bw, e2);
+            e3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[7]), bw, e3);
+        }
+        if (p < depth)
+        {
+            const double* ap = a + p * 4;
+            const __m512d bv = _mm512_loadu_pd(b + p * 8);
+            c0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[0]), bv, c0);
+            c1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[1]), bv, c1);
+            c2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[2]), bv, c2);
+            c3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[3]), bv, c3);
+        }
+        _mm512_storeu_pd(c, _mm512_add_pd(c0, e0));
+        _mm512_storeu_pd(c + 8, _mm512_add_pd(c1, e1));
+        _mm512_storeu_pd(c + 16, _mm512_add_pd(c2, e2));
+        _mm512_storeu_pd(c + 24, _mm512_add_pd(c3, e3));
+    }
+
+    __attribute__((target("avx512f")))
+    void axpyAvx512(int n, BasicComplexNum<double> alpha, const BasicComplexNum<double>* x, BasicComplexNum<double>* y)
+    {
+        const __m512d ar = _mm512_set1_pd(alpha.getReal());
+        const __m512d ai = _mm512_set1_pd(alpha.getImag());
+        const double* xs = reinterpret_cast<const double*>(x);
+        double* ys = reinterpret_cast<double*>(y);
+        int j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const __m512d v = _mm512_loadu_pd(xs + 2 * j);
+            const __m512d cross = _mm512_mul_pd(ai, swapPairs(v));
+            const __m512d product = _mm512_fmaddsub_pd(ar, v, cross);
+            _mm512_storeu_pd(ys + 2 * j, _mm512_add_pd(_mm512_loadu_pd(ys + 2 * j), product));
+        }
+        axpyScalar(n - j, alpha, x + j, y + j);
+    }
+
+    __attribute__((target("avx512f")))
+    void axpyAvx512(int n, BasicComplexNum<float> alpha, const BasicComplexNum<float>* x, BasicComplexNum<float>* y)
+    {
+        const __m512 ar = _mm512_set1_ps(alpha.getReal());
+        const __m512 ai = _mm512_set1_ps(alpha.getImag());
+        const float* xs = reinterpret_cast<const float*>(x);
+        float* ys = reinterpret_cast<float*>(y);
+        int j = 0;
+        for (; j + 8 <= n; j += 8)
+        {
+            const __m512 v = _mm512_loadu_ps(xs + 2 * j);
+            const __m512 cross = _mm512_mul_ps(ai, swapPairs(v));
+            const __m512 product = _mm512_fmaddsub_ps(ar, v, cross);
+            _mm512_storeu_ps(ys + 2 * j, _mm512_add_ps(_mm512_loadu_ps(ys + 2 * j), product));
+        }
+        axpyScalar(n - j, alpha, x + j, y + j);
+    }
+
+    __attribute__((target("avx512f")))
+    void axpySplitAvx512(int n, BasicComplexNum<double> alpha, const double* xReal, const double* xImag, double* yReal, double* yImag)
+    {
+        const __m512d ar = _mm512_set1_pd(alpha.getReal());
+        const __m512d ai = _mm512_set1_pd(alpha.getImag());
+        int j = 0;
+        for (; j + 8 <= n; j += 8)
+        {
+            const __m512d xr = _mm512_loadu_pd(xReal + j);
+            const __m512d xi = _mm512_loadu_pd(xImag + j);
+            _mm512_storeu_pd(yReal + j, _mm512_fnmadd_pd(ai, xi, _mm512_fmadd_pd(ar, xr, _mm512_loadu_pd(yReal + j))));
+            _mm512_storeu_pd(yImag + j, _mm512_fmadd_pd(ai, xr, _mm512_fmadd_pd(ar, xi, _mm512_loadu_pd(yImag + j))));
+        }
+        axpySplitScalar(n - j, alpha, xReal + j, xImag + j, yReal + j, yImag + j);
+    }
+
+    __attribute__((target("avx512f")))
+    void axpySplitAvx512(int n, BasicComplexNum<float> alpha, const float* xReal, const float* xImag, float* yReal, float* yImag)
+    {
+        const __m512 ar = _mm512_set1_ps(alpha.getReal());
+        const __m512 ai = _mm512_set1_ps(alpha.getImag());
+        int j = 0;
+        for (; j + 16 <= n; j += 16)
+        {
+            const __m512 xr = _mm512_loadu_ps(xReal + j);
+            const __m512 xi = _mm512_loadu_ps(xImag + j);
+            _mm512_storeu_ps(yReal + j, _mm512_fnmadd_ps(ai, xi, _mm512_fmadd_ps(ar, xr, _mm512_loadu_ps(yReal + j))));
+            _mm512_storeu_ps(yImag + j, _mm512_fmadd_ps(ai, xr, _mm512_fmadd_ps(ar, xi, _mm512_loadu_ps(yImag + j))));
+        }
+        axpySplitScalar(n - j, alpha, xReal + j, xImag + j, yReal + j, yImag + j);
+    }
+
+    template <bool Conjugate>
+    __attribute__((target("avx512f")))
+    BasicComplexNum<double> dotAvx512(int n, const BasicComplexNum<double>* x, const BasicComplexNum<double>* y)
+    {
+        const double* xs = reinterpret_cast<const double*>(x);
+        const double* ys = reinterpret_cast<const double*>(y);
+        __m512d direct = _mm512_setzero_pd();
+        __m512d swapped = _mm512_setzero_pd();
+        int j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const __m512d u = _mm512_loadu_pd(xs + 2 * j);
+            const __m512d v = _mm512_loadu_pd(ys + 2 * j);
+            direct = _mm512_fmadd_pd(u, v, direct);
+            swapped = _mm512_fmadd_pd(u, swapPairs(v), swapped);
+        }
+        double d[8], s[8];
+        _mm512_storeu_pd(d, direct);
+        _mm512_storeu_pd(s, swapped);
+        return dotTail<Conjugate>(finishDot<Conjugate>(d, s, 8), j, n, x, y);
+    }
+
+    template <bool Conjugate>
+    __attribute__((target("avx512f")))
+    BasicComplexNum<float> dotAvx512(int n, const BasicComplexNum<float>* x, const BasicComplexNum<float>* y)
+    {
+        const float* xs = reinterpret_cast<const float*>(x);
+        const float* ys = reinterpret_cast<const float*>(y);
+        __m512 direct = _mm512_setzero_ps();
+        __m512 swapped = _mm512_setzero_ps();
+        int j = 0;
+        for (; j + 8 <= n; j += 8)
+        {
+            const __m512 u = _mm512_loadu_ps(xs + 2 * j);
+            const __m512 v = _mm512_loadu_ps(ys + 2 * j);
+            direct = _mm512_fmadd_ps(u, v, direct);
+            swapped = _mm512_fmadd_ps(u, swapPairs(v), swapped);
+        }
+        float d[16], s[16];
+        _mm512_storeu_ps(d, direct);
+        _mm512_storeu_ps(s, swapped);
+        return dotTail<Conjugate>(finishDot<Conjugate>(d, s, 16), j, n, x, y);
+    }
+#endif
+
+    /// @brief Vector tables per scalar type; only double and float have any.
+    template <typename T>
+    struct VectorKernels {
+        static const BasicComplexKernels<T>* find(SimdIsa)
+        {
+            return nullptr;
+        }
+    };
+
+#ifdef COMPLEX_KERNELS_X86
+    template <>
+    struct VectorKernels<double> {
+        static const BasicComplexKernels<double>* find(SimdIsa isa)
+        {
+            static const BasicComplexKernels<double> sse2 = {
+                SimdIsa::Sse2, &gemmTileSse2, &realGemmTileSse2, &axpySse2, &axpySplitSse2, &dotSse2<false>, &dotSse2<true> };
+            static const BasicComplexKernels<double> avx2 = {
+                SimdIsa::Avx2, &gemmTileAvx2, &realGemmTileAvx2, &axpyAvx2, &axpySplitAvx2, &dotAvx2<false>, &dotAvx2<true> };
+            static const BasicComplexKernels<double> avx512 = {
+                SimdIsa::Avx512, &gemmTileAvx512, &realGemmTileAvx512, &axpyAvx512, &axpySplitAvx512, &dotAvx512<false>, &dotAvx512<true> };
+            return isa == SimdIsa::Avx512 ? &avx512 : isa == SimdIsa::Avx2 ? &avx2 : isa == SimdIsa::Sse2 ? &sse2 : nullptr;
+        }
+    };
+
+    template <>
+    struct VectorKernels<float> {
+        static const BasicComplexKernels<float>* find(SimdIsa isa)
+        {
+            static const BasicComplexKernels<float> sse2 = {
+                SimdIsa::Sse2, &gemmTileSse2, &realGemmTileSse2, &axpySse2, &axpySplitSse2, &dotSse2<false>, &dotSse2<true> };
+            static const BasicComplexKernels<float> avx2 = {
+                SimdIsa::Avx2, &gemmTileAvx2, &realGemmTileAvx2, &axpyAvx2, &axpySplitAvx2, &dotAvx2<false>, &dotAvx2<true> };
+            // Float tiles are one ymm per row, so the AVX2 tiles are already full width.
+            static const BasicComplexKernels<float> avx512 = {
+                SimdIsa::Avx512, &gemmTileAvx2, &realGemmTileAvx2, &axpyAvx512, &axpySplitAvx512, &dotAvx512<false>, &dotAvx512<true> };
+            return isa == SimdIsa::Avx512 ? &avx512 : isa == SimdIsa::Avx2 ? &avx2 : isa == SimdIsa::Sse2 ? &sse2 : nullptr;
+        }
+    };
+#endif
+}
+
+SimdIsa detectSimdIsa()
+{
+    static const SimdIsa detected = [] {
+#ifdef COMPLEX_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return SimdIsa::Avx512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return SimdIsa::Avx2;
+        if (__builtin_cpu_supports("sse2"))
+            return SimdIsa::Sse2;
+#endif
+        return SimdIsa::Scalar;
+    }();
+    return detected;
+}
+
+template <typename T>
+const BasicComplexKernels<T>& BasicComplexKernels<T>::active()
+{
+    static const BasicComplexKernels<T>& kernels = forIsa(detectSimdIsa());
+    return kernels;
+}
+
+template <typename T>
+const BasicComplexKernels<T>& BasicComplexKernels<T>::forIsa(SimdIsa isa)
+{
+    static const BasicComplexKernels<T> scalar = {
+        SimdIsa::Scalar, &gemmTileScalar<T>, &realGemmTileScalar<T>, &axpyScalar<T>, &axpySplitScalar<T>, &dotScalar<T>, &dotcScalar<T> };
+
+    if (static_cast<int>(isa) > static_cast<int>(detectSimdIsa()))
+        isa = detectSimdIsa();
+    const BasicComplexKernels<T>* vector = VectorKernels<T>::find(isa);
+    return vector ? *vector : scalar;
+}
+
+template struct BasicComplexKernels<float>;
+template struct BasicComplexKernels<double>;
+template struct BasicComplexKernels<long double>;
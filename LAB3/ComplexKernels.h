@@ -0,0 +1,64 @@
+#pragma once
+#include "ComplexNum.h"
+
+/// @brief Instruction sets the complex kernels have variants for, from slowest to fastest.
+enum class SimdIsa {
+    Scalar,
+    Sse2,
+    /// @brief AVX2 together with FMA3.
+    Avx2,
+    /// @brief AVX-512F.
+    Avx512
+};
+
+/// @brief Best instruction set this CPU and OS support, read from CPUID once per process.
+/// Builds for compilers or targets without the x86 intrinsics always report Scalar.
+SimdIsa detectSimdIsa();
+
+/// @brief Dispatch table of the hand-vectorized complex (and 3M real) inner loops.
+/// One table per instruction set; active() picks the best one the first time it is asked for,
+/// so a single binary runs the widest kernels each machine has. double and float have SSE2,
+/// AVX2+FMA and AVX-512 variants, long double only the scalar one. Callers look the table up
+/// once per operation and call through the pointers in their inner loops.
+template <typename T>
+struct BasicComplexKernels
+{
+    /// @brief Shape of the GEMM micro-tile; ComplexGemm packs its slivers to match.
+    static constexpr int TILE_ROWS = 4;
+    static constexpr int TILE_COLUMNS = 4;
+
+    /// @brief Shape of the real GEMM micro-tile used by the 3M product.
+    static constexpr int REAL_TILE_ROWS = 4;
+    static constexpr int REAL_TILE_COLUMNS = 8;
+
+    SimdIsa isa;
+
+    /// @brief Product of a packed TILE_ROWS-row A sliver and a packed TILE_COLUMNS-column B sliver
+    /// over depth steps (per step: the real parts, then the imaginary parts). Overwrites the
+    /// row-major real and imag tiles.
+    void (*gemmTile)(int depth, const T* a, const T* b, T* real, T* imag);
+
+    /// @brief Real product of a packed REAL_TILE_ROWS-row sliver and a packed REAL_TILE_COLUMNS-column
+    /// sliver over depth steps. Overwrites the row-major tile c.
+    void (*realGemmTile)(int depth, const T* a, const T* b, T* c);
+
+    /// @brief y += alpha * x over n interleaved elements; the row update of elimination with -factor.
+    void (*axpy)(int n, BasicComplexNum<T> alpha, const BasicComplexNum<T>* x, BasicComplexNum<T>* y);
+
+    /// @brief y += alpha * x over n elements held in split real and imaginary planes.
+    void (*axpySplit)(int n, BasicComplexNum<T> alpha, const T* xReal, const T* xImag, T* yReal, T* yImag);
+
+    /// @brief Sum of x[i] * y[i].
+    BasicComplexNum<T> (*dot)(int n, const BasicComplexNum<T>* x, const BasicComplexNum<T>* y);
+
+    /// @brief Sum of conj(x[i]) * y[i].
+    BasicComplexNum<T> (*dotc)(int n, const BasicComplexNum<T>* x, const BasicComplexNum<T>* y);
+
+    /// @brief Table for the best instruction set of this machine, chosen on first use.
+    static const BasicComplexKernels& active();
+
+    /// @brief Table for isa, falling back to narrower ones the CPU or this scalar type lacks.
+    static const BasicComplexKernels& forIsa(SimdIsa isa);
+};
+
+using ComplexKernels = BasicComplexKernels<double>;
@@ -1,44 +1,123 @@
 #include "ComplexMatrix.h"
+#include "ComplexGemm.h"
+#include "ComplexGemv.h"
+#include "ComplexKernels.h"
 #include <iostream>
+#include <memory>
+#include <algorithm>
 
-ComplexMatrix::ComplexMatrix() : matrix(nullptr), rows(0), columns(0) {}
+template <typename T>
+int BasicComplexMatrix<T>::strideFor(int columns, StorageLayout layout)
+{
+    const std::size_t elementSize = layout == StorageLayout::Split ? sizeof(T) : sizeof(BasicComplexNum<T>);
+    const int perLine = static_cast<int>(ALIGNMENT / elementSize);
+    return perLine > 0 ? (columns + perLine - 1) / perLine * perLine : columns;
+}
 
-ComplexMatrix::ComplexMatrix(unsigned int rows, unsigned int columns)
+template <typename T>
+void BasicComplexMatrix<T>::allocate(int rows, int columns, StorageLayout layout)
 {
-    matrix = new ComplexNum * [rows];
-    for (int i = 0; i < rows; i++)
+    this->rows = rows;
+    this->columns = columns;
+    this->layout = layout;
+    this->stride = strideFor(columns, layout);
+    this->hermitian = false;
+    matrix = nullptr;
+    realPlane = nullptr;
+    imagPlane = nullptr;
+    allocator = nullptr;
+
+    std::size_t count = static_cast<std::size_t>(this->rows) * this->stride;
+    if (count == 0)
+        return;
+
+    allocator = &MatrixAllocator::current();
+    const std::size_t bytes = storageBytes();
+    void* block = allocator->allocate(bytes);
+    // Fresh mappings are already zero; skipping the fill leaves first touch to the threads that use the data.
+    const bool zeroed = allocator->zeroFilled(bytes);
+    if (layout == StorageLayout::Split)
     {
-        matrix[i] = new ComplexNum[columns];
+        realPlane = static_cast<T*>(block);
+        imagPlane = realPlane + count;
+        if (!zeroed)
+            std::fill_n(realPlane, 2 * count, T());
+    }
+    else
+    {
+        matrix = static_cast<BasicComplexNum<T>*>(block);
+        if (!zeroed)
+            std::uninitialized_fill_n(matrix, count, BasicComplexNum<T>());
     }
-    this->columns = columns;
-    this->rows = rows;
 }
 
-ComplexMatrix::ComplexMatrix(const ComplexMatrix& copy)
+template <typename T>
+std::size_t BasicComplexMatrix<T>::storageBytes() const
 {
-    this->rows = copy.rows;
-    this->columns = copy.columns;
-    matrix = new ComplexNum * [rows];
-    for (int i = 0; i < this->rows; i++)
-        this->matrix[i] = new ComplexNum[copy.columns];
-
-    for (int i = 0; i < copy.rows; i++)
-        for (int j = 0; j < copy.columns; j++)
-            this->matrix[i][j] = copy.matrix[i][j];
+    std::size_t count = static_cast<std::size_t>(rows) * stride;
+    return layout == StorageLayout::Split ? 2 * count * sizeof(T) : count * sizeof(BasicComplexNum<T>);
 }
 
-ComplexMatrix::~ComplexMatrix()
+template <typename T>
+void BasicComplexMatrix<T>::release()
 {
-    for (int i = 0; i < rows; i++)
-    {
-        delete[] matrix[i];
-    }
-    delete[] matrix;
+    if (matrix)
+        allocator->deallocate(matrix, storageBytes());
+    if (realPlane)
+        allocator->deallocate(realPlane, storageBytes());
+    matrix = nullptr;
+    realPlane = nullptr;
+    imagPlane = nullptr;
+    allocator = nullptr;
     this->rows = 0;
     this->columns = 0;
+    this->stride = 0;
 }
 
-void ComplexMatrix::auto_gen(int min_real, int max_real, int min_imag, int max_imag)
+template <typename T>
+BasicComplexMatrix<T>::BasicComplexMatrix()
+    : matrix(nullptr), realPlane(nullptr), imagPlane(nullptr), allocator(nullptr), columns(0), rows(0), stride(0), layout(StorageLayout::Interleaved), hermitian(false) {}
+
+template <typename T>
+BasicComplexMatrix<T>::BasicComplexMatrix(unsigned int rows, unsigned int columns, StorageLayout layout)
+{
+    allocate(rows, columns, layout);
+}
+
+template <typename T>
+BasicComplexMatrix<T>::BasicComplexMatrix(const BasicComplexMatrix<T>& copy)
+{
+    allocate(copy.rows, copy.columns, copy.layout);
+    hermitian = copy.hermitian;
+    std::size_t count = static_cast<std::size_t>(rows) * stride;
+    if (layout == StorageLayout::Split)
+        std::copy_n(copy.realPlane, 2 * count, realPlane);
+    else
+        std::copy_n(copy.matrix, count, matrix);
+}
+
+template <typename T>
+BasicComplexMatrix<T>::BasicComplexMatrix(BasicComplexMatrix<T>&& other) noexcept
+    : matrix(other.matrix), realPlane(other.realPlane), imagPlane(other.imagPlane), allocator(other.allocator),
+    columns(other.columns), rows(other.rows), stride(other.stride), layout(other.layout), hermitian(other.hermitian)
+{
+    other.matrix = nullptr;
+    other.realPlane = nullptr;
+    other.imagPlane = nullptr;
+    other.allocator = nullptr;
+    other.rows = 0;
+    other.columns = 0;
+    other.stride = 0;
+}
+
+template <typename T>
+BasicComplexMatrix<T>::~BasicComplexMatrix()
+{
+    release();
+}
+
+template <typename T>
+void BasicComplexMatrix<T>::auto_gen(int min_real, int max_real, int min_imag, int max_imag)
 {
     int span_real = abs(max_real - min_real) + 1;
     int span_imag = abs(max_imag - min_imag) + 1;
@@ -46,97 +125,330 @@ void ComplexMatrix::auto_gen(int min_real, int max_real, int min_imag, int max_i
     {
         for (int j = 0; j < columns; j++)
         {
-            matrix[i][j] = ComplexNum(rand() % span_real + min_real, rand() % span_imag + min_imag);
+            T real = rand() % span_real + min_real;
+            T imag = rand() % span_imag + min_imag;
+            set(i, j, real, imag);
         }
     }
 }
 
-int ComplexMatrix::getColumns()
+template <typename T>
+int BasicComplexMatrix<T>::getColumns() const
 {
     return columns;
 }
 
-int ComplexMatrix::getRows()
+template <typename T>
+int BasicComplexMatrix<T>::getRows() const
 {
     return rows;
 }
 
-void ComplexMatrix::set(unsigned int i, unsigned int j, double real, double imag)
+template <typename T>
+int BasicComplexMatrix<T>::getStride() const
+{
+    return stride;
+}
+
+template <typename T>
+StorageLayout BasicComplexMatrix<T>::getLayout() const
+{
+    return layout;
+}
+
+template <typename T>
+bool BasicComplexMatrix<T>::isSplit() const
+{
+    return layout == StorageLayout::Split;
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicComplexMatrix<T>::toLayout(StorageLayout target) const
+{
+    if (target == layout)
+        return *this;
+
+    BasicComplexMatrix<T> result(rows, columns, target);
+    result.hermitian = hermitian;
+    for (int i = 0; i < rows; i++)
+    {
+        if (target == StorageLayout::Split)
+        {
+            const BasicComplexNum<T>* src = row(i);
+            T* re = result.realRow(i);
+            T* im = result.imagRow(i);
+            for (int j = 0; j < columns; j++)
+            {
+                BasicComplexNum<T> value = src[j];
+                re[j] = value.getReal();
+                im[j] = value.getImag();
+            }
+        }
+        else
+        {
+            const T* re = realRow(i);
+            const T* im = imagRow(i);
+            BasicComplexNum<T>* dst = result.row(i);
+            for (int j = 0; j < columns; j++)
+                dst[j] = BasicComplexNum<T>(re[j], im[j]);
+        }
+    }
+    return result;
+}
+
+template <typename T>
+bool BasicComplexMatrix<T>::isHermitian() const
+{
+    return hermitian;
+}
+
+template <typename T>
+void BasicComplexMatrix<T>::setHermitian(bool hermitian)
 {
+    this->hermitian = hermitian;
+}
+
+template <typename T>
+void BasicComplexMatrix<T>::dropHermitian()
+{
+    // Written only when set, so threads filling disjoint parts of a fresh matrix never race on it.
+    if (hermitian)
+        hermitian = false;
+}
+
+template <typename T>
+BasicComplexNum<T>* BasicComplexMatrix<T>::data()
+{
+    assert(layout == StorageLayout::Interleaved);
+    return matrix;
+}
+
+template <typename T>
+const BasicComplexNum<T>* BasicComplexMatrix<T>::data() const
+{
+    assert(layout == StorageLayout::Interleaved);
+    return matrix;
+}
+
+template <typename T>
+BasicComplexNum<T>* BasicComplexMatrix<T>::row(int i)
+{
+    assert(layout == StorageLayout::Interleaved);
+    assert(i >= 0 && i < rows);
+    return matrix + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+const BasicComplexNum<T>* BasicComplexMatrix<T>::row(int i) const
+{
+    assert(layout == StorageLayout::Interleaved);
+    assert(i >= 0 && i < rows);
+    return matrix + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+T* BasicComplexMatrix<T>::realData()
+{
+    assert(layout == StorageLayout::Split);
+    return realPlane;
+}
+
+template <typename T>
+const T* BasicComplexMatrix<T>::realData() const
+{
+    assert(layout == StorageLayout::Split);
+    return realPlane;
+}
+
+template <typename T>
+T* BasicComplexMatrix<T>::imagData()
+{
+    assert(layout == StorageLayout::Split);
+    return imagPlane;
+}
+
+template <typename T>
+const T* BasicComplexMatrix<T>::imagData() const
+{
+    assert(layout == StorageLayout::Split);
+    return imagPlane;
+}
+
+template <typename T>
+T* BasicComplexMatrix<T>::realRow(int i)
+{
+    assert(layout == StorageLayout::Split);
+    assert(i >= 0 && i < rows);
+    return realPlane + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+const T* BasicComplexMatrix<T>::realRow(int i) const
+{
+    assert(layout == StorageLayout::Split);
+    assert(i >= 0 && i < rows);
+    return realPlane + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+T* BasicComplexMatrix<T>::imagRow(int i)
+{
+    assert(layout == StorageLayout::Split);
+    assert(i >= 0 && i < rows);
+    return imagPlane + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+const T* BasicComplexMatrix<T>::imagRow(int i) const
+{
+    assert(layout == StorageLayout::Split);
+    assert(i >= 0 && i < rows);
+    return imagPlane + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+void BasicComplexMatrix<T>::set(unsigned int i, unsigned int j, T real, T imag)
+{
+    dropHermitian();
     assert(i < rows);
     assert(j < columns);
-    matrix[i][j] = ComplexNum(real, imag);
+    std::size_t index = static_cast<std::size_t>(i) * stride + j;
+    if (layout == StorageLayout::Split)
+    {
+        realPlane[index] = real;
+        imagPlane[index] = imag;
+    }
+    else
+        matrix[index] = BasicComplexNum<T>(real, imag);
 }
 
-void ComplexMatrix::set(unsigned int i, unsigned int j, ComplexNum num)
+template <typename T>
+void BasicComplexMatrix<T>::set(unsigned int i, unsigned int j, BasicComplexNum<T> num)
 {
+    dropHermitian();
     assert(i < rows);
     assert(j < columns);
-    matrix[i][j] = num;
+    std::size_t index = static_cast<std::size_t>(i) * stride + j;
+    if (layout == StorageLayout::Split)
+    {
+        realPlane[index] = num.getReal();
+        imagPlane[index] = num.getImag();
+    }
+    else
+        matrix[index] = num;
 }
 
-void ComplexMatrix::setColumn(int j, ComplexNum* num)
+template <typename T>
+void BasicComplexMatrix<T>::setColumn(int j, BasicComplexNum<T>* num)
 {
     for (int i = 0; i < this->rows; i++)
         this->set(i, j, num[i]);
 }
 
-void ComplexMatrix::setRow(int i, ComplexNum* num)
+template <typename T>
+void BasicComplexMatrix<T>::setRow(int i, BasicComplexNum<T>* num)
 {
     for (int j = 0; j < this->columns; j++)
         this->set(i, j, num[j]);
 }
 
-ComplexNum ComplexMatrix::get(unsigned int i, unsigned int j)
+template <typename T>
+BasicComplexNum<T> BasicComplexMatrix<T>::get(unsigned int i, unsigned int j) const
 {
     assert(i < rows);
     assert(j < columns);
-    return matrix[i][j];
+    std::size_t index = static_cast<std::size_t>(i) * stride + j;
+    if (layout == StorageLayout::Split)
+        return BasicComplexNum<T>(realPlane[index], imagPlane[index]);
+    return matrix[index];
 }
 
-void ComplexMatrix::print()
+template <typename T>
+void BasicComplexMatrix<T>::print()
 {
     for (int i = 0; i < rows; i++)
     {
         for (int j = 0; j < columns; j++)
         {
-            std::cout << matrix[i][j] << "\t";
+            std::cout << get(i, j) << "\t";
         }
         std::cout << '\n';
     }
     std::cout << "\n\n";
 }
 
-void ComplexMatrix::swapRows(int row1, int row2)
+template <typename T>
+void BasicComplexMatrix<T>::swapRows(int row1, int row2)
 {
+    dropHermitian();
     assert(row1 >= 0 && row1 < rows);
-    assert(row2 >= 0 && row2 < columns);
+    assert(row2 >= 0 && row2 < rows);
 
-    int col = this->getColumns();
-    for (int i = 0; i < col; i++)
+    if (layout == StorageLayout::Split)
     {
-        ComplexNum temp = matrix[row1][i];
-        matrix[row1][i] = matrix[row2][i];
-        matrix[row2][i] = temp;
+        std::swap_ranges(realRow(row1), realRow(row1) + columns, realRow(row2));
+        std::swap_ranges(imagRow(row1), imagRow(row1) + columns, imagRow(row2));
     }
+    else
+        std::swap_ranges(row(row1), row(row1) + columns, row(row2));
 }
 
-int ComplexMatrix::getRank()
+template <typename T>
+void BasicComplexMatrix<T>::subtractRowMultiple(int target, int source, BasicComplexNum<T> factor)
 {
-    ComplexMatrix complexMatrix = *this;
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    const BasicComplexNum<T> alpha = BasicComplexNum<T>() - factor;
+    dropHermitian();
+    if (layout == StorageLayout::Split)
+        kernels.axpySplit(columns, alpha, realRow(source), imagRow(source), realRow(target), imagRow(target));
+    else
+        kernels.axpy(columns, alpha, row(source), row(target));
+}
+
+template <typename T>
+void BasicComplexMatrix<T>::divideRow(int i, BasicComplexNum<T> divisor)
+{
+    dropHermitian();
+    if (layout == StorageLayout::Split)
+    {
+        const T dr = divisor.getReal();
+        const T di = divisor.getImag();
+        const T div = dr * dr + di * di;
+        T* re = realRow(i);
+        T* im = imagRow(i);
+        for (int k = 0; k < columns; k++)
+        {
+            const T r = (re[k] * dr + im[k] * di) / div;
+            const T m = (im[k] * dr - re[k] * di) / div;
+            re[k] = r;
+            im[k] = m;
+        }
+    }
+    else
+    {
+        BasicComplexNum<T>* values = row(i);
+        for (int k = 0; k < columns; k++)
+            values[k] = values[k] / divisor;
+    }
+}
+
+template <typename T>
+int BasicComplexMatrix<T>::getRank()
+{
+    BasicComplexMatrix<T> complexMatrix = *this;
 
     int R = complexMatrix.getRows();
     int rank = complexMatrix.getColumns();
 
     for (int row = 0; row < rank; row++)
     {
-        if (complexMatrix.get(row, row) != ComplexNum())
+        if (complexMatrix.get(row, row) != BasicComplexNum<T>())
         {
             for (int col = 0; col < R; col++)
             {
                 if (col != row)
                 {
-                    ComplexNum mult = complexMatrix.get(col, row) / complexMatrix.get(row, row);
+                    BasicComplexNum<T> mult = complexMatrix.get(col, row) / complexMatrix.get(row, row);
                     for (int i = 0; i < rank; i++)
                         complexMatrix.set(col, i,
                             complexMatrix.get(col, i) - mult * complexMatrix.get(row, i));
@@ -149,7 +461,7 @@ int ComplexMatrix::getRank()
 
             for (int i = row + 1; i < R; i++)
             {
-                if (complexMatrix.get(i, row) != ComplexNum())
+                if (complexMatrix.get(i, row) != BasicComplexNum<T>())
                 {
                     complexMatrix.swapRows(row, i);
                     reduce = false;
@@ -170,68 +482,188 @@ int ComplexMatrix::getRank()
     return rank;
 }
 
-ComplexMatrix& ComplexMatrix::operator =(const ComplexMatrix& copy)
+template <typename T>
+BasicComplexMatrix<T>& BasicComplexMatrix<T>::operator =(const BasicComplexMatrix<T>& copy)
 {
     if (this != &copy)
     {
-        for (int i = 0; i < this->rows; i++)
+        if (this->rows != copy.rows || this->columns != copy.columns || this->layout != copy.layout)
         {
-            delete[] matrix[i];
+            release();
+            allocate(copy.rows, copy.columns, copy.layout);
         }
-        delete[] matrix;
+        hermitian = copy.hermitian;
+        std::size_t count = static_cast<std::size_t>(rows) * stride;
+        if (layout == StorageLayout::Split)
+            std::copy_n(copy.realPlane, 2 * count, realPlane);
+        else
+            std::copy_n(copy.matrix, count, matrix);
+    }
 
-        matrix = new ComplexNum * [copy.rows];
-        this->rows = copy.rows;
-        this->columns = copy.columns;
-        for (int i = 0; i < copy.rows; i++)
-            this->matrix[i] = new ComplexNum[copy.columns];
+    return *this;
+}
 
-        for (int i = 0; i < copy.rows; i++)
-            for (int j = 0; j < copy.columns; j++)
-                this->matrix[i][j] = copy.matrix[i][j];
+template <typename T>
+BasicComplexMatrix<T>& BasicComplexMatrix<T>::operator =(BasicComplexMatrix<T>&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        std::swap(matrix, other.matrix);
+        std::swap(realPlane, other.realPlane);
+        std::swap(imagPlane, other.imagPlane);
+        std::swap(allocator, other.allocator);
+        std::swap(rows, other.rows);
+        std::swap(columns, other.columns);
+        std::swap(stride, other.stride);
+        std::swap(layout, other.layout);
+        std::swap(hermitian, other.hermitian);
     }
 
     return *this;
 }
 
-ComplexMatrix ComplexMatrix::operator +(const ComplexMatrix& other) const
+template <typename T>
+BasicComplexMatrix<T>& BasicComplexMatrix<T>::operator +=(const BasicComplexMatrix<T>& other)
+{
+    addTo(other, *this);
+    return *this;
+}
+
+template <typename T>
+BasicComplexMatrix<T>& BasicComplexMatrix<T>::operator -=(const BasicComplexMatrix<T>& other)
+{
+    subtractTo(other, *this);
+    return *this;
+}
+
+template <typename T>
+void BasicComplexMatrix<T>::addTo(const BasicComplexMatrix<T>& other, BasicComplexMatrix<T>& dst) const
 {
     assert(this->rows == other.rows && this->columns == other.columns);
 
-    ComplexMatrix result(this->rows, this->columns);
-    for (int i = 0; i < this->rows; i++)
+    if (&dst != this && &dst != &other && (dst.rows != rows || dst.columns != columns))
+        dst = BasicComplexMatrix<T>(rows, columns, layout);
+    // Sums and differences of Hermitian matrices stay Hermitian.
+    const bool result = hermitian && other.hermitian;
+
+    if (layout == StorageLayout::Split && other.layout == StorageLayout::Split && dst.layout == StorageLayout::Split)
     {
-        for (int j = 0; j < this->columns; j++)
+        for (int i = 0; i < rows; i++)
         {
-            result.set(i, j, this->matrix[i][j] + other.matrix[i][j]);
+            const T* ar = realRow(i);
+            const T* ai = imagRow(i);
+            const T* br = other.realRow(i);
+            const T* bi = other.imagRow(i);
+            T* cr = dst.realRow(i);
+            T* ci = dst.imagRow(i);
+            for (int j = 0; j < columns; j++)
+            {
+                cr[j] = ar[j] + br[j];
+                ci[j] = ai[j] + bi[j];
+            }
         }
     }
-
-    return result;
+    else if (layout == StorageLayout::Interleaved && other.layout == StorageLayout::Interleaved && dst.layout == StorageLayout::Interleaved)
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            const BasicComplexNum<T>* lhs = row(i);
+            const BasicComplexNum<T>* rhs = other.row(i);
+            BasicComplexNum<T>* out = dst.row(i);
+            for (int j = 0; j < columns; j++)
+                out[j] = lhs[j] + rhs[j];
+        }
+    }
+    else
+    {
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < columns; j++)
+                dst.set(i, j, get(i, j) + other.get(i, j));
+    }
+    dst.hermitian = result;
 }
 
-ComplexMatrix ComplexMatrix::operator *(const ComplexMatrix& other) const
+template <typename T>
+void BasicComplexMatrix<T>::subtractTo(const BasicComplexMatrix<T>& other, BasicComplexMatrix<T>& dst) const
 {
-    assert(this->columns == other.rows);
+    assert(this->rows == other.rows && this->columns == other.columns);
 
-    ComplexMatrix result(this->rows, other.columns);
-    for (int i = 0; i < this->rows; i++)
+    if (&dst != this && &dst != &other && (dst.rows != rows || dst.columns != columns))
+        dst = BasicComplexMatrix<T>(rows, columns, layout);
+    // Sums and differences of Hermitian matrices stay Hermitian.
+    const bool result = hermitian && other.hermitian;
+
+    if (layout == StorageLayout::Split && other.layout == StorageLayout::Split && dst.layout == StorageLayout::Split)
     {
-        for (int j = 0; j < other.columns; j++)
+        for (int i = 0; i < rows; i++)
         {
-            ComplexNum sum = ComplexNum();
-            for (int k = 0; k < this->columns; k++)
+            const T* ar = realRow(i);
+            const T* ai = imagRow(i);
+            const T* br = other.realRow(i);
+            const T* bi = other.imagRow(i);
+            T* cr = dst.realRow(i);
+            T* ci = dst.imagRow(i);
+            for (int j = 0; j < columns; j++)
             {
-                sum = sum + (this->matrix[i][k] * other.matrix[k][j]);
+                cr[j] = ar[j] - br[j];
+                ci[j] = ai[j] - bi[j];
             }
-            result.set(i, j, sum);
         }
     }
+    else if (layout == StorageLayout::Interleaved && other.layout == StorageLayout::Interleaved && dst.layout == StorageLayout::Interleaved)
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            const BasicComplexNum<T>* lhs = row(i);
+            const BasicComplexNum<T>* rhs = other.row(i);
+            BasicComplexNum<T>* out = dst.row(i);
+            for (int j = 0; j < columns; j++)
+                out[j] = lhs[j] - rhs[j];
+        }
+    }
+    else
+    {
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < columns; j++)
+                dst.set(i, j, get(i, j) - other.get(i, j));
+    }
+    dst.hermitian = result;
+}
 
+template <typename T>
+BasicComplexMatrix<T> BasicComplexMatrix<T>::operator *(const BasicComplexMatrix<T>& other) const
+{
+    return multiply(other, MultiplyMode::Classic);
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicComplexMatrix<T>::multiply(const BasicComplexMatrix<T>& other, MultiplyMode mode) const
+{
+    assert(this->columns == other.rows);
+
+    // The GEMM packs either layout into the same panels, so mixed operands need no conversion.
+    // Views are mutable handles, but the GEMM only reads through its operands.
+    BasicComplexMatrix<T> result(this->rows, other.columns, this->layout);
+    BasicComplexMatrixView<T> lhs(const_cast<BasicComplexMatrix<T>&>(*this));
+    BasicComplexMatrixView<T> rhs(const_cast<BasicComplexMatrix<T>&>(other));
+    BasicComplexGemm<T>::multiply(lhs, rhs, BasicComplexMatrixView<T>(result), true, mode);
+    return result;
+}
+
+template <typename T>
+std::vector<BasicComplexNum<T>> BasicComplexMatrix<T>::operator *(const std::vector<BasicComplexNum<T>>& vector) const
+{
+    assert(static_cast<int>(vector.size()) == this->columns);
+
+    std::vector<BasicComplexNum<T>> result(this->rows);
+    BasicComplexMatrixView<T> view(const_cast<BasicComplexMatrix<T>&>(*this));
+    BasicComplexGemv<T>::multiply(GemvOperation::NoTranspose, BasicComplexNum<T>(1, 0), view, vector.data(), BasicComplexNum<T>(), result.data());
     return result;
 }
 
-bool ComplexMatrix::operator ==(const ComplexMatrix& other) const
+template <typename T>
+bool BasicComplexMatrix<T>::operator ==(const BasicComplexMatrix<T>& other) const
 {
     if (this->rows != other.rows || this->columns != other.columns)
         return false;
@@ -240,7 +672,7 @@ bool ComplexMatrix::operator ==(const ComplexMatrix& other) const
     {
         for (int j = 0; j < this->columns; j++)
         {
-            if (this->matrix[i][j] != other.matrix[i][j])
+            if (this->get(i, j) != other.get(i, j))
                 return false;
         }
     }
@@ -248,18 +680,20 @@ bool ComplexMatrix::operator ==(const ComplexMatrix& other) const
     return true;
 }
 
-ComplexMatrix ComplexMatrix::operator -(const ComplexMatrix& other) const
+template <typename T>
+MatrixOperand<T> toExpression(const BasicComplexMatrix<T>& matrix)
 {
-    assert(this->rows == other.rows && this->columns == other.columns);
+    if (matrix.isSplit())
+        return MatrixOperand<T>(nullptr, matrix.realData(), matrix.imagData(), matrix.getRows(), matrix.getColumns(),
+            matrix.getRows(), matrix.getColumns(), matrix.getStride(), StorageLayout::Split);
+    return MatrixOperand<T>(matrix.data(), nullptr, nullptr, matrix.getRows(), matrix.getColumns(),
+        matrix.getRows(), matrix.getColumns(), matrix.getStride(), StorageLayout::Interleaved);
+}
 
-    ComplexMatrix result(this->rows, this->columns);
-    for (int i = 0; i < this->rows; i++)
-    {
-        for (int j = 0; j < this->columns; j++)
-        {
-            result.set(i, j, this->matrix[i][j] - other.matrix[i][j]);
-        }
-    }
+template class BasicComplexMatrix<float>;
+template class BasicComplexMatrix<double>;
+template class BasicComplexMatrix<long double>;
 
-    return result;
-}
+template MatrixOperand<float> toExpression(const BasicComplexMatrix<float>& matrix);
+template MatrixOperand<double> toExpression(const BasicComplexMatrix<double>& matrix);
+template MatrixOperand<long double> toExpression(const BasicComplexMatrix<long double>& matrix);
@@ -1,61 +1,222 @@
 #pragma once
 #include "ComplexNum.h"
+#include "StorageLayout.h"
+#include "MultiplyMode.h"
+#include "MatrixExpression.h"
+#include "MatrixAllocator.h"
 #include <cassert>
+#include <cstddef>
+#include <vector>
 
-class ComplexMatrix
+/// @brief Dense complex matrix over the scalar type T (float, double or long double).
+template <typename T>
+class BasicComplexMatrix
 {
 private:
-    ComplexNum** matrix; 
+    BasicComplexNum<T>* matrix; 
+    T* realPlane; 
+    T* imagPlane; 
+    MatrixAllocator* allocator; 
     int columns; 
     int rows; 
+    int stride; 
+    StorageLayout layout; 
+    bool hermitian;
+
+    void allocate(int rows, int columns, StorageLayout layout);
+
+    void release();
+
+    /// @brief Bytes of the current buffer, as passed to the allocator.
+    std::size_t storageBytes() const;
+
+    /// @brief Clears the Hermitian flag ahead of a write through the matrix's own members.
+    void dropHermitian();
+
+    template <typename E>
+    void evaluate(const MatrixExpression<E>& expr);
+
 public:
+    using Scalar = T;
 
-    ComplexMatrix();    
+    static constexpr std::size_t ALIGNMENT = MatrixAllocator::ALIGNMENT;
 
+    /// @brief Row stride used for a matrix of the given width: columns rounded up to a whole cache line.
+    static int strideFor(int columns, StorageLayout layout);
 
-    ComplexMatrix(unsigned int rows, unsigned int columns);
+    BasicComplexMatrix();    
 
-    ComplexMatrix(const ComplexMatrix& copy);
 
-    ~ComplexMatrix();
+    BasicComplexMatrix(unsigned int rows, unsigned int columns, StorageLayout layout = StorageLayout::Interleaved);
+
+    BasicComplexMatrix(const BasicComplexMatrix& copy);
+
+    BasicComplexMatrix(BasicComplexMatrix&& other) noexcept;
+
+    /// @brief Materializes a lazy expression such as a + b - c in a single pass.
+    template <typename E>
+    BasicComplexMatrix(const MatrixExpression<E>& expr);
+
+    ~BasicComplexMatrix();
 
 
     void auto_gen(int min_real, int max_real, int min_imag, int max_imag);
 
 
-    int getColumns();
+    int getColumns() const;
+
+
+    int getRows() const;
+
+    /// @brief Leading dimension: number of elements between the starts of two consecutive rows.
+    int getStride() const;
+
+    StorageLayout getLayout() const;
+
+    bool isSplit() const;
+
+    /// @brief Whether the matrix is declared Hermitian (A = A^H), as ComplexHerk results are.
+    /// The flag is a promise, not a check: copies, moves and toLayout keep it, as do addTo and
+    /// subtractTo of two flagged matrices; other writes through the matrix's own members drop it,
+    /// and writes through views or raw rows leave it to the caller.
+    /// MatrixInverseFactory inverts flagged matrices by Cholesky once it has checked that they
+    /// equal their conjugate transpose and are positive definite.
+    bool isHermitian() const;
+
+    void setHermitian(bool hermitian);
+
+    /// @brief Returns a copy of the matrix stored in the requested layout.
+    BasicComplexMatrix toLayout(StorageLayout layout) const;
+
+    BasicComplexNum<T>* data();
+
+    const BasicComplexNum<T>* data() const;
+
+    BasicComplexNum<T>* row(int i);
+
+    const BasicComplexNum<T>* row(int i) const;
+
+    T* realData();
+
+    const T* realData() const;
 
+    T* imagData();
 
-    int getRows();
+    const T* imagData() const;
 
+    T* realRow(int i);
 
-    void set(unsigned int i, unsigned int j, double real, double imag);
+    const T* realRow(int i) const;
 
+    T* imagRow(int i);
 
-    void set(unsigned int i, unsigned int j, ComplexNum num);
+    const T* imagRow(int i) const;
 
 
-    void setColumn(int j, ComplexNum* num);
+    void set(unsigned int i, unsigned int j, T real, T imag);
 
-    void setRow(int i, ComplexNum* num);
 
-    ComplexNum get(unsigned int i, unsigned int j);
+    void set(unsigned int i, unsigned int j, BasicComplexNum<T> num);
+
+
+    void setColumn(int j, BasicComplexNum<T>* num);
+
+    void setRow(int i, BasicComplexNum<T>* num);
+
+    BasicComplexNum<T> get(unsigned int i, unsigned int j) const;
 
     void print();
 
 
     void swapRows(int row1, int row2);
 
+    /// @brief Row update used by elimination: row(target) -= row(source) * factor.
+    void subtractRowMultiple(int target, int source, BasicComplexNum<T> factor);
+
+    /// @brief Divides every element of row i by divisor.
+    void divideRow(int i, BasicComplexNum<T> divisor);
+
     int getRank();
 
 
-    ComplexMatrix& operator =(const ComplexMatrix& copy);
+    BasicComplexMatrix& operator =(const BasicComplexMatrix& copy);
+
+    BasicComplexMatrix& operator =(BasicComplexMatrix&& other) noexcept;
+
+    BasicComplexMatrix& operator +=(const BasicComplexMatrix& other);
+
+    BasicComplexMatrix& operator -=(const BasicComplexMatrix& other);
+
+    template <typename E>
+    BasicComplexMatrix& operator =(const MatrixExpression<E>& expr);
+
+    template <typename E>
+    BasicComplexMatrix& operator +=(const MatrixExpression<E>& expr);
+
+    template <typename E>
+    BasicComplexMatrix& operator -=(const MatrixExpression<E>& expr);
 
-    ComplexMatrix operator +(const ComplexMatrix& other) const;
+    /// @brief Writes *this + other into dst, reusing dst's buffer when it already has the right shape.
+    void addTo(const BasicComplexMatrix& other, BasicComplexMatrix& dst) const;
 
-    ComplexMatrix operator *(const ComplexMatrix& other) const;
+    /// @brief Writes *this - other into dst, reusing dst's buffer when it already has the right shape.
+    void subtractTo(const BasicComplexMatrix& other, BasicComplexMatrix& dst) const;
 
-    bool operator ==(const ComplexMatrix& other) const;
+    BasicComplexMatrix operator *(const BasicComplexMatrix& other) const;
 
-    ComplexMatrix operator -(const ComplexMatrix& other) const;
+    /// @brief *this * other with the product formed as mode says; operator* is the Classic case.
+    BasicComplexMatrix multiply(const BasicComplexMatrix& other, MultiplyMode mode) const;
+
+    /// @brief Matrix-vector product; vector needs one element per column. Runs on ComplexGemv.
+    std::vector<BasicComplexNum<T>> operator *(const std::vector<BasicComplexNum<T>>& vector) const;
+
+    bool operator ==(const BasicComplexMatrix& other) const;
 };
+
+template <typename T>
+template <typename E>
+void BasicComplexMatrix<T>::evaluate(const MatrixExpression<E>& expr)
+{
+    dropHermitian();
+    evaluateExpression(*this, expr.self(), rows, columns);
+}
+
+template <typename T>
+template <typename E>
+BasicComplexMatrix<T>::BasicComplexMatrix(const MatrixExpression<E>& expr)
+{
+    allocate(expr.getRows(), expr.getColumns(), expr.getLayout());
+    evaluate(expr);
+}
+
+template <typename T>
+template <typename E>
+BasicComplexMatrix<T>& BasicComplexMatrix<T>::operator =(const MatrixExpression<E>& expr)
+{
+    if (rows != expr.getRows() || columns != expr.getColumns())
+    {
+        StorageLayout target = matrix || realPlane ? layout : expr.getLayout();
+        release();
+        allocate(expr.getRows(), expr.getColumns(), target);
+    }
+    evaluate(expr);
+    return *this;
+}
+
+template <typename T>
+template <typename E>
+BasicComplexMatrix<T>& BasicComplexMatrix<T>::operator +=(const MatrixExpression<E>& expr)
+{
+    return *this = *this + expr.self();
+}
+
+template <typename T>
+template <typename E>
+BasicComplexMatrix<T>& BasicComplexMatrix<T>::operator -=(const MatrixExpression<E>& expr)
+{
+    return *this = *this - expr.self();
+}
+
+using ComplexMatrixF = BasicComplexMatrix<float>;
+using ComplexMatrix = BasicComplexMatrix<double>;
+using ComplexMatrixL = BasicComplexMatrix<long double>;
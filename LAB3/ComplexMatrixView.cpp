@@ -0,0 +1,265 @@
+#include "ComplexMatrixView.h"
+#include "ComplexGemm.h"
+#include <algorithm>
+
+namespace {
+    template <typename T>
+    bool allSplit(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, const BasicComplexMatrixView<T>& c)
+    {
+        return a.getLayout() == StorageLayout::Split && b.getLayout() == StorageLayout::Split && c.getLayout() == StorageLayout::Split;
+    }
+
+    template <typename T>
+    bool allInterleaved(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, const BasicComplexMatrixView<T>& c)
+    {
+        return a.getLayout() == StorageLayout::Interleaved && b.getLayout() == StorageLayout::Interleaved && c.getLayout() == StorageLayout::Interleaved;
+    }
+
+    template <typename T, typename ComplexOp, typename RealOp>
+    void elementwise(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T>& dst, ComplexOp complexOp, RealOp realOp)
+    {
+        assert(a.getRows() == dst.getRows() && a.getColumns() == dst.getColumns());
+        assert(b.getRows() == dst.getRows() && b.getColumns() == dst.getColumns());
+
+        const bool split = allSplit(a, b, dst);
+        const bool interleaved = allInterleaved(a, b, dst);
+
+        for (int i = 0; i < dst.getValidRows(); i++)
+        {
+            int backedA = i < a.getValidRows() ? a.getValidColumns() : 0;
+            int backedB = i < b.getValidRows() ? b.getValidColumns() : 0;
+            int fast = std::min(std::min(backedA, backedB), dst.getValidColumns());
+            if (!split && !interleaved)
+                fast = 0;
+
+            if (split && fast > 0)
+            {
+                const T* ar = a.realRow(i);
+                const T* ai = a.imagRow(i);
+                const T* br = b.realRow(i);
+                const T* bi = b.imagRow(i);
+                T* cr = dst.realRow(i);
+                T* ci = dst.imagRow(i);
+                for (int j = 0; j < fast; j++)
+                {
+                    cr[j] = realOp(ar[j], br[j]);
+                    ci[j] = realOp(ai[j], bi[j]);
+                }
+            }
+            else if (interleaved && fast > 0)
+            {
+                const BasicComplexNum<T>* lhs = a.row(i);
+                const BasicComplexNum<T>* rhs = b.row(i);
+                BasicComplexNum<T>* out = dst.row(i);
+                for (int j = 0; j < fast; j++)
+                    out[j] = complexOp(lhs[j], rhs[j]);
+            }
+
+            for (int j = fast; j < dst.getValidColumns(); j++)
+                dst.set(i, j, complexOp(a.get(i, j), b.get(i, j)));
+        }
+    }
+}
+
+template <typename T>
+BasicComplexMatrixView<T>::BasicComplexMatrixView()
+    : base(nullptr), realBase(nullptr), imagBase(nullptr), rows(0), columns(0),
+    validRows(0), validColumns(0), stride(0), layout(StorageLayout::Interleaved) {}
+
+template <typename T>
+BasicComplexMatrixView<T>::BasicComplexMatrixView(BasicComplexMatrix<T>& parent)
+    : BasicComplexMatrixView<T>(parent, 0, 0, parent.getRows(), parent.getColumns()) {}
+
+template <typename T>
+BasicComplexMatrixView<T>::BasicComplexMatrixView(BasicComplexMatrix<T>& parent, int rowOffset, int colOffset, int rows, int columns)
+    : base(nullptr), realBase(nullptr), imagBase(nullptr), rows(rows), columns(columns),
+    stride(parent.getStride()), layout(parent.getLayout())
+{
+    assert(rowOffset >= 0 && colOffset >= 0 && rows >= 0 && columns >= 0);
+    validRows = std::max(0, std::min(rows, parent.getRows() - rowOffset));
+    validColumns = std::max(0, std::min(columns, parent.getColumns() - colOffset));
+    if (validRows == 0 || validColumns == 0)
+    {
+        validRows = 0;
+        validColumns = 0;
+        return;
+    }
+
+    std::size_t offset = static_cast<std::size_t>(rowOffset) * stride + colOffset;
+    if (layout == StorageLayout::Split)
+    {
+        realBase = parent.realData() + offset;
+        imagBase = parent.imagData() + offset;
+    }
+    else
+        base = parent.data() + offset;
+}
+
+template <typename T>
+BasicComplexMatrixView<T>::BasicComplexMatrixView(BasicComplexNum<T>* data, int rows, int columns, int stride)
+    : base(data), realBase(nullptr), imagBase(nullptr), rows(rows), columns(columns),
+    validRows(rows), validColumns(columns), stride(stride), layout(StorageLayout::Interleaved) {}
+
+template <typename T>
+BasicComplexMatrixView<T>::BasicComplexMatrixView(T* real, T* imag, int rows, int columns, int stride)
+    : base(nullptr), realBase(real), imagBase(imag), rows(rows), columns(columns),
+    validRows(rows), validColumns(columns), stride(stride), layout(StorageLayout::Split) {}
+
+template <typename T>
+BasicComplexMatrixView<T> BasicComplexMatrixView<T>::block(int rowOffset, int colOffset, int rows, int columns) const
+{
+    assert(rowOffset >= 0 && colOffset >= 0 && rows >= 0 && columns >= 0);
+
+    BasicComplexMatrixView<T> result;
+    result.rows = rows;
+    result.columns = columns;
+    result.stride = stride;
+    result.layout = layout;
+    result.validRows = std::max(0, std::min(rows, validRows - rowOffset));
+    result.validColumns = std::max(0, std::min(columns, validColumns - colOffset));
+    if (result.validRows == 0 || result.validColumns == 0)
+    {
+        result.validRows = 0;
+        result.validColumns = 0;
+        return result;
+    }
+
+    std::size_t offset = static_cast<std::size_t>(rowOffset) * stride + colOffset;
+    if (layout == StorageLayout::Split)
+    {
+        result.realBase = realBase + offset;
+        result.imagBase = imagBase + offset;
+    }
+    else
+        result.base = base + offset;
+    return result;
+}
+
+template <typename T>
+int BasicComplexMatrixView<T>::getRows() const
+{
+    return rows;
+}
+
+template <typename T>
+int BasicComplexMatrixView<T>::getColumns() const
+{
+    return columns;
+}
+
+template <typename T>
+int BasicComplexMatrixView<T>::getValidRows() const
+{
+    return validRows;
+}
+
+template <typename T>
+int BasicComplexMatrixView<T>::getValidColumns() const
+{
+    return validColumns;
+}
+
+template <typename T>
+int BasicComplexMatrixView<T>::getStride() const
+{
+    return stride;
+}
+
+template <typename T>
+StorageLayout BasicComplexMatrixView<T>::getLayout() const
+{
+    return layout;
+}
+
+template <typename T>
+BasicComplexNum<T>* BasicComplexMatrixView<T>::row(int i) const
+{
+    assert(layout == StorageLayout::Interleaved);
+    assert(i >= 0 && i < validRows);
+    return base + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+T* BasicComplexMatrixView<T>::realRow(int i) const
+{
+    assert(layout == StorageLayout::Split);
+    assert(i >= 0 && i < validRows);
+    return realBase + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+T* BasicComplexMatrixView<T>::imagRow(int i) const
+{
+    assert(layout == StorageLayout::Split);
+    assert(i >= 0 && i < validRows);
+    return imagBase + static_cast<std::size_t>(i) * stride;
+}
+
+template <typename T>
+BasicComplexNum<T> BasicComplexMatrixView<T>::get(int i, int j) const
+{
+    assert(i >= 0 && i < rows);
+    assert(j >= 0 && j < columns);
+    if (i >= validRows || j >= validColumns)
+        return BasicComplexNum<T>(0, 0);
+
+    std::size_t index = static_cast<std::size_t>(i) * stride + j;
+    if (layout == StorageLayout::Split)
+        return BasicComplexNum<T>(realBase[index], imagBase[index]);
+    return base[index];
+}
+
+template <typename T>
+void BasicComplexMatrixView<T>::set(int i, int j, BasicComplexNum<T> num)
+{
+    assert(i >= 0 && i < rows);
+    assert(j >= 0 && j < columns);
+    if (i >= validRows || j >= validColumns)
+        return;
+
+    std::size_t index = static_cast<std::size_t>(i) * stride + j;
+    if (layout == StorageLayout::Split)
+    {
+        realBase[index] = num.getReal();
+        imagBase[index] = num.getImag();
+    }
+    else
+        base[index] = num;
+}
+
+template <typename T>
+void BasicComplexMatrixView<T>::add(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> dst)
+{
+    elementwise(a, b, dst,
+        [](const BasicComplexNum<T>& x, const BasicComplexNum<T>& y) { return x + y; },
+        [](T x, T y) { return x + y; });
+}
+
+template <typename T>
+void BasicComplexMatrixView<T>::subtract(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> dst)
+{
+    elementwise(a, b, dst,
+        [](const BasicComplexNum<T>& x, const BasicComplexNum<T>& y) { return x - y; },
+        [](T x, T y) { return x - y; });
+}
+
+template <typename T>
+void BasicComplexMatrixView<T>::multiply(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> dst, MultiplyMode mode)
+{
+    BasicComplexGemm<T>::multiply(a, b, dst, false, mode);
+}
+
+template <typename T>
+MatrixOperand<T> toExpression(const BasicComplexMatrixView<T>& view)
+{
+    return MatrixOperand<T>(view.base, view.realBase, view.imagBase, view.rows, view.columns,
+        view.validRows, view.validColumns, view.stride, view.layout);
+}
+
+template class BasicComplexMatrixView<float>;
+template class BasicComplexMatrixView<double>;
+template class BasicComplexMatrixView<long double>;
+
+template MatrixOperand<float> toExpression(const BasicComplexMatrixView<float>& view);
+template MatrixOperand<double> toExpression(const BasicComplexMatrixView<double>& view);
+template MatrixOperand<long double> toExpression(const BasicComplexMatrixView<long double>& view);
@@ -0,0 +1,90 @@
+#pragma once
+#include "ComplexMatrix.h"
+
+/// @brief Non-owning, strided window into a ComplexMatrix.
+/// A view has a logical extent (rows x columns) and a backed extent that is clipped to the
+/// parent. Elements outside the backed extent read as zero and writes to them are dropped,
+/// which lets Strassen split odd dimensions into equal quadrants without copying or padding.
+template <typename T>
+class BasicComplexMatrixView
+{
+private:
+    BasicComplexNum<T>* base;
+    T* realBase;
+    T* imagBase;
+    int rows;
+    int columns;
+    int validRows;
+    int validColumns;
+    int stride;
+    StorageLayout layout;
+
+    template <typename U>
+    friend MatrixOperand<U> toExpression(const BasicComplexMatrixView<U>& view);
+
+public:
+    using Scalar = T;
+
+    BasicComplexMatrixView();
+
+    BasicComplexMatrixView(BasicComplexMatrix<T>& parent);
+
+    BasicComplexMatrixView(BasicComplexMatrix<T>& parent, int rowOffset, int colOffset, int rows, int columns);
+
+    /// @brief View over caller-managed interleaved storage (e.g. a workspace arena block).
+    BasicComplexMatrixView(BasicComplexNum<T>* data, int rows, int columns, int stride);
+
+    /// @brief View over caller-managed split real/imaginary planes.
+    BasicComplexMatrixView(T* real, T* imag, int rows, int columns, int stride);
+
+    /// @brief Sub-view relative to this one; the part that falls outside the backed extent reads as zero.
+    BasicComplexMatrixView block(int rowOffset, int colOffset, int rows, int columns) const;
+
+    int getRows() const;
+
+    int getColumns() const;
+
+    int getValidRows() const;
+
+    int getValidColumns() const;
+
+    int getStride() const;
+
+    StorageLayout getLayout() const;
+
+    BasicComplexNum<T>* row(int i) const;
+
+    T* realRow(int i) const;
+
+    T* imagRow(int i) const;
+
+    BasicComplexNum<T> get(int i, int j) const;
+
+    void set(int i, int j, BasicComplexNum<T> num);
+
+    /// @brief Evaluates a lazy expression over the backed extent of the view in one pass.
+    template <typename E>
+    void assign(const MatrixExpression<E>& expr);
+
+    /// @brief dst = a + b over the backed extent of dst.
+    static void add(const BasicComplexMatrixView& a, const BasicComplexMatrixView& b, BasicComplexMatrixView dst);
+
+    /// @brief dst = a - b over the backed extent of dst.
+    static void subtract(const BasicComplexMatrixView& a, const BasicComplexMatrixView& b, BasicComplexMatrixView dst);
+
+    /// @brief dst = a * b over the backed extent of dst (dst is overwritten, not accumulated); runs on ComplexGemm.
+    static void multiply(const BasicComplexMatrixView& a, const BasicComplexMatrixView& b, BasicComplexMatrixView dst, MultiplyMode mode = MultiplyMode::Classic);
+};
+
+template <typename T>
+template <typename E>
+void BasicComplexMatrixView<T>::assign(const MatrixExpression<E>& expr)
+{
+    assert(expr.getRows() == rows && expr.getColumns() == columns);
+
+    evaluateExpression(*this, expr.self(), validRows, validColumns);
+}
+
+using ComplexMatrixViewF = BasicComplexMatrixView<float>;
+using ComplexMatrixView = BasicComplexMatrixView<double>;
+using ComplexMatrixViewL = BasicComplexMatrixView<long double>;
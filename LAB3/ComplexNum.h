@@ -2,43 +2,151 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
-
-class ComplexNum
+#include <type_traits>
+
+namespace complex_detail {
+    /// @brief True when the target has a hardware fused multiply-add for T, in which case
+    /// std::fma is a single instruction rather than a slow library emulation.
+    template <typename T>
+    struct HasFastFma : std::false_type {};
+
+#ifdef FP_FAST_FMAF
+    template <>
+    struct HasFastFma<float> : std::true_type {};
+#endif
+#ifdef FP_FAST_FMA
+    template <>
+    struct HasFastFma<double> : std::true_type {};
+#endif
+#ifdef FP_FAST_FMAL
+    template <>
+    struct HasFastFma<long double> : std::true_type {};
+#endif
+
+    /// @brief a * b + c, fused when the hardware supports it and at run time only.
+    template <typename T>
+    constexpr T multiplyAdd(T a, T b, T c)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        if (HasFastFma<T>::value && !__builtin_is_constant_evaluated())
+            return std::fma(a, b, c);
+#endif
+        return a * b + c;
+    }
+
+    template <typename T>
+    constexpr T absolute(T value)
+    {
+        return value < T() ? -value : value;
+    }
+}
+
+/// @brief Complex number over the scalar type T (float, double or long double).
+/// Header-only and constexpr so the arithmetic inlines into the matrix kernels.
+template <typename T>
+class BasicComplexNum
 {
 private:
-    double real;
-    double imag; 
+    T real;
+    T imag;
 
-    constexpr static const double EPSILON = 1E-6; 
+    constexpr static const T EPSILON = std::is_same<T, float>::value ? T(1E-4) : T(1E-6);
 
 public:
-
-    ComplexNum(double real = 0.0, double imag = 0.0);
-
-
-    double getReal();
-
-
-    double getImag();
-
-    bool isNull();
-
-
-    void operator=(const ComplexNum& c1);
-
-    ComplexNum operator +(const ComplexNum& c1) const;
-
-    ComplexNum operator -(const ComplexNum& c1) const;
-
-    ComplexNum operator *(const ComplexNum& c1) const;
-
-    ComplexNum operator /(const ComplexNum& c1) const;
-
-    bool operator ==(const ComplexNum& c1) const;
-
-
-    bool operator !=(const ComplexNum& c1) const;
-
-
-    friend std::ostream& operator<<(std::ostream& os, const ComplexNum& c);
+    using Scalar = T;
+
+    constexpr BasicComplexNum(T real = T(), T imag = T()) : real(real), imag(imag) {}
+
+
+    constexpr T getReal() const { return real; }
+
+
+    constexpr T getImag() const { return imag; }
+
+    constexpr bool isNull() const { return real == T() && imag == T(); }
+
+    constexpr BasicComplexNum operator +(const BasicComplexNum& c1) const
+    {
+        return BasicComplexNum(real + c1.real, imag + c1.imag);
+    }
+
+    constexpr BasicComplexNum operator -(const BasicComplexNum& c1) const
+    {
+        return BasicComplexNum(real - c1.real, imag - c1.imag);
+    }
+
+    constexpr BasicComplexNum operator *(const BasicComplexNum& c1) const
+    {
+        return BasicComplexNum(
+            complex_detail::multiplyAdd(real, c1.real, -(imag * c1.imag)),
+            complex_detail::multiplyAdd(imag, c1.real, real * c1.imag));
+    }
+
+    constexpr BasicComplexNum operator /(const BasicComplexNum& c1) const
+    {
+        T div = c1.real * c1.real + c1.imag * c1.imag;
+        return BasicComplexNum(
+            (real * c1.real + imag * c1.imag) / div,
+            (imag * c1.real - real * c1.imag) / div);
+    }
+
+    constexpr BasicComplexNum& operator +=(const BasicComplexNum& c1)
+    {
+        real += c1.real;
+        imag += c1.imag;
+        return *this;
+    }
+
+    constexpr BasicComplexNum& operator -=(const BasicComplexNum& c1)
+    {
+        real -= c1.real;
+        imag -= c1.imag;
+        return *this;
+    }
+
+    /// @brief Multiply-accumulate used by the inner loops: *this += a * b with fused steps.
+    constexpr BasicComplexNum& addProduct(const BasicComplexNum& a, const BasicComplexNum& b)
+    {
+        real = complex_detail::multiplyAdd(a.real, b.real, complex_detail::multiplyAdd(-a.imag, b.imag, real));
+        imag = complex_detail::multiplyAdd(a.real, b.imag, complex_detail::multiplyAdd(a.imag, b.real, imag));
+        return *this;
+    }
+
+    /// @brief *this -= a * b with fused steps; the elimination and substitution update.
+    constexpr BasicComplexNum& subtractProduct(const BasicComplexNum& a, const BasicComplexNum& b)
+    {
+        real = complex_detail::multiplyAdd(-a.real, b.real, complex_detail::multiplyAdd(a.imag, b.imag, real));
+        imag = complex_detail::multiplyAdd(-a.real, b.imag, complex_detail::multiplyAdd(-a.imag, b.real, imag));
+        return *this;
+    }
+
+    constexpr bool operator ==(const BasicComplexNum& c1) const
+    {
+        return complex_detail::absolute(real - c1.real) < EPSILON && complex_detail::absolute(imag - c1.imag) < EPSILON;
+    }
+
+
+    constexpr bool operator !=(const BasicComplexNum& c1) const
+    {
+        return !(*this == c1);
+    }
+
+
+    friend std::ostream& operator<<(std::ostream& os, const BasicComplexNum& c)
+    {
+        if (c.real) {
+            os << std::setprecision(3) << c.real;
+        }
+        if (c.imag >= 0) {
+            os << "+" << std::setprecision(3) << c.imag << "i";
+        }
+        else {
+            os << std::setprecision(3) << c.imag << "i";
+        }
+        return os;
+    }
 };
+
+using ComplexNumF = BasicComplexNum<float>;
+using ComplexNum = BasicComplexNum<double>;
+using ComplexNumL = BasicComplexNum<long double>;
@@ -0,0 +1,283 @@
+#pragma once
+#include "ComplexMatrix.h"
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+/// @brief Largest order handled by the fixed-size path of MatrixInverseFactory.
+constexpr int FIXED_MATRIX_MAX_SIZE = 8;
+
+/// @brief N x N complex matrix with its storage on the stack.
+/// Real and imaginary parts are kept in separate planes and every loop has the compile-time
+/// bound N, so the compiler fully unrolls the small kernels below and nothing touches the heap.
+template <typename T, int N>
+class BasicFixedComplexMatrix
+{
+    static_assert(N >= 1 && N <= FIXED_MATRIX_MAX_SIZE, "fixed-size matrices are meant for small orders");
+
+private:
+    T re[N][N];
+    T im[N][N];
+
+    /// @brief Same tolerance as BasicComplexNum::operator==, kept inline for the unrolled loops.
+    static bool isZero(T real, T imag)
+    {
+        const T epsilon = std::is_same<T, float>::value ? T(1E-4) : T(1E-6);
+        return std::abs(real) < epsilon && std::abs(imag) < epsilon;
+    }
+
+    /// @brief 1 / (br + i*bi); pivots are inverted once and then only multiplied by.
+    static void reciprocal(T br, T bi, T& cr, T& ci)
+    {
+        T div = br * br + bi * bi;
+        cr = br / div;
+        ci = -bi / div;
+    }
+
+    static void multiply(T ar, T ai, T br, T bi, T& cr, T& ci)
+    {
+        T real = ar * br - ai * bi;
+        T imag = ar * bi + ai * br;
+        cr = real;
+        ci = imag;
+    }
+
+public:
+    using Scalar = T;
+
+    static constexpr int SIZE = N;
+
+    BasicFixedComplexMatrix()
+    {
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+            {
+                re[i][j] = T();
+                im[i][j] = T();
+            }
+    }
+
+    explicit BasicFixedComplexMatrix(const BasicComplexMatrix<T>& matrix)
+    {
+        assert(matrix.getRows() == N && matrix.getColumns() == N);
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+            {
+                BasicComplexNum<T> value = matrix.get(i, j);
+                re[i][j] = value.getReal();
+                im[i][j] = value.getImag();
+            }
+    }
+
+    static BasicFixedComplexMatrix identity()
+    {
+        BasicFixedComplexMatrix result;
+        for (int i = 0; i < N; i++)
+            result.re[i][i] = T(1);
+        return result;
+    }
+
+    int getRows() const { return N; }
+
+    int getColumns() const { return N; }
+
+    BasicComplexNum<T> get(int i, int j) const
+    {
+        assert(i >= 0 && i < N && j >= 0 && j < N);
+        return BasicComplexNum<T>(re[i][j], im[i][j]);
+    }
+
+    void set(int i, int j, BasicComplexNum<T> num)
+    {
+        assert(i >= 0 && i < N && j >= 0 && j < N);
+        re[i][j] = num.getReal();
+        im[i][j] = num.getImag();
+    }
+
+    BasicComplexMatrix<T> toMatrix() const
+    {
+        BasicComplexMatrix<T> result(N, N);
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                result.set(i, j, re[i][j], im[i][j]);
+        return result;
+    }
+
+    BasicFixedComplexMatrix operator *(const BasicFixedComplexMatrix& other) const
+    {
+        BasicFixedComplexMatrix result;
+        for (int i = 0; i < N; i++)
+            for (int k = 0; k < N; k++)
+            {
+                const T xr = re[i][k];
+                const T xi = im[i][k];
+                for (int j = 0; j < N; j++)
+                {
+                    result.re[i][j] += xr * other.re[k][j] - xi * other.im[k][j];
+                    result.im[i][j] += xr * other.im[k][j] + xi * other.re[k][j];
+                }
+            }
+        return result;
+    }
+
+    bool operator ==(const BasicFixedComplexMatrix& other) const
+    {
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                if (!isZero(re[i][j] - other.re[i][j], im[i][j] - other.im[i][j]))
+                    return false;
+        return true;
+    }
+
+    /// @brief Doolittle LU (unit lower diagonal) with partial pivoting, like LUFactorization,
+    /// followed by forward and back substitution for each column of the permuted identity. The
+    /// row swaps run over the fixed N columns, so they unroll like the rest of the kernel.
+    /// @return false when a pivot column is exactly zero; result is left unspecified in that case.
+    bool luInverse(BasicFixedComplexMatrix& result) const
+    {
+        BasicFixedComplexMatrix lu = *this;
+        int pivots[N];
+        T pr[N];
+        T pi[N];
+        for (int k = 0; k < N; k++)
+        {
+            int pivot = k;
+            T best = std::abs(lu.re[k][k]) + std::abs(lu.im[k][k]);
+            for (int i = k + 1; i < N; i++)
+            {
+                const T candidate = std::abs(lu.re[i][k]) + std::abs(lu.im[i][k]);
+                if (candidate > best)
+                {
+                    best = candidate;
+                    pivot = i;
+                }
+            }
+            if (best == T())
+                return false;
+            pivots[k] = pivot;
+            if (pivot != k)
+                for (int j = 0; j < N; j++)
+                {
+                    std::swap(lu.re[k][j], lu.re[pivot][j]);
+                    std::swap(lu.im[k][j], lu.im[pivot][j]);
+                }
+
+            reciprocal(lu.re[k][k], lu.im[k][k], pr[k], pi[k]);
+            for (int i = k + 1; i < N; i++)
+            {
+                T lr, li;
+                multiply(lu.re[i][k], lu.im[i][k], pr[k], pi[k], lr, li);
+                lu.re[i][k] = lr;
+                lu.im[i][k] = li;
+                for (int j = k + 1; j < N; j++)
+                {
+                    lu.re[i][j] -= lr * lu.re[k][j] - li * lu.im[k][j];
+                    lu.im[i][j] -= lr * lu.im[k][j] + li * lu.re[k][j];
+                }
+            }
+        }
+
+        for (int c = 0; c < N; c++)
+        {
+            // Column c of P * I: the unit vector e_c with the pivot swaps applied in order.
+            T br[N];
+            for (int i = 0; i < N; i++)
+                br[i] = i == c ? T(1) : T();
+            for (int k = 0; k < N; k++)
+                std::swap(br[k], br[pivots[k]]);
+
+            T yr[N];
+            T yi[N];
+            for (int i = 0; i < N; i++)
+            {
+                T sr = br[i];
+                T si = T();
+                for (int j = 0; j < i; j++)
+                {
+                    sr -= lu.re[i][j] * yr[j] - lu.im[i][j] * yi[j];
+                    si -= lu.re[i][j] * yi[j] + lu.im[i][j] * yr[j];
+                }
+                yr[i] = sr;
+                yi[i] = si;
+            }
+            for (int i = N - 1; i >= 0; i--)
+            {
+                T sr = yr[i];
+                T si = yi[i];
+                for (int j = i + 1; j < N; j++)
+                {
+                    sr -= lu.re[i][j] * result.re[j][c] - lu.im[i][j] * result.im[j][c];
+                    si -= lu.re[i][j] * result.im[j][c] + lu.im[i][j] * result.re[j][c];
+                }
+                multiply(sr, si, pr[i], pi[i], result.re[i][c], result.im[i][c]);
+            }
+        }
+        return true;
+    }
+
+    /// @brief Gauss-Jordan elimination on [A | I] with the same partial pivoting as luInverse:
+    /// each step swaps in the row with the largest |re| + |im| in the pivot column.
+    /// @return false when a pivot column is exactly zero; result is left unspecified in that case.
+    bool gaussJordanInverse(BasicFixedComplexMatrix& result) const
+    {
+        BasicFixedComplexMatrix a = *this;
+        result = identity();
+
+        for (int k = 0; k < N; k++)
+        {
+            int pivot = k;
+            T best = std::abs(a.re[k][k]) + std::abs(a.im[k][k]);
+            for (int i = k + 1; i < N; i++)
+            {
+                const T candidate = std::abs(a.re[i][k]) + std::abs(a.im[i][k]);
+                if (candidate > best)
+                {
+                    best = candidate;
+                    pivot = i;
+                }
+            }
+            if (best == T())
+                return false;
+            if (pivot != k)
+                for (int j = 0; j < N; j++)
+                {
+                    std::swap(a.re[k][j], a.re[pivot][j]);
+                    std::swap(a.im[k][j], a.im[pivot][j]);
+                    std::swap(result.re[k][j], result.re[pivot][j]);
+                    std::swap(result.im[k][j], result.im[pivot][j]);
+                }
+
+            T pr, pi;
+            reciprocal(a.re[k][k], a.im[k][k], pr, pi);
+            for (int j = 0; j < N; j++)
+            {
+                multiply(a.re[k][j], a.im[k][j], pr, pi, a.re[k][j], a.im[k][j]);
+                multiply(result.re[k][j], result.im[k][j], pr, pi, result.re[k][j], result.im[k][j]);
+            }
+
+            for (int i = 0; i < N; i++)
+            {
+                if (i == k)
+                    continue;
+                const T fr = a.re[i][k];
+                const T fi = a.im[i][k];
+                for (int j = 0; j < N; j++)
+                {
+                    a.re[i][j] -= fr * a.re[k][j] - fi * a.im[k][j];
+                    a.im[i][j] -= fr * a.im[k][j] + fi * a.re[k][j];
+                    result.re[i][j] -= fr * result.re[k][j] - fi * result.im[k][j];
+                    result.im[i][j] -= fr * result.im[k][j] + fi * result.re[k][j];
+                }
+            }
+        }
+        return true;
+    }
+};
+
+template <int N>
+using FixedComplexMatrixF = BasicFixedComplexMatrix<float, N>;
+template <int N>
+using FixedComplexMatrix = BasicFixedComplexMatrix<double, N>;
+template <int N>
+using FixedComplexMatrixL = BasicFixedComplexMatrix<long double, N>;
@@ -1,7 +1,8 @@
 #include "GaussJordanInverse.h"
 #include <algorithm>
 
-GaussJordanInverse::GaussJordanInverse(ComplexMatrix matrix) {
+template <typename T>
+BasicGaussJordanInverse<T>::BasicGaussJordanInverse(BasicComplexMatrix<T> matrix) {
     A = matrix;
     rank = A.getRows();
     columns = A.getColumns();
@@ -9,7 +10,7 @@ GaussJordanInverse::GaussJordanInverse(ComplexMatrix matrix) {
     assert(rank == columns);
     assert(rank == A.getRank());
 
-    tempMatrix = ComplexMatrix(rank, 2 * rank);
+    tempMatrix = BasicComplexMatrix<T>(rank, 2 * rank, StorageLayout::Split);
 
 
     for (int i = 0; i < rank; i++) {
@@ -17,19 +18,20 @@ GaussJordanInverse::GaussJordanInverse(ComplexMatrix matrix) {
             if (j < rank)
                 tempMatrix.set(i, j, A.get(i, j));
             if (j == (i + rank))
-                tempMatrix.set(i, j, ComplexNum(1, 0));
+                tempMatrix.set(i, j, BasicComplexNum<T>(1, 0));
         }
     }
 
     for (int i = 0; i < rank; i++) {
-        tempMatrix.set(i, i + rank, ComplexNum(1, 0));
+        tempMatrix.set(i, i + rank, BasicComplexNum<T>(1, 0));
     }
 }
 
-ComplexMatrix GaussJordanInverse::calculateGaussJordanInverse() {
+template <typename T>
+BasicComplexMatrix<T> BasicGaussJordanInverse<T>::calculateGaussJordanInverse() {
     for (int i = 0; i < rank; i++) {
         bool swapped = false;
-        while (tempMatrix.get(i, i) == ComplexNum(0, 0)) {
+        while (tempMatrix.get(i, i) == BasicComplexNum<T>(0, 0)) {
             tempMatrix.swapRows(i, i + 1);
             swapped = true;
         }
@@ -37,28 +39,23 @@ ComplexMatrix GaussJordanInverse::calculateGaussJordanInverse() {
             i = std::max(0, i - 1);
             continue;
         }
-        if (tempMatrix.get(i, i) == ComplexNum(0, 0))
+        if (tempMatrix.get(i, i) == BasicComplexNum<T>(0, 0))
             throw std::exception(); 
 
         for (int j = 0; j < rank; j++) {
             if (i != j) {
-                ComplexNum temp = tempMatrix.get(j, i) / tempMatrix.get(i, i);
+                BasicComplexNum<T> temp = tempMatrix.get(j, i) / tempMatrix.get(i, i);
 
-                for (int k = 0; k < 2 * rank; k++) {
-                    tempMatrix.set(j, k, tempMatrix.get(j, k) - tempMatrix.get(i, k) * temp);
-                }
+                tempMatrix.subtractRowMultiple(j, i, temp);
             }
         }
     }
 
     for (int i = 0; i < rank; i++) {
-        ComplexNum temp = tempMatrix.get(i, i);
-        for (int j = 0; j < 2 * rank; j++) {
-            tempMatrix.set(i, j, tempMatrix.get(i, j) / temp);
-        }
+        tempMatrix.divideRow(i, tempMatrix.get(i, i));
     }
 
-    ComplexMatrix resMatrix(rank, rank);
+    BasicComplexMatrix<T> resMatrix(rank, rank);
 
     for (int i = 0; i < rank; i++) {
         for (int j = 0; j < rank; j++) {
@@ -68,3 +65,7 @@ ComplexMatrix GaussJordanInverse::calculateGaussJordanInverse() {
 
     return resMatrix;
 }
+
+template class BasicGaussJordanInverse<float>;
+template class BasicGaussJordanInverse<double>;
+template class BasicGaussJordanInverse<long double>;
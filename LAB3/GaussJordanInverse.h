@@ -1,14 +1,17 @@
 #pragma once
 #include "ComplexMatrix.h"
-class GaussJordanInverse {
+template <typename T>
+class BasicGaussJordanInverse {
 private:
-    ComplexMatrix A; 
+    BasicComplexMatrix<T> A; 
     int rank; 
     int columns; 
-    ComplexMatrix tempMatrix; 
+    BasicComplexMatrix<T> tempMatrix; 
 public:
 
-    GaussJordanInverse(ComplexMatrix matrix);
+    BasicGaussJordanInverse(BasicComplexMatrix<T> matrix);
 
-    ComplexMatrix calculateGaussJordanInverse();
+    BasicComplexMatrix<T> calculateGaussJordanInverse();
 };
+
+using GaussJordanInverse = BasicGaussJordanInverse<double>;
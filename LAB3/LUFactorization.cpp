@@ -0,0 +1,201 @@
+#include "LUFactorization.h"
+#include "ComplexGemv.h"
+#include "ComplexKernels.h"
+#include "ThreadPool.h"
+#include "TuningProfile.h"
+#include <algorithm>
+
+namespace {
+    /// @brief |re| + |im|, the cheap pivot magnitude used by LAPACK's izamax.
+    template <typename T>
+    T magnitude(const BasicComplexNum<T>& value)
+    {
+        return std::abs(value.getReal()) + std::abs(value.getImag());
+    }
+}
+
+template <typename T>
+BasicLUFactorization<T>::BasicLUFactorization(const BasicComplexMatrix<T>& matrix, unsigned int threads)
+    : lu(), pivots(), size(matrix.getRows()), invertible(false)
+{
+    if (matrix.getRows() != matrix.getColumns())
+    {
+        size = 0;
+        return;
+    }
+
+    lu = matrix.toLayout(StorageLayout::Interleaved);
+    lu.setHermitian(false);
+    pivots.resize(size);
+
+    for (int k = 0; k < size; k++)
+    {
+        int pivot = k;
+        T best = magnitude(lu.get(k, k));
+        for (int i = k + 1; i < size; i++)
+        {
+            T candidate = magnitude(lu.get(i, k));
+            if (candidate > best)
+            {
+                best = candidate;
+                pivot = i;
+            }
+        }
+
+        pivots[k] = pivot;
+        if (lu.get(pivot, k).isNull())
+            return;
+        if (pivot != k)
+            lu.swapRows(k, pivot);
+
+        int rows = size - k - 1;
+        int workers = std::min<int>(threads, rows / TuningProfile::active().luRowsPerThread);
+        if (workers <= 1)
+        {
+            eliminate(k, k + 1, size);
+            continue;
+        }
+
+        // The shared pool's workers persist, so a step costs a hand-off rather than thread starts.
+        int chunk = (rows + workers - 1) / workers;
+        ThreadPool::shared().parallelFor((rows + chunk - 1) / chunk, [&](int part) {
+            int first = k + 1 + part * chunk;
+            eliminate(k, first, std::min(first + chunk, size));
+        }, workers);
+    }
+
+    invertible = true;
+}
+
+template <typename T>
+void BasicLUFactorization<T>::eliminate(int k, int firstRow, int lastRow)
+{
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    const BasicComplexNum<T>* pivotRow = lu.row(k);
+    const BasicComplexNum<T> pivot = pivotRow[k];
+    for (int i = firstRow; i < lastRow; i++)
+    {
+        BasicComplexNum<T>* target = lu.row(i);
+        BasicComplexNum<T> factor = target[k] / pivot;
+        target[k] = factor;
+        if (factor.isNull())
+            continue;
+        kernels.axpy(size - k - 1, BasicComplexNum<T>() - factor, pivotRow + k + 1, target + k + 1);
+    }
+}
+
+template <typename T>
+int BasicLUFactorization<T>::getSize() const
+{
+    return size;
+}
+
+template <typename T>
+bool BasicLUFactorization<T>::isInvertible() const
+{
+    return invertible;
+}
+
+template <typename T>
+const BasicComplexMatrix<T>& BasicLUFactorization<T>::packed() const
+{
+    return lu;
+}
+
+template <typename T>
+const std::vector<int>& BasicLUFactorization<T>::getPivots() const
+{
+    return pivots;
+}
+
+template <typename T>
+BasicComplexNum<T> BasicLUFactorization<T>::lower(int i, int j) const
+{
+    if (i == j)
+        return BasicComplexNum<T>(1, 0);
+    return i > j ? lu.get(i, j) : BasicComplexNum<T>();
+}
+
+template <typename T>
+BasicComplexNum<T> BasicLUFactorization<T>::upper(int i, int j) const
+{
+    return i <= j ? lu.get(i, j) : BasicComplexNum<T>();
+}
+
+template <typename T>
+void BasicLUFactorization<T>::solve(BasicComplexNum<T>* vector) const
+{
+    assert(invertible);
+
+    for (int k = 0; k < size; k++)
+        if (pivots[k] != k)
+            std::swap(vector[k], vector[pivots[k]]);
+
+    // Substitution runs SOLVE_BLOCK rows at a time: everything left of (or right of) the diagonal
+    // block is folded in with one GEMV, only the triangle itself is walked row by row.
+    const BasicComplexKernels<T>& kernels = BasicComplexKernels<T>::active();
+    const BasicComplexNum<T> minusOne(-1, 0);
+    const BasicComplexNum<T> one(1, 0);
+    BasicComplexMatrixView<T> factors(const_cast<BasicComplexMatrix<T>&>(lu));
+    int first = 0;
+    while (first < size && vector[first].isNull())
+        first++;
+
+    for (int blockStart = first; blockStart < size; blockStart += SOLVE_BLOCK)
+    {
+        const int blockEnd = std::min(size, blockStart + SOLVE_BLOCK);
+        if (blockStart > first)
+            BasicComplexGemv<T>::multiply(GemvOperation::NoTranspose, minusOne,
+                factors.block(blockStart, first, blockEnd - blockStart, blockStart - first), vector + first, one, vector + blockStart);
+        for (int i = blockStart + 1; i < blockEnd; i++)
+            vector[i] -= kernels.dot(i - blockStart, lu.row(i) + blockStart, vector + blockStart);
+    }
+
+    for (int blockEnd = size; blockEnd > 0; blockEnd -= SOLVE_BLOCK)
+    {
+        const int blockStart = std::max(0, blockEnd - SOLVE_BLOCK);
+        if (blockEnd < size)
+            BasicComplexGemv<T>::multiply(GemvOperation::NoTranspose, minusOne,
+                factors.block(blockStart, blockEnd, blockEnd - blockStart, size - blockEnd), vector + blockEnd, one, vector + blockStart);
+        for (int i = blockEnd - 1; i >= blockStart; i--)
+        {
+            const BasicComplexNum<T>* row = lu.row(i);
+            vector[i] = (vector[i] - kernels.dot(blockEnd - i - 1, row + i + 1, vector + i + 1)) / row[i];
+        }
+    }
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicLUFactorization<T>::inverse(unsigned int threads) const
+{
+    assert(invertible);
+
+    BasicComplexMatrix<T> result(size, size);
+    auto solveColumns = [&](int firstColumn, int lastColumn) {
+        std::vector<BasicComplexNum<T>> column(size);
+        for (int c = firstColumn; c < lastColumn; c++)
+        {
+            std::fill(column.begin(), column.end(), BasicComplexNum<T>());
+            column[c] = BasicComplexNum<T>(1, 0);
+            solve(column.data());
+            result.setColumn(c, column.data());
+        }
+    };
+
+    int workers = std::max(1, std::min<int>(threads, size));
+    if (workers == 1)
+    {
+        solveColumns(0, size);
+        return result;
+    }
+
+    int chunk = (size + workers - 1) / workers;
+    ThreadPool::shared().parallelFor((size + chunk - 1) / chunk, [&](int part) {
+        solveColumns(part * chunk, std::min((part + 1) * chunk, size));
+    }, workers);
+    return result;
+}
+
+template class BasicLUFactorization<float>;
+template class BasicLUFactorization<double>;
+template class BasicLUFactorization<long double>;
@@ -0,0 +1,54 @@
+#pragma once
+#include "ComplexMatrix.h"
+#include <vector>
+
+/// @brief LU factorization with partial pivoting, P * A = L * U, packed into one n x n matrix.
+/// U is stored on and above the diagonal and the multipliers of the unit lower L below it; the
+/// ones on L's diagonal and the zeros of both triangles are implicit. The packed matrix
+/// overwrites a copy of the input, so factorizing costs one n x n buffer instead of two.
+/// pivots[k] is the row that was swapped with row k at step k.
+template <typename T>
+class BasicLUFactorization
+{
+private:
+    BasicComplexMatrix<T> lu;
+    std::vector<int> pivots;
+    int size;
+    bool invertible;
+
+    /// @brief Stores the multipliers of rows [firstRow, lastRow) and updates their trailing part.
+    void eliminate(int k, int firstRow, int lastRow);
+
+public:
+    /// @brief Rows of a triangle solved directly in solve(); the rest is applied with ComplexGemv.
+    static constexpr int SOLVE_BLOCK = 64;
+
+    /// @brief Factorizes a square matrix. With threads > 1 the trailing update of large steps
+    /// is split between that many workers of the shared ThreadPool, each taking at least the
+    /// active TuningProfile's luRowsPerThread rows.
+    explicit BasicLUFactorization(const BasicComplexMatrix<T>& matrix, unsigned int threads = 1);
+
+    int getSize() const;
+
+    /// @brief False for non-square input or when a column has no non-zero pivot.
+    bool isInvertible() const;
+
+    const BasicComplexMatrix<T>& packed() const;
+
+    const std::vector<int>& getPivots() const;
+
+    /// @brief Element of L, including the implicit unit diagonal and upper zeros.
+    BasicComplexNum<T> lower(int i, int j) const;
+
+    /// @brief Element of U, including the implicit lower zeros.
+    BasicComplexNum<T> upper(int i, int j) const;
+
+    /// @brief Solves A * x = b in place: vector holds b on entry and x on return.
+    void solve(BasicComplexNum<T>* vector) const;
+
+    /// @brief A^-1, one solve per column of the identity; columns are split between up to threads
+    /// workers of the shared ThreadPool.
+    BasicComplexMatrix<T> inverse(unsigned int threads = 1) const;
+};
+
+using LUFactorization = BasicLUFactorization<double>;
@@ -2,20 +2,15 @@
 #include <iostream>
 #include "ComplexNum.h"
 #include "ComplexMatrix.h"
-#include "Strassen.h"
+#include "LUFactorization.h"
 
-class LUInverse {
+template <typename T>
+class BasicLUInverse {
 public:
 
-    static bool LUDecomposition(ComplexMatrix a, ComplexMatrix& l, ComplexMatrix& u);
+    static BasicLUFactorization<T> LUDecomposition(const BasicComplexMatrix<T>& a);
 
-
-    static ComplexNum* createEmpty(int n);
-
-    static ComplexNum* forwardSubstitution(ComplexMatrix l, ComplexNum* vector, int n);
-
-
-    static ComplexNum* backSubstitution(ComplexMatrix u, ComplexNum* vector, int n);
-
-    static ComplexMatrix calculateLUInverse(ComplexMatrix a);
+    static BasicComplexMatrix<T> calculateLUInverse(const BasicComplexMatrix<T>& a);
 };
+
+using LUInverse = BasicLUInverse<double>;
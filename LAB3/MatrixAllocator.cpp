@@ -0,0 +1,184 @@
+#include "MatrixAllocator.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <vector>
+
+#ifdef __linux__
+#include <fstream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+#endif
+
+namespace {
+    std::atomic<MatrixAllocator*> installed(nullptr);
+
+    std::size_t roundUp(std::size_t bytes, std::size_t multiple)
+    {
+        return (bytes + multiple - 1) / multiple * multiple;
+    }
+
+#ifdef __linux__
+    constexpr int MAX_NUMA_NODES = 1024;
+    constexpr int BITS_PER_WORD = 8 * sizeof(unsigned long);
+
+    /// @brief Parses /sys/devices/system/node/online ("0-1,4") into an mbind node mask.
+    bool onlineNodes(std::vector<unsigned long>& mask)
+    {
+        std::ifstream file("/sys/devices/system/node/online");
+        std::string list;
+        if (!(file >> list))
+            return false;
+
+        mask.assign(MAX_NUMA_NODES / BITS_PER_WORD, 0);
+        int nodes = 0;
+        std::size_t position = 0;
+        while (position < list.size())
+        {
+            std::size_t end = list.find(',', position);
+            std::string range = list.substr(position, end == std::string::npos ? std::string::npos : end - position);
+            std::size_t dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int node = first; node <= last && node < MAX_NUMA_NODES; node++)
+            {
+                mask[node / BITS_PER_WORD] |= 1UL << (node % BITS_PER_WORD);
+                nodes++;
+            }
+            if (end == std::string::npos)
+                break;
+            position = end + 1;
+        }
+        return nodes > 1;
+    }
+
+    void interleave(void* pointer, std::size_t bytes)
+    {
+        std::vector<unsigned long> mask;
+        if (!onlineNodes(mask))
+            return;
+        // Advisory: on kernels without NUMA support the call fails and the default policy stays.
+        syscall(SYS_mbind, pointer, bytes, MPOL_INTERLEAVE, mask.data(), MAX_NUMA_NODES + 1, 0);
+    }
+
+    /// @brief Writes one byte per page from the shared ThreadPool, one task per contiguous slice
+    /// (the row bands a row-partitioned engine hands its workers). Under first-touch NUMA
+    /// placement each page lands on the node of the pool thread that touched it.
+    void touchSlices(char* pointer, std::size_t bytes, unsigned int slices)
+    {
+        const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const std::size_t pages = bytes / page;
+        const std::size_t chunk = (pages + slices - 1) / slices;
+        const int count = static_cast<int>((pages + chunk - 1) / chunk);
+        ThreadPool::shared().parallelFor(count, [=](int slice) {
+            const std::size_t first = slice * chunk;
+            const std::size_t last = std::min(first + chunk, pages);
+            for (std::size_t p = first; p < last; p++)
+                static_cast<volatile char*>(pointer)[p * page] = 0;
+        }, slices);
+    }
+#endif
+}
+
+bool MatrixAllocator::zeroFilled(std::size_t) const
+{
+    return false;
+}
+
+MatrixAllocator& MatrixAllocator::current()
+{
+    MatrixAllocator* allocator = installed.load(std::memory_order_acquire);
+    if (allocator)
+        return *allocator;
+
+    static LargePageAllocator fallback;
+    return fallback;
+}
+
+void MatrixAllocator::setCurrent(MatrixAllocator* allocator)
+{
+    installed.store(allocator, std::memory_order_release);
+}
+
+void* AlignedAllocator::allocate(std::size_t bytes)
+{
+    return ::operator new(bytes, std::align_val_t(ALIGNMENT));
+}
+
+void AlignedAllocator::deallocate(void* pointer, std::size_t)
+{
+    ::operator delete(pointer, std::align_val_t(ALIGNMENT));
+}
+
+LargePageAllocator::LargePageAllocator(const AllocationPolicy& policy) : policy(policy), small() {}
+
+const AllocationPolicy& LargePageAllocator::getPolicy() const
+{
+    return policy;
+}
+
+bool LargePageAllocator::isLarge(std::size_t bytes) const
+{
+#ifdef __linux__
+    return bytes >= policy.largeThreshold;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+void* LargePageAllocator::allocate(std::size_t bytes)
+{
+    if (!isLarge(bytes))
+        return small.allocate(bytes);
+
+#ifdef __linux__
+    // Over-map by one huge page and trim, so the block starts on a huge page boundary.
+    const std::size_t length = roundUp(bytes, HUGE_PAGE_SIZE);
+    char* mapping = static_cast<char*>(mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+
+    char* start = reinterpret_cast<char*>(roundUp(reinterpret_cast<std::size_t>(mapping), HUGE_PAGE_SIZE));
+    if (start != mapping)
+        munmap(mapping, start - mapping);
+    munmap(start + length, mapping + HUGE_PAGE_SIZE - start);
+
+    if (policy.hugePages)
+        madvise(start, length, MADV_HUGEPAGE);
+    if (policy.placement == NumaPlacement::Interleave)
+        interleave(start, length);
+    if (policy.placement == NumaPlacement::FirstTouch)
+        touchSlices(start, length, ThreadPool::shared().size());
+    else if (policy.prefaultThreads > 1)
+        touchSlices(start, length, policy.prefaultThreads);
+    return start;
+#else
+    return small.allocate(bytes);
+#endif
+}
+
+void LargePageAllocator::deallocate(void* pointer, std::size_t bytes)
+{
+    if (!isLarge(bytes))
+    {
+        small.deallocate(pointer, bytes);
+        return;
+    }
+
+#ifdef __linux__
+    munmap(pointer, roundUp(bytes, HUGE_PAGE_SIZE));
+#endif
+}
+
+bool LargePageAllocator::zeroFilled(std::size_t bytes) const
+{
+    return isLarge(bytes);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+
+/// @brief Where the pages of a large buffer end up on a multi-socket machine.
+enum class NumaPlacement {
+    /// @brief Kernel default: pages land on the node of the thread that first touches them.
+    Default,
+    /// @brief Pages are spread round-robin over all online nodes (mbind MPOL_INTERLEAVE).
+    Interleave,
+    /// @brief Pages are touched at allocation by the threads of the shared ThreadPool, one
+    /// contiguous row band per thread, so each band lands on the node of a pool worker (the
+    /// threads the parallel engines run on) rather than all on the allocating thread's node.
+    FirstTouch
+};
+
+struct AllocationPolicy {
+    /// @brief Buffers of at least this many bytes are mapped directly and may use huge pages.
+    std::size_t largeThreshold = std::size_t(2) << 20;
+
+    /// @brief Ask for transparent huge pages (madvise MADV_HUGEPAGE) on large mappings.
+    bool hugePages = true;
+
+    NumaPlacement placement = NumaPlacement::Default;
+
+    /// @brief When > 1, large buffers are pre-faulted on up to this many threads of the shared
+    /// ThreadPool, each touching the contiguous slice a row-partitioned worker would own. 0 or 1
+    /// leaves the pages untouched. FirstTouch placement always touches with the whole pool.
+    unsigned int prefaultThreads = 0;
+};
+
+/// @brief Backend that provides the storage of ComplexMatrix and StrassenWorkspace.
+/// Every block is aligned to ALIGNMENT. Matrices remember the backend that allocated them,
+/// so switching the current backend never frees a buffer through the wrong one.
+class MatrixAllocator
+{
+public:
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    virtual ~MatrixAllocator() = default;
+
+    virtual void* allocate(std::size_t bytes) = 0;
+
+    virtual void deallocate(void* pointer, std::size_t bytes) = 0;
+
+    /// @brief True when a block of this size comes back already zero-filled, so callers may skip
+    /// clearing it (and leave first touch to the threads that use it).
+    virtual bool zeroFilled(std::size_t bytes) const;
+
+    /// @brief Backend used for new matrices; a LargePageAllocator with the default policy unless replaced.
+    static MatrixAllocator& current();
+
+    /// @brief Replaces the backend for subsequent allocations; nullptr restores the default.
+    /// The allocator must outlive every matrix and thread-local StrassenWorkspace allocated through it.
+    static void setCurrent(MatrixAllocator* allocator);
+};
+
+/// @brief Plain aligned operator new / delete.
+class AlignedAllocator : public MatrixAllocator
+{
+public:
+    void* allocate(std::size_t bytes) override;
+
+    void deallocate(void* pointer, std::size_t bytes) override;
+};
+
+/// @brief Maps large buffers directly (huge-page aligned, optionally THP, NUMA-interleaved or
+/// first-touched by the pool workers) and hands small ones to AlignedAllocator.
+/// Outside Linux every request goes to AlignedAllocator.
+class LargePageAllocator : public MatrixAllocator
+{
+private:
+    AllocationPolicy policy;
+    AlignedAllocator small;
+
+    bool isLarge(std::size_t bytes) const;
+
+public:
+    static constexpr std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20;
+
+    explicit LargePageAllocator(const AllocationPolicy& policy = AllocationPolicy());
+
+    const AllocationPolicy& getPolicy() const;
+
+    void* allocate(std::size_t bytes) override;
+
+    void deallocate(void* pointer, std::size_t bytes) override;
+
+    bool zeroFilled(std::size_t bytes) const override;
+};
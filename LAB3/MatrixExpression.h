@@ -0,0 +1,345 @@
+#pragma once
+#include "ComplexNum.h"
+#include "StorageLayout.h"
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+template <typename T>
+class BasicComplexMatrix;
+
+template <typename T>
+class BasicComplexMatrixView;
+
+/// @brief CRTP base of the lazy element-wise expressions built by ComplexMatrix operator+,
+/// operator-, scalar operator* and conjugate(). Nothing is computed until the expression is
+/// assigned to a ComplexMatrix or a ComplexMatrixView, which then runs one fused loop.
+/// Expressions hold pointers into their operands, so they must not outlive them (avoid auto).
+template <typename E>
+class MatrixExpression
+{
+public:
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    int getRows() const { return self().getRows(); }
+
+    int getColumns() const { return self().getColumns(); }
+
+    StorageLayout getLayout() const { return self().getLayout(); }
+
+    auto at(int i, int j) const { return self().at(i, j); }
+
+    /// @brief Whether every operand is backed over rows x columns and stored in layout, so
+    /// dense() may be used there instead of at().
+    bool backs(int rows, int columns, StorageLayout layout) const { return self().backs(rows, columns, layout); }
+
+    /// @brief Element (i, j) without the extent and layout tests of at(); see backs().
+    template <StorageLayout Layout>
+    auto dense(int i, int j) const { return self().template dense<Layout>(i, j); }
+};
+
+/// @brief Leaf of an expression: a read-only window onto matrix storage.
+/// Elements outside the backed extent read as zero, matching ComplexMatrixView.
+template <typename T>
+class MatrixOperand : public MatrixExpression<MatrixOperand<T>>
+{
+private:
+    const BasicComplexNum<T>* data;
+    const T* real;
+    const T* imag;
+    int rows;
+    int columns;
+    int validRows;
+    int validColumns;
+    int stride;
+    StorageLayout layout;
+
+public:
+    using Scalar = T;
+
+    MatrixOperand(const BasicComplexNum<T>* data, const T* real, const T* imag,
+        int rows, int columns, int validRows, int validColumns, int stride, StorageLayout layout)
+        : data(data), real(real), imag(imag), rows(rows), columns(columns),
+        validRows(validRows), validColumns(validColumns), stride(stride), layout(layout) {}
+
+    int getRows() const { return rows; }
+
+    int getColumns() const { return columns; }
+
+    StorageLayout getLayout() const { return layout; }
+
+    BasicComplexNum<T> at(int i, int j) const
+    {
+        if (i >= validRows || j >= validColumns)
+            return BasicComplexNum<T>();
+        std::size_t index = static_cast<std::size_t>(i) * stride + j;
+        if (layout == StorageLayout::Split)
+            return BasicComplexNum<T>(real[index], imag[index]);
+        return data[index];
+    }
+
+    bool backs(int rowCount, int columnCount, StorageLayout target) const
+    {
+        return layout == target && validRows >= rowCount && validColumns >= columnCount;
+    }
+
+    template <StorageLayout Layout>
+    BasicComplexNum<T> dense(int i, int j) const
+    {
+        std::size_t index = static_cast<std::size_t>(i) * stride + j;
+        if (Layout == StorageLayout::Split)
+            return BasicComplexNum<T>(real[index], imag[index]);
+        return data[index];
+    }
+};
+
+template <typename L, typename R>
+class MatrixSum : public MatrixExpression<MatrixSum<L, R>>
+{
+private:
+    L lhs;
+    R rhs;
+
+public:
+    using Scalar = typename L::Scalar;
+
+    MatrixSum(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs)
+    {
+        assert(lhs.getRows() == rhs.getRows() && lhs.getColumns() == rhs.getColumns());
+    }
+
+    int getRows() const { return lhs.getRows(); }
+
+    int getColumns() const { return lhs.getColumns(); }
+
+    StorageLayout getLayout() const { return lhs.getLayout(); }
+
+    BasicComplexNum<Scalar> at(int i, int j) const { return lhs.at(i, j) + rhs.at(i, j); }
+
+    bool backs(int rows, int columns, StorageLayout layout) const { return lhs.backs(rows, columns, layout) && rhs.backs(rows, columns, layout); }
+
+    template <StorageLayout Layout>
+    BasicComplexNum<Scalar> dense(int i, int j) const { return lhs.template dense<Layout>(i, j) + rhs.template dense<Layout>(i, j); }
+};
+
+template <typename L, typename R>
+class MatrixDifference : public MatrixExpression<MatrixDifference<L, R>>
+{
+private:
+    L lhs;
+    R rhs;
+
+public:
+    using Scalar = typename L::Scalar;
+
+    MatrixDifference(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs)
+    {
+        assert(lhs.getRows() == rhs.getRows() && lhs.getColumns() == rhs.getColumns());
+    }
+
+    int getRows() const { return lhs.getRows(); }
+
+    int getColumns() const { return lhs.getColumns(); }
+
+    StorageLayout getLayout() const { return lhs.getLayout(); }
+
+    BasicComplexNum<Scalar> at(int i, int j) const { return lhs.at(i, j) - rhs.at(i, j); }
+
+    bool backs(int rows, int columns, StorageLayout layout) const { return lhs.backs(rows, columns, layout) && rhs.backs(rows, columns, layout); }
+
+    template <StorageLayout Layout>
+    BasicComplexNum<Scalar> dense(int i, int j) const { return lhs.template dense<Layout>(i, j) - rhs.template dense<Layout>(i, j); }
+};
+
+template <typename E>
+class MatrixScaled : public MatrixExpression<MatrixScaled<E>>
+{
+private:
+    E expr;
+    BasicComplexNum<typename E::Scalar> factor;
+
+public:
+    using Scalar = typename E::Scalar;
+
+    MatrixScaled(const E& expr, const BasicComplexNum<Scalar>& factor) : expr(expr), factor(factor) {}
+
+    int getRows() const { return expr.getRows(); }
+
+    int getColumns() const { return expr.getColumns(); }
+
+    StorageLayout getLayout() const { return expr.getLayout(); }
+
+    BasicComplexNum<Scalar> at(int i, int j) const { return expr.at(i, j) * factor; }
+
+    bool backs(int rows, int columns, StorageLayout layout) const { return expr.backs(rows, columns, layout); }
+
+    template <StorageLayout Layout>
+    BasicComplexNum<Scalar> dense(int i, int j) const { return expr.template dense<Layout>(i, j) * factor; }
+};
+
+template <typename E>
+class MatrixConjugate : public MatrixExpression<MatrixConjugate<E>>
+{
+private:
+    E expr;
+
+public:
+    using Scalar = typename E::Scalar;
+
+    explicit MatrixConjugate(const E& expr) : expr(expr) {}
+
+    int getRows() const { return expr.getRows(); }
+
+    int getColumns() const { return expr.getColumns(); }
+
+    StorageLayout getLayout() const { return expr.getLayout(); }
+
+    BasicComplexNum<Scalar> at(int i, int j) const
+    {
+        BasicComplexNum<Scalar> value = expr.at(i, j);
+        return BasicComplexNum<Scalar>(value.getReal(), -value.getImag());
+    }
+
+    bool backs(int rows, int columns, StorageLayout layout) const { return expr.backs(rows, columns, layout); }
+
+    template <StorageLayout Layout>
+    BasicComplexNum<Scalar> dense(int i, int j) const
+    {
+        BasicComplexNum<Scalar> value = expr.template dense<Layout>(i, j);
+        return BasicComplexNum<Scalar>(value.getReal(), -value.getImag());
+    }
+};
+
+namespace expression_detail {
+    template <StorageLayout Layout, typename Target, typename E>
+    void evaluateDense(Target& target, const E& source, int rows, int columns)
+    {
+        using T = typename E::Scalar;
+        for (int i = 0; i < rows; i++)
+        {
+            if (Layout == StorageLayout::Split)
+            {
+                T* re = target.realRow(i);
+                T* im = target.imagRow(i);
+                for (int j = 0; j < columns; j++)
+                {
+                    BasicComplexNum<T> value = source.template dense<Layout>(i, j);
+                    re[j] = value.getReal();
+                    im[j] = value.getImag();
+                }
+            }
+            else
+            {
+                BasicComplexNum<T>* out = target.row(i);
+                for (int j = 0; j < columns; j++)
+                    out[j] = source.template dense<Layout>(i, j);
+            }
+        }
+    }
+}
+
+/// @brief Writes rows x columns of source into target, a ComplexMatrix or ComplexMatrixView.
+/// When every operand is backed there and shares the target's layout, the extent and layout
+/// tests are made once and each row is a straight loop over the storage rows; otherwise each
+/// element goes through at(), which reads the padded edges as zero.
+template <typename Target, typename E>
+void evaluateExpression(Target& target, const E& source, int rows, int columns)
+{
+    using T = typename E::Scalar;
+    const StorageLayout layout = target.getLayout();
+    if (source.backs(rows, columns, layout))
+    {
+        if (layout == StorageLayout::Split)
+            expression_detail::evaluateDense<StorageLayout::Split>(target, source, rows, columns);
+        else
+            expression_detail::evaluateDense<StorageLayout::Interleaved>(target, source, rows, columns);
+        return;
+    }
+
+    for (int i = 0; i < rows; i++)
+    {
+        if (layout == StorageLayout::Split)
+        {
+            T* re = target.realRow(i);
+            T* im = target.imagRow(i);
+            for (int j = 0; j < columns; j++)
+            {
+                BasicComplexNum<T> value = source.at(i, j);
+                re[j] = value.getReal();
+                im[j] = value.getImag();
+            }
+        }
+        else
+        {
+            BasicComplexNum<T>* out = target.row(i);
+            for (int j = 0; j < columns; j++)
+                out[j] = source.at(i, j);
+        }
+    }
+}
+
+template <typename T>
+MatrixOperand<T> toExpression(const BasicComplexMatrix<T>& matrix);
+
+template <typename T>
+MatrixOperand<T> toExpression(const BasicComplexMatrixView<T>& view);
+
+template <typename E>
+const E& toExpression(const MatrixExpression<E>& expr)
+{
+    return expr.self();
+}
+
+/// @brief True for the types that may appear as operands of a matrix expression.
+template <typename T>
+struct IsMatrixArgument
+{
+    static constexpr bool value = std::is_base_of<MatrixExpression<T>, T>::value;
+};
+
+template <typename T>
+struct IsMatrixArgument<BasicComplexMatrix<T>>
+{
+    static constexpr bool value = true;
+};
+
+template <typename T>
+struct IsMatrixArgument<BasicComplexMatrixView<T>>
+{
+    static constexpr bool value = true;
+};
+
+template <typename T>
+using ExpressionOf = typename std::decay<decltype(toExpression(std::declval<const T&>()))>::type;
+
+template <typename L, typename R,
+    typename = typename std::enable_if<IsMatrixArgument<L>::value && IsMatrixArgument<R>::value>::type>
+MatrixSum<ExpressionOf<L>, ExpressionOf<R>> operator +(const L& lhs, const R& rhs)
+{
+    return MatrixSum<ExpressionOf<L>, ExpressionOf<R>>(toExpression(lhs), toExpression(rhs));
+}
+
+template <typename L, typename R,
+    typename = typename std::enable_if<IsMatrixArgument<L>::value && IsMatrixArgument<R>::value>::type>
+MatrixDifference<ExpressionOf<L>, ExpressionOf<R>> operator -(const L& lhs, const R& rhs)
+{
+    return MatrixDifference<ExpressionOf<L>, ExpressionOf<R>>(toExpression(lhs), toExpression(rhs));
+}
+
+template <typename E, typename = typename std::enable_if<IsMatrixArgument<E>::value>::type>
+MatrixScaled<ExpressionOf<E>> operator *(const BasicComplexNum<typename ExpressionOf<E>::Scalar>& factor, const E& expr)
+{
+    return MatrixScaled<ExpressionOf<E>>(toExpression(expr), factor);
+}
+
+template <typename E, typename = typename std::enable_if<IsMatrixArgument<E>::value>::type>
+MatrixScaled<ExpressionOf<E>> operator *(const E& expr, const BasicComplexNum<typename ExpressionOf<E>::Scalar>& factor)
+{
+    return MatrixScaled<ExpressionOf<E>>(toExpression(expr), factor);
+}
+
+template <typename E, typename = typename std::enable_if<IsMatrixArgument<E>::value>::type>
+MatrixConjugate<ExpressionOf<E>> conjugate(const E& expr)
+{
+    return MatrixConjugate<ExpressionOf<E>>(toExpression(expr));
+}
@@ -1,19 +1,122 @@
 #include "MatrixInverseFactory.h"
-ComplexMatrix MatrixInverseFactory::calculateInverse(const ComplexMatrix& matrix, InverseAlgorithm algorithm) {
+#include "TuningProfile.h"
+
+namespace {
+    template <typename T, int N>
+    bool fixedInverse(const BasicComplexMatrix<T>& matrix, InverseAlgorithm algorithm, BasicComplexMatrix<T>& inverse)
+    {
+        BasicFixedComplexMatrix<T, N> input(matrix);
+        BasicFixedComplexMatrix<T, N> result;
+        bool inverted = (algorithm == InverseAlgorithm::LU || algorithm == InverseAlgorithm::ParallelLU)
+            ? input.luInverse(result)
+            : input.gaussJordanInverse(result);
+        // Singular, as LUInverse reports it; the dense algorithms would only find the same zero pivot.
+        inverse = inverted ? result.toMatrix() : BasicComplexMatrix<T>(0, 0);
+        return true;
+    }
+
+    /// @brief Whether a square matrix equals its conjugate transpose exactly. The Hermitian flag
+    /// survives writes through views and raw rows, so it is confirmed before Cholesky trusts it.
+    template <typename T>
+    bool equalsConjugateTranspose(const BasicComplexMatrix<T>& matrix)
+    {
+        for (int i = 0; i < matrix.getRows(); i++)
+        {
+            if (matrix.get(i, i).getImag() != T())
+                return false;
+            for (int j = 0; j < i; j++)
+            {
+                BasicComplexNum<T> lower = matrix.get(i, j);
+                BasicComplexNum<T> upper = matrix.get(j, i);
+                if (lower.getReal() != upper.getReal() || lower.getImag() != -upper.getImag())
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+template <typename T>
+bool BasicMatrixInverseFactory<T>::calculateFixedInverse(const BasicComplexMatrix<T>& matrix, InverseAlgorithm algorithm, BasicComplexMatrix<T>& inverse) {
+    if (matrix.getRows() != matrix.getColumns())
+        return false;
+
+    switch (matrix.getRows()) {
+    case 1: return fixedInverse<T, 1>(matrix, algorithm, inverse);
+    case 2: return fixedInverse<T, 2>(matrix, algorithm, inverse);
+    case 3: return fixedInverse<T, 3>(matrix, algorithm, inverse);
+    case 4: return fixedInverse<T, 4>(matrix, algorithm, inverse);
+    case 5: return fixedInverse<T, 5>(matrix, algorithm, inverse);
+    case 6: return fixedInverse<T, 6>(matrix, algorithm, inverse);
+    case 7: return fixedInverse<T, 7>(matrix, algorithm, inverse);
+    case 8: return fixedInverse<T, 8>(matrix, algorithm, inverse);
+    default:
+        return false;
+    }
+}
+template <typename T>
+bool BasicMatrixInverseFactory<T>::calculateBandedInverse(const BasicComplexMatrix<T>& matrix, BasicComplexMatrix<T>& inverse) {
+    if (matrix.getRows() != matrix.getColumns())
+        return false;
+
+    int lower = 0;
+    int upper = 0;
+    BasicBandedComplexMatrix<T>::bandwidth(matrix, lower, upper);
+    if ((lower + upper + 1) * 4 > matrix.getRows())
+        return false;
+
+    BasicBandedLUFactorization<T> factorization(BasicBandedComplexMatrix<T>::fromDense(matrix, lower, upper));
+    if (!factorization.isInvertible())
+        return false;
+    inverse = factorization.inverse();
+    return true;
+}
+
+template <typename T>
+bool BasicMatrixInverseFactory<T>::calculateCholeskyInverse(const BasicComplexMatrix<T>& matrix, InverseAlgorithm algorithm, BasicComplexMatrix<T>& inverse) {
+    if (!matrix.isHermitian() || matrix.getRows() != matrix.getColumns() || !equalsConjugateTranspose(matrix))
+        return false;
+
+    BasicCholeskyFactorization<T> factorization(matrix);
+    if (!factorization.isPositiveDefinite())
+        return false;
+    bool parallel = algorithm == InverseAlgorithm::ParallelLU || algorithm == InverseAlgorithm::ParallelGaussJordan;
+    inverse = factorization.inverse(parallel ? TuningProfile::active().threadCount() : 1);
+    return true;
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicMatrixInverseFactory<T>::calculateInverse(const BasicComplexMatrix<T>& matrix, InverseAlgorithm algorithm) {
+    BasicComplexMatrix<T> fixedResult;
+    if (calculateFixedInverse(matrix, algorithm, fixedResult))
+        return fixedResult;
+
+    BasicComplexMatrix<T> choleskyResult;
+    if (calculateCholeskyInverse(matrix, algorithm, choleskyResult))
+        return choleskyResult;
+
+    BasicComplexMatrix<T> bandedResult;
+    if (calculateBandedInverse(matrix, bandedResult))
+        return bandedResult;
+
     switch (algorithm) {
     case InverseAlgorithm::LU:
-        return LUInverse::calculateLUInverse(matrix);
+        return BasicLUInverse<T>::calculateLUInverse(matrix);
     case InverseAlgorithm::ParallelLU:
-        return ParallelLUInverse::calculateParallelLUInverse(matrix);
+        return BasicParallelLUInverse<T>::calculateParallelLUInverse(matrix);
     case InverseAlgorithm::GaussJordan: {
-        GaussJordanInverse gaussJordan(matrix);
+        BasicGaussJordanInverse<T> gaussJordan(matrix);
         return gaussJordan.calculateGaussJordanInverse();
     }
     case InverseAlgorithm::ParallelGaussJordan: {
-        ParallelGaussJordanInverse parallelGaussJordan(matrix);
+        BasicParallelGaussJordanInverse<T> parallelGaussJordan(matrix);
         return parallelGaussJordan.calculateParallelGaussJordanInverse();
     }
     default:
         throw std::runtime_error("Invalid inverse algorithm chosen");
     }
 }
+
+template class BasicMatrixInverseFactory<float>;
+template class BasicMatrixInverseFactory<double>;
+template class BasicMatrixInverseFactory<long double>;
@@ -4,6 +4,9 @@
 #include "ParallelLUInverse.h"
 #include "GaussJordanInverse.h"
 #include "ParallelGaussJordanInverse.h"
+#include "FixedComplexMatrix.h"
+#include "BandedLUFactorization.h"
+#include "CholeskyFactorization.h"
 
 enum class InverseAlgorithm {
     LU,
@@ -11,7 +14,31 @@ enum class InverseAlgorithm {
     GaussJordan,
     ParallelGaussJordan
 };
-class MatrixInverseFactory {
+template <typename T>
+class BasicMatrixInverseFactory {
+private:
+    /// @brief Inverts square matrices up to FIXED_MATRIX_MAX_SIZE on the stack with the
+    /// unrolled fixed-size kernels; a singular one yields an empty 0 x 0 inverse, as LUInverse
+    /// returns. Returns false only when the input is too large, so the caller falls back to the
+    /// general algorithm.
+    static bool calculateFixedInverse(const BasicComplexMatrix<T>& matrix, InverseAlgorithm algorithm, BasicComplexMatrix<T>& inverse);
+
+    /// @brief Inverts square matrices whose band (kl + ku + 1) is at most a quarter of the order
+    /// through BandedLUFactorization in O(n^2 * (kl + ku)). Returns false when the input is not
+    /// narrow-banded or the band factorization meets a zero pivot column.
+    static bool calculateBandedInverse(const BasicComplexMatrix<T>& matrix, BasicComplexMatrix<T>& inverse);
+
+    /// @brief Inverts matrices flagged Hermitian (see ComplexMatrix::isHermitian) through
+    /// CholeskyFactorization, at half the factorization work of LU. The flag is confirmed first by
+    /// an O(n^2) exact comparison with the conjugate transpose. The parallel algorithms solve on
+    /// the threads of the active TuningProfile. Returns false when the matrix is not flagged, not
+    /// exactly Hermitian or not positive definite, so the caller falls back to the general algorithm.
+    static bool calculateCholeskyInverse(const BasicComplexMatrix<T>& matrix, InverseAlgorithm algorithm, BasicComplexMatrix<T>& inverse);
+
 public:
-    static ComplexMatrix calculateInverse(const ComplexMatrix& matrix, InverseAlgorithm algorithm);
+    /// @brief The inverse of matrix by the given algorithm, or a 0 x 0 matrix when the LU
+    /// algorithms or the fixed-size kernels find it singular.
+    static BasicComplexMatrix<T> calculateInverse(const BasicComplexMatrix<T>& matrix, InverseAlgorithm algorithm);
 };
+
+using MatrixInverseFactory = BasicMatrixInverseFactory<double>;
@@ -0,0 +1,278 @@
+#include "MortonComplexMatrix.h"
+#include "ThreadPool.h"
+#include "TuningProfile.h"
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+namespace {
+    /// @brief Conversions of smaller matrices stay on the calling thread.
+    constexpr long long PARALLEL_THRESHOLD = 1 << 16;
+}
+
+template <typename T>
+BasicMortonComplexMatrix<T>::BasicMortonComplexMatrix(int rows, int columns, int tile, int levels)
+    : rows(rows), columns(columns), tile(tile), levels(levels), elements(nullptr), allocator(nullptr)
+{
+    assert(tile > 0 && levels >= 0);
+    assert(rows <= getSide() && columns <= getSide());
+    allocate();
+}
+
+template <typename T>
+BasicMortonComplexMatrix<T>::BasicMortonComplexMatrix(const BasicMortonComplexMatrix<T>& copy)
+    : rows(copy.rows), columns(copy.columns), tile(copy.tile), levels(copy.levels), elements(nullptr), allocator(nullptr)
+{
+    allocate();
+    std::copy_n(copy.elements, storageBytes() / sizeof(BasicComplexNum<T>), elements);
+}
+
+template <typename T>
+BasicMortonComplexMatrix<T>::BasicMortonComplexMatrix(BasicMortonComplexMatrix<T>&& other) noexcept
+    : rows(other.rows), columns(other.columns), tile(other.tile), levels(other.levels),
+    elements(other.elements), allocator(other.allocator)
+{
+    other.elements = nullptr;
+    other.allocator = nullptr;
+    other.rows = 0;
+    other.columns = 0;
+    other.tile = 1;
+    other.levels = 0;
+}
+
+template <typename T>
+BasicMortonComplexMatrix<T>::~BasicMortonComplexMatrix()
+{
+    release();
+}
+
+template <typename T>
+BasicMortonComplexMatrix<T>& BasicMortonComplexMatrix<T>::operator =(const BasicMortonComplexMatrix<T>& copy)
+{
+    if (this != &copy)
+    {
+        if (tile != copy.tile || levels != copy.levels)
+        {
+            release();
+            tile = copy.tile;
+            levels = copy.levels;
+            allocate();
+        }
+        rows = copy.rows;
+        columns = copy.columns;
+        std::copy_n(copy.elements, storageBytes() / sizeof(BasicComplexNum<T>), elements);
+    }
+    return *this;
+}
+
+template <typename T>
+BasicMortonComplexMatrix<T>& BasicMortonComplexMatrix<T>::operator =(BasicMortonComplexMatrix<T>&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        std::swap(rows, other.rows);
+        std::swap(columns, other.columns);
+        std::swap(tile, other.tile);
+        std::swap(levels, other.levels);
+        std::swap(elements, other.elements);
+        std::swap(allocator, other.allocator);
+    }
+    return *this;
+}
+
+template <typename T>
+std::size_t BasicMortonComplexMatrix<T>::storageBytes() const
+{
+    return static_cast<std::size_t>(getSide()) * getSide() * sizeof(BasicComplexNum<T>);
+}
+
+template <typename T>
+void BasicMortonComplexMatrix<T>::allocate()
+{
+    allocator = &MatrixAllocator::current();
+    const std::size_t bytes = storageBytes();
+    elements = static_cast<BasicComplexNum<T>*>(allocator->allocate(bytes));
+    // The padding must read as zero; fresh mappings already do.
+    if (!allocator->zeroFilled(bytes))
+        std::uninitialized_fill_n(elements, bytes / sizeof(BasicComplexNum<T>), BasicComplexNum<T>());
+}
+
+template <typename T>
+void BasicMortonComplexMatrix<T>::release()
+{
+    if (elements)
+        allocator->deallocate(elements, storageBytes());
+    elements = nullptr;
+    allocator = nullptr;
+}
+
+template <typename T>
+void BasicMortonComplexMatrix<T>::shapeFor(int dimension, int leafLimit, int& tile, int& levels)
+{
+    dimension = std::max(1, dimension);
+    leafLimit = std::max(1, leafLimit);
+    levels = 0;
+    tile = dimension;
+    while (tile > leafLimit)
+    {
+        levels++;
+        tile = (dimension + (1 << levels) - 1) >> levels;
+    }
+}
+
+template <typename T>
+std::size_t BasicMortonComplexMatrix<T>::leafOffset(int tileRow, int tileColumn) const
+{
+    std::size_t index = 0;
+    for (int bit = 0; bit < levels; bit++)
+    {
+        index |= static_cast<std::size_t>((tileColumn >> bit) & 1) << (2 * bit);
+        index |= static_cast<std::size_t>((tileRow >> bit) & 1) << (2 * bit + 1);
+    }
+    return index * tile * tile;
+}
+
+template <typename T>
+template <typename Copy>
+void BasicMortonComplexMatrix<T>::forEachLeaf(Copy copy) const
+{
+    const int tileRows = (rows + tile - 1) / tile;
+    const int tileColumns = (columns + tile - 1) / tile;
+    auto leaf = [&](int k) {
+        copy(k / tileColumns, k % tileColumns);
+    };
+
+    const int count = tileRows * tileColumns;
+    if (static_cast<long long>(rows) * columns < PARALLEL_THRESHOLD || count <= 1)
+    {
+        for (int k = 0; k < count; k++)
+            leaf(k);
+        return;
+    }
+    ThreadPool::shared().parallelFor(count, leaf, TuningProfile::active().threadCount());
+}
+
+template <typename T>
+BasicMortonComplexMatrix<T> BasicMortonComplexMatrix<T>::fromMatrix(const BasicComplexMatrix<T>& matrix, int tile, int levels)
+{
+    BasicMortonComplexMatrix<T> result(matrix.getRows(), matrix.getColumns(), tile, levels);
+    result.forEachLeaf([&](int tileRow, int tileColumn) {
+        BasicComplexNum<T>* leaf = result.elements + result.leafOffset(tileRow, tileColumn);
+        const int firstColumn = tileColumn * tile;
+        const int width = std::min(tile, matrix.getColumns() - firstColumn);
+        const int height = std::min(tile, matrix.getRows() - tileRow * tile);
+        for (int r = 0; r < height; r++)
+        {
+            const int i = tileRow * tile + r;
+            BasicComplexNum<T>* out = leaf + static_cast<std::size_t>(r) * tile;
+            if (matrix.getLayout() == StorageLayout::Split)
+            {
+                const T* re = matrix.realRow(i) + firstColumn;
+                const T* im = matrix.imagRow(i) + firstColumn;
+                for (int j = 0; j < width; j++)
+                    out[j] = BasicComplexNum<T>(re[j], im[j]);
+            }
+            else
+                std::copy_n(matrix.row(i) + firstColumn, width, out);
+        }
+    });
+    return result;
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicMortonComplexMatrix<T>::toMatrix(StorageLayout layout) const
+{
+    BasicComplexMatrix<T> result(rows, columns, layout);
+    forEachLeaf([&](int tileRow, int tileColumn) {
+        const BasicComplexNum<T>* leaf = elements + leafOffset(tileRow, tileColumn);
+        const int firstColumn = tileColumn * tile;
+        const int width = std::min(tile, columns - firstColumn);
+        const int height = std::min(tile, rows - tileRow * tile);
+        for (int r = 0; r < height; r++)
+        {
+            const int i = tileRow * tile + r;
+            const BasicComplexNum<T>* in = leaf + static_cast<std::size_t>(r) * tile;
+            if (layout == StorageLayout::Split)
+            {
+                T* re = result.realRow(i) + firstColumn;
+                T* im = result.imagRow(i) + firstColumn;
+                for (int j = 0; j < width; j++)
+                {
+                    re[j] = in[j].getReal();
+                    im[j] = in[j].getImag();
+                }
+            }
+            else
+                std::copy_n(in, width, result.row(i) + firstColumn);
+        }
+    });
+    return result;
+}
+
+template <typename T>
+int BasicMortonComplexMatrix<T>::getRows() const
+{
+    return rows;
+}
+
+template <typename T>
+int BasicMortonComplexMatrix<T>::getColumns() const
+{
+    return columns;
+}
+
+template <typename T>
+int BasicMortonComplexMatrix<T>::getTile() const
+{
+    return tile;
+}
+
+template <typename T>
+int BasicMortonComplexMatrix<T>::getLevels() const
+{
+    return levels;
+}
+
+template <typename T>
+int BasicMortonComplexMatrix<T>::getSide() const
+{
+    return tile << levels;
+}
+
+template <typename T>
+std::size_t BasicMortonComplexMatrix<T>::quarterSize(int level) const
+{
+    assert(level >= 1);
+    return static_cast<std::size_t>(tile) * tile << (2 * (level - 1));
+}
+
+template <typename T>
+BasicComplexNum<T>* BasicMortonComplexMatrix<T>::data()
+{
+    return elements;
+}
+
+template <typename T>
+const BasicComplexNum<T>* BasicMortonComplexMatrix<T>::data() const
+{
+    return elements;
+}
+
+template <typename T>
+BasicComplexNum<T> BasicMortonComplexMatrix<T>::get(int i, int j) const
+{
+    assert(i >= 0 && i < getSide() && j >= 0 && j < getSide());
+    return elements[leafOffset(i / tile, j / tile) + static_cast<std::size_t>(i % tile) * tile + j % tile];
+}
+
+template <typename T>
+void BasicMortonComplexMatrix<T>::set(int i, int j, BasicComplexNum<T> num)
+{
+    assert(i >= 0 && i < getSide() && j >= 0 && j < getSide());
+    elements[leafOffset(i / tile, j / tile) + static_cast<std::size_t>(i % tile) * tile + j % tile] = num;
+}
+
+template class BasicMortonComplexMatrix<float>;
+template class BasicMortonComplexMatrix<double>;
+template class BasicMortonComplexMatrix<long double>;
@@ -0,0 +1,92 @@
+#pragma once
+#include "ComplexMatrix.h"
+#include <cstddef>
+
+/// @brief Complex matrix in recursive block (Morton, Z-order) layout for Strassen.
+/// The matrix is zero-padded to a square of side tile * 2^levels and cut into tile x tile leaves,
+/// each stored row-major and contiguous. Leaves follow the Z curve: a block splits into its
+/// top-left, top-right, bottom-left and bottom-right quadrants, stored one after the other, and
+/// every quadrant splits the same way down to the leaves. So at every level a quadrant is one
+/// contiguous run of quarterSize(level) elements starting quadrant * quarterSize(level) past its
+/// block, and the sum of two quadrants is a flat loop over two arrays. Storage comes from
+/// MatrixAllocator::current(), like ComplexMatrix's, so it is aligned and follows its page policy.
+template <typename T>
+class BasicMortonComplexMatrix
+{
+private:
+    int rows;
+    int columns;
+    int tile;
+    int levels;
+    BasicComplexNum<T>* elements;
+    MatrixAllocator* allocator;
+
+    /// @brief Takes a zeroed buffer for the padded square from MatrixAllocator::current().
+    void allocate();
+
+    /// @brief Returns the buffer to the allocator it came from.
+    void release();
+
+    /// @brief Bytes of the padded square, as passed to the allocator.
+    std::size_t storageBytes() const;
+
+    /// @brief First element of leaf (tileRow, tileColumn), whose position on the Z curve
+    /// interleaves the bits of the two indices.
+    std::size_t leafOffset(int tileRow, int tileColumn) const;
+
+    /// @brief Runs copy(tileRow, tileColumn) for every leaf that overlaps the unpadded matrix,
+    /// split across the shared ThreadPool when the matrix is large.
+    template <typename Copy>
+    void forEachLeaf(Copy copy) const;
+
+public:
+    /// @brief A zero rows x columns matrix; tile * 2^levels must cover both dimensions.
+    BasicMortonComplexMatrix(int rows = 0, int columns = 0, int tile = 1, int levels = 0);
+
+    BasicMortonComplexMatrix(const BasicMortonComplexMatrix& copy);
+
+    BasicMortonComplexMatrix(BasicMortonComplexMatrix&& other) noexcept;
+
+    ~BasicMortonComplexMatrix();
+
+    BasicMortonComplexMatrix& operator =(const BasicMortonComplexMatrix& copy);
+
+    BasicMortonComplexMatrix& operator =(BasicMortonComplexMatrix&& other) noexcept;
+
+    /// @brief Smallest levels for which a leaf of side ceil(dimension / 2^levels) is at most
+    /// leafLimit, and that leaf side as tile.
+    static void shapeFor(int dimension, int leafLimit, int& tile, int& levels);
+
+    /// @brief Copies a dense matrix of either layout into the given shape, one leaf per task.
+    static BasicMortonComplexMatrix fromMatrix(const BasicComplexMatrix<T>& matrix, int tile, int levels);
+
+    /// @brief The unpadded matrix in row-major storage, one leaf per task.
+    BasicComplexMatrix<T> toMatrix(StorageLayout layout = StorageLayout::Interleaved) const;
+
+    int getRows() const;
+
+    int getColumns() const;
+
+    int getTile() const;
+
+    int getLevels() const;
+
+    /// @brief Side of the padded square, tile * 2^levels.
+    int getSide() const;
+
+    /// @brief Elements in one quadrant of a block level levels above the leaves: tile^2 * 4^(level - 1).
+    std::size_t quarterSize(int level) const;
+
+    BasicComplexNum<T>* data();
+
+    const BasicComplexNum<T>* data() const;
+
+    /// @brief Element (i, j) of the padded square; zero in the padding.
+    BasicComplexNum<T> get(int i, int j) const;
+
+    void set(int i, int j, BasicComplexNum<T> num);
+};
+
+using MortonComplexMatrix = BasicMortonComplexMatrix<double>;
+using MortonComplexMatrixF = BasicMortonComplexMatrix<float>;
+using MortonComplexMatrixL = BasicMortonComplexMatrix<long double>;
@@ -0,0 +1,13 @@
+#pragma once
+
+/// @brief How a complex matrix product is built from real arithmetic.
+enum class MultiplyMode {
+    /// @brief Four real products per complex product: Cr = ArBr - AiBi, Ci = ArBi + AiBr.
+    Classic,
+    /// @brief 3M (Karatsuba): three real products P1 = ArBr, P2 = AiBi, P3 = (Ar + Ai)(Br + Bi),
+    /// then Cr = P1 - P2 and Ci = P3 - P1 - P2, saving a quarter of the multiply flops.
+    /// The result is normwise as accurate as Classic up to a small constant, but not
+    /// componentwise: Ci comes from cancelling terms of size |A||B|, so an imaginary part much
+    /// smaller than that loses relative accuracy (exact on integer-valued data that fits).
+    ThreeM
+};
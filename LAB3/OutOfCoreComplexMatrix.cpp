@@ -0,0 +1,312 @@
+#include "OutOfCoreComplexMatrix.h"
+#include "ComplexGemm.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char TILE_FILE_MAGIC[8] = { 'C', 'M', 'X', 'T', 'I', 'L', 'E', '1' };
+
+    struct TileFileHeader {
+        char magic[8];
+        std::uint32_t scalarBytes;
+        std::uint32_t tileSize;
+        std::int64_t rows;
+        std::int64_t columns;
+        std::uint64_t tileStride;
+    };
+
+    std::size_t roundUp(std::size_t bytes, std::size_t multiple)
+    {
+        return (bytes + multiple - 1) / multiple * multiple;
+    }
+}
+
+template <typename T>
+BasicOutOfCoreComplexMatrix<T>::BasicOutOfCoreComplexMatrix()
+    : fd(-1), mapping(nullptr), mappingBytes(0), rows(0), columns(0), tileSize(0),
+    tileRows(0), tileColumns(0), tileStride(0) {}
+
+template <typename T>
+void BasicOutOfCoreComplexMatrix<T>::map(const std::string& path, bool create)
+{
+#ifdef __linux__
+    fd = ::open(path.c_str(), create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open matrix file " + path);
+
+    TileFileHeader header;
+    if (create)
+    {
+        std::memcpy(header.magic, TILE_FILE_MAGIC, sizeof(header.magic));
+        header.scalarBytes = sizeof(T);
+        header.tileSize = tileSize;
+        header.rows = rows;
+        header.columns = columns;
+        header.tileStride = tileStride;
+    }
+    else if (::pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+        || std::memcmp(header.magic, TILE_FILE_MAGIC, sizeof(header.magic)) != 0
+        || header.scalarBytes != sizeof(T))
+    {
+        release();
+        throw std::runtime_error("Not a tiled matrix file of this scalar type: " + path);
+    }
+
+    rows = static_cast<int>(header.rows);
+    columns = static_cast<int>(header.columns);
+    tileSize = static_cast<int>(header.tileSize);
+    tileStride = header.tileStride;
+    tileRows = (rows + tileSize - 1) / tileSize;
+    tileColumns = (columns + tileSize - 1) / tileSize;
+    mappingBytes = HEADER_BYTES + static_cast<std::size_t>(tileRows) * tileColumns * tileStride;
+
+    if (create && ::ftruncate(fd, static_cast<off_t>(mappingBytes)) != 0)
+    {
+        release();
+        throw std::runtime_error("Cannot size matrix file " + path);
+    }
+
+    void* address = ::mmap(nullptr, mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+        mappingBytes = 0;
+        release();
+        throw std::runtime_error("Cannot map matrix file " + path);
+    }
+    mapping = static_cast<char*>(address);
+    if (create)
+        std::memcpy(mapping, &header, sizeof(header));
+#else
+    (void)path;
+    (void)create;
+    throw std::runtime_error("Out-of-core matrices need POSIX mmap");
+#endif
+}
+
+template <typename T>
+void BasicOutOfCoreComplexMatrix<T>::release()
+{
+#ifdef __linux__
+    if (mapping)
+    {
+        ::msync(mapping, mappingBytes, MS_SYNC);
+        ::munmap(mapping, mappingBytes);
+    }
+    if (fd >= 0)
+        ::close(fd);
+#endif
+    mapping = nullptr;
+    mappingBytes = 0;
+    fd = -1;
+}
+
+template <typename T>
+char* BasicOutOfCoreComplexMatrix<T>::tileAddress(int ti, int tj) const
+{
+    assert(ti >= 0 && ti < tileRows && tj >= 0 && tj < tileColumns);
+    return mapping + HEADER_BYTES + (static_cast<std::size_t>(ti) * tileColumns + tj) * tileStride;
+}
+
+template <typename T>
+BasicOutOfCoreComplexMatrix<T> BasicOutOfCoreComplexMatrix<T>::create(const std::string& path, int rows, int columns, int tileSize)
+{
+    assert(rows >= 0 && columns >= 0 && tileSize > 0);
+
+    BasicOutOfCoreComplexMatrix<T> result;
+    result.rows = rows;
+    result.columns = columns;
+    result.tileSize = tileSize;
+    // Tiles start on page boundaries so every hint covers whole pages of exactly one tile.
+    result.tileStride = roundUp(static_cast<std::size_t>(tileSize) * tileSize * sizeof(BasicComplexNum<T>), HEADER_BYTES);
+    result.map(path, true);
+    return result;
+}
+
+template <typename T>
+BasicOutOfCoreComplexMatrix<T> BasicOutOfCoreComplexMatrix<T>::open(const std::string& path)
+{
+    BasicOutOfCoreComplexMatrix<T> result;
+    result.map(path, false);
+    return result;
+}
+
+template <typename T>
+BasicOutOfCoreComplexMatrix<T> BasicOutOfCoreComplexMatrix<T>::fromMatrix(const std::string& path, const BasicComplexMatrix<T>& matrix, int tileSize)
+{
+    BasicOutOfCoreComplexMatrix<T> result = create(path, matrix.getRows(), matrix.getColumns(), tileSize);
+    for (int i = 0; i < matrix.getRows(); i++)
+        for (int j = 0; j < matrix.getColumns(); j++)
+            result.at(i, j) = matrix.get(i, j);
+    return result;
+}
+
+template <typename T>
+BasicOutOfCoreComplexMatrix<T>::BasicOutOfCoreComplexMatrix(BasicOutOfCoreComplexMatrix<T>&& other) noexcept
+    : fd(std::exchange(other.fd, -1)), mapping(std::exchange(other.mapping, nullptr)),
+    mappingBytes(std::exchange(other.mappingBytes, 0)), rows(other.rows), columns(other.columns),
+    tileSize(other.tileSize), tileRows(other.tileRows), tileColumns(other.tileColumns), tileStride(other.tileStride) {}
+
+template <typename T>
+BasicOutOfCoreComplexMatrix<T>& BasicOutOfCoreComplexMatrix<T>::operator =(BasicOutOfCoreComplexMatrix<T>&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        fd = std::exchange(other.fd, -1);
+        mapping = std::exchange(other.mapping, nullptr);
+        mappingBytes = std::exchange(other.mappingBytes, 0);
+        rows = other.rows;
+        columns = other.columns;
+        tileSize = other.tileSize;
+        tileRows = other.tileRows;
+        tileColumns = other.tileColumns;
+        tileStride = other.tileStride;
+    }
+    return *this;
+}
+
+template <typename T>
+BasicOutOfCoreComplexMatrix<T>::~BasicOutOfCoreComplexMatrix()
+{
+    release();
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicOutOfCoreComplexMatrix<T>::toMatrix() const
+{
+    BasicComplexMatrix<T> result(rows, columns);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            result.set(i, j, at(i, j));
+    return result;
+}
+
+template <typename T>
+int BasicOutOfCoreComplexMatrix<T>::getRows() const
+{
+    return rows;
+}
+
+template <typename T>
+int BasicOutOfCoreComplexMatrix<T>::getColumns() const
+{
+    return columns;
+}
+
+template <typename T>
+int BasicOutOfCoreComplexMatrix<T>::getTileSize() const
+{
+    return tileSize;
+}
+
+template <typename T>
+int BasicOutOfCoreComplexMatrix<T>::getTileRows() const
+{
+    return tileRows;
+}
+
+template <typename T>
+int BasicOutOfCoreComplexMatrix<T>::getTileColumns() const
+{
+    return tileColumns;
+}
+
+template <typename T>
+BasicComplexNum<T> BasicOutOfCoreComplexMatrix<T>::get(int i, int j) const
+{
+    assert(i >= 0 && i < rows && j >= 0 && j < columns);
+    return at(i, j);
+}
+
+template <typename T>
+void BasicOutOfCoreComplexMatrix<T>::set(int i, int j, BasicComplexNum<T> num)
+{
+    assert(i >= 0 && i < rows && j >= 0 && j < columns);
+    at(i, j) = num;
+}
+
+template <typename T>
+BasicComplexMatrixView<T> BasicOutOfCoreComplexMatrix<T>::tile(int ti, int tj) const
+{
+    int backedRows = std::min(tileSize, rows - ti * tileSize);
+    int backedColumns = std::min(tileSize, columns - tj * tileSize);
+    BasicComplexMatrixView<T> backed(reinterpret_cast<BasicComplexNum<T>*>(tileAddress(ti, tj)), backedRows, backedColumns, tileSize);
+    return backed.block(0, 0, tileSize, tileSize);
+}
+
+template <typename T>
+void BasicOutOfCoreComplexMatrix<T>::prefetch(int ti, int tj) const
+{
+#ifdef __linux__
+    if (ti < tileRows && tj < tileColumns)
+        ::madvise(tileAddress(ti, tj), tileStride, MADV_WILLNEED);
+#else
+    (void)ti;
+    (void)tj;
+#endif
+}
+
+template <typename T>
+void BasicOutOfCoreComplexMatrix<T>::evict(int ti, int tj, bool dirty) const
+{
+#ifdef __linux__
+    char* address = tileAddress(ti, tj);
+    if (dirty)
+        ::msync(address, tileStride, MS_ASYNC);
+    // Shared file pages keep their data in the page cache after MADV_DONTNEED; fadvise then lets
+    // the kernel reclaim them once written back instead of pushing out tiles still in use.
+    ::madvise(address, tileStride, MADV_DONTNEED);
+    ::posix_fadvise(fd, static_cast<off_t>(address - mapping), static_cast<off_t>(tileStride), POSIX_FADV_DONTNEED);
+#else
+    (void)ti;
+    (void)tj;
+    (void)dirty;
+#endif
+}
+
+template <typename T>
+void BasicOutOfCoreComplexMatrix<T>::flush() const
+{
+#ifdef __linux__
+    if (mapping)
+        ::msync(mapping, mappingBytes, MS_SYNC);
+#endif
+}
+
+template <typename T>
+void BasicOutOfCoreComplexMatrix<T>::multiply(const BasicOutOfCoreComplexMatrix<T>& a, const BasicOutOfCoreComplexMatrix<T>& b, BasicOutOfCoreComplexMatrix<T>& c)
+{
+    assert(a.columns == b.rows && c.rows == a.rows && c.columns == b.columns);
+    assert(a.tileSize == b.tileSize && b.tileSize == c.tileSize);
+
+    for (int ti = 0; ti < c.tileRows; ti++)
+    {
+        for (int tj = 0; tj < c.tileColumns; tj++)
+        {
+            BasicComplexMatrixView<T> target = c.tile(ti, tj);
+            for (int tk = 0; tk < a.tileColumns; tk++)
+            {
+                a.prefetch(ti, tk + 1);
+                b.prefetch(tk + 1, tj);
+                BasicComplexGemm<T>::multiply(a.tile(ti, tk), b.tile(tk, tj), target, tk > 0);
+                b.evict(tk, tj, false);
+            }
+            c.evict(ti, tj, true);
+        }
+        for (int tk = 0; tk < a.tileColumns; tk++)
+            a.evict(ti, tk, false);
+    }
+}
+
+template class BasicOutOfCoreComplexMatrix<float>;
+template class BasicOutOfCoreComplexMatrix<double>;
+template class BasicOutOfCoreComplexMatrix<long double>;
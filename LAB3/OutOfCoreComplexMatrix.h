@@ -0,0 +1,105 @@
+#pragma once
+#include "ComplexMatrix.h"
+#include "ComplexMatrixView.h"
+#include <cstddef>
+#include <string>
+
+/// @brief Disk-backed complex matrix for inputs larger than RAM.
+/// The file holds a one-page header followed by tileSize x tileSize tiles in row-major tile
+/// order; each tile is row-major inside, zero-padded at the right and bottom edges, and starts on
+/// a page boundary. The whole file is mapped shared, so the kernel pages tiles in on demand and
+/// writes them back; prefetch() and evict() turn the engines' access order into madvise hints so
+/// a sweep over a matrix keeps only its working set resident instead of thrashing.
+/// Requires POSIX mmap; elsewhere create() and open() throw std::runtime_error.
+template <typename T>
+class BasicOutOfCoreComplexMatrix
+{
+private:
+    int fd;
+    char* mapping;
+    std::size_t mappingBytes;
+    int rows;
+    int columns;
+    int tileSize;
+    int tileRows;
+    int tileColumns;
+    std::size_t tileStride;
+
+    BasicOutOfCoreComplexMatrix();
+
+    void map(const std::string& path, bool create);
+
+    void release();
+
+    char* tileAddress(int ti, int tj) const;
+
+public:
+    static constexpr std::size_t HEADER_BYTES = 4096;
+
+    static constexpr int DEFAULT_TILE_SIZE = 256;
+
+    /// @brief Creates (or truncates) a zero-filled file for a rows x columns matrix.
+    static BasicOutOfCoreComplexMatrix create(const std::string& path, int rows, int columns, int tileSize = DEFAULT_TILE_SIZE);
+
+    /// @brief Maps an existing file written by create().
+    static BasicOutOfCoreComplexMatrix open(const std::string& path);
+
+    /// @brief Writes an in-memory matrix to a new file.
+    static BasicOutOfCoreComplexMatrix fromMatrix(const std::string& path, const BasicComplexMatrix<T>& matrix, int tileSize = DEFAULT_TILE_SIZE);
+
+    BasicOutOfCoreComplexMatrix(const BasicOutOfCoreComplexMatrix&) = delete;
+
+    BasicOutOfCoreComplexMatrix& operator =(const BasicOutOfCoreComplexMatrix&) = delete;
+
+    BasicOutOfCoreComplexMatrix(BasicOutOfCoreComplexMatrix&& other) noexcept;
+
+    BasicOutOfCoreComplexMatrix& operator =(BasicOutOfCoreComplexMatrix&& other) noexcept;
+
+    /// @brief Flushes dirty tiles and unmaps the file.
+    ~BasicOutOfCoreComplexMatrix();
+
+    BasicComplexMatrix<T> toMatrix() const;
+
+    int getRows() const;
+
+    int getColumns() const;
+
+    int getTileSize() const;
+
+    int getTileRows() const;
+
+    int getTileColumns() const;
+
+    /// @brief Reference to element (i, j) inside its mapped tile.
+    BasicComplexNum<T>& at(int i, int j) const
+    {
+        char* tile = tileAddress(i / tileSize, j / tileSize);
+        return reinterpret_cast<BasicComplexNum<T>*>(tile)[static_cast<std::size_t>(i % tileSize) * tileSize + j % tileSize];
+    }
+
+    BasicComplexNum<T> get(int i, int j) const;
+
+    void set(int i, int j, BasicComplexNum<T> num);
+
+    /// @brief tileSize x tileSize view of tile (ti, tj) whose backed extent is clipped at the matrix edge.
+    BasicComplexMatrixView<T> tile(int ti, int tj) const;
+
+    /// @brief Asks the kernel to start reading tile (ti, tj) (MADV_WILLNEED).
+    void prefetch(int ti, int tj) const;
+
+    /// @brief Drops tile (ti, tj) from memory (MADV_DONTNEED plus POSIX_FADV_DONTNEED); dirty
+    /// tiles are scheduled for write-back first so nothing is lost.
+    void evict(int ti, int tj, bool dirty) const;
+
+    /// @brief Writes all dirty tiles back to the file.
+    void flush() const;
+
+    /// @brief c = a * b one tile product at a time. A row panel of a stays resident while the tiles
+    /// of b stream through, the next pair of tiles is prefetched during each product, and finished
+    /// tiles of c are written back and evicted. All three must share one tile size.
+    static void multiply(const BasicOutOfCoreComplexMatrix& a, const BasicOutOfCoreComplexMatrix& b, BasicOutOfCoreComplexMatrix& c);
+};
+
+using OutOfCoreComplexMatrixF = BasicOutOfCoreComplexMatrix<float>;
+using OutOfCoreComplexMatrix = BasicOutOfCoreComplexMatrix<double>;
+using OutOfCoreComplexMatrixL = BasicOutOfCoreComplexMatrix<long double>;
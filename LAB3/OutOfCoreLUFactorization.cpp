@@ -0,0 +1,181 @@
+#include "OutOfCoreLUFactorization.h"
+#include <algorithm>
+
+namespace {
+    template <typename T>
+    T magnitude(const BasicComplexNum<T>& value)
+    {
+        return std::abs(value.getReal()) + std::abs(value.getImag());
+    }
+}
+
+template <typename T>
+BasicOutOfCoreLUFactorization<T>::BasicOutOfCoreLUFactorization(BasicOutOfCoreComplexMatrix<T>& matrix)
+    : lu(matrix), pivots(matrix.getRows()), invertible(false)
+{
+    assert(matrix.getRows() == matrix.getColumns());
+
+    const int t = lu.getTileSize();
+    const int tiles = lu.getTileRows();
+    BasicComplexMatrix<T> scratch(t, t);
+    BasicComplexMatrixView<T> product(scratch);
+
+    for (int k = 0; k < tiles; k++)
+    {
+        if (!factorizePanel(k))
+            return;
+
+        for (int j = k + 1; j < tiles; j++)
+        {
+            lu.prefetch(k, j + 1);
+            solveRowTile(k, j);
+        }
+
+        for (int i = k + 1; i < tiles; i++)
+        {
+            BasicComplexMatrixView<T> multipliers = lu.tile(i, k);
+            for (int j = k + 1; j < tiles; j++)
+            {
+                lu.prefetch(i, j + 1);
+                BasicComplexMatrixView<T>::multiply(multipliers, lu.tile(k, j), product);
+                BasicComplexMatrixView<T> target = lu.tile(i, j);
+                BasicComplexMatrixView<T>::subtract(target, product, target);
+                lu.evict(i, j, true);
+            }
+            lu.evict(i, k, true);
+        }
+        for (int j = k; j < tiles; j++)
+            lu.evict(k, j, true);
+    }
+
+    invertible = true;
+}
+
+template <typename T>
+bool BasicOutOfCoreLUFactorization<T>::factorizePanel(int k)
+{
+    const int n = lu.getRows();
+    const int t = lu.getTileSize();
+    const int first = k * t;
+    const int last = std::min(n, first + t);
+
+    for (int c = first; c < last; c++)
+    {
+        int pivot = c;
+        T best = magnitude(lu.at(c, c));
+        for (int i = c + 1; i < n; i++)
+        {
+            if (i % t == 0)
+                lu.prefetch(i / t + 1, k);
+            T candidate = magnitude(lu.at(i, c));
+            if (candidate > best)
+            {
+                best = candidate;
+                pivot = i;
+            }
+        }
+
+        pivots[c] = pivot;
+        if (lu.at(pivot, c).isNull())
+            return false;
+        if (pivot != c)
+            for (int j = 0; j < n; j++)
+                std::swap(lu.at(c, j), lu.at(pivot, j));
+
+        const BasicComplexNum<T> diagonal = lu.at(c, c);
+        for (int i = c + 1; i < n; i++)
+        {
+            BasicComplexNum<T>& multiplier = lu.at(i, c);
+            multiplier = multiplier / diagonal;
+            if (multiplier.isNull())
+                continue;
+            for (int j = c + 1; j < last; j++)
+                lu.at(i, j).subtractProduct(multiplier, lu.at(c, j));
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void BasicOutOfCoreLUFactorization<T>::solveRowTile(int k, int j)
+{
+    BasicComplexMatrixView<T> diagonal = lu.tile(k, k);
+    BasicComplexMatrixView<T> target = lu.tile(k, j);
+    const int height = diagonal.getValidRows();
+    const int width = target.getValidColumns();
+
+    for (int c = 0; c < height; c++)
+    {
+        const BasicComplexNum<T>* source = target.row(c);
+        for (int r = c + 1; r < height; r++)
+        {
+            const BasicComplexNum<T> multiplier = diagonal.row(r)[c];
+            if (multiplier.isNull())
+                continue;
+            BasicComplexNum<T>* row = target.row(r);
+            for (int col = 0; col < width; col++)
+                row[col].subtractProduct(multiplier, source[col]);
+        }
+    }
+}
+
+template <typename T>
+bool BasicOutOfCoreLUFactorization<T>::isInvertible() const
+{
+    return invertible;
+}
+
+template <typename T>
+const std::vector<int>& BasicOutOfCoreLUFactorization<T>::getPivots() const
+{
+    return pivots;
+}
+
+template <typename T>
+void BasicOutOfCoreLUFactorization<T>::solve(BasicComplexNum<T>* vector) const
+{
+    assert(invertible);
+
+    const int n = lu.getRows();
+    const int t = lu.getTileSize();
+    const int tiles = lu.getTileRows();
+
+    for (int c = 0; c < n; c++)
+        if (pivots[c] != c)
+            std::swap(vector[c], vector[pivots[c]]);
+
+    for (int ti = 0; ti < tiles; ti++)
+    {
+        for (int tj = 0; tj <= ti; tj++)
+            lu.prefetch(ti + 1, tj);
+        for (int i = ti * t; i < std::min(n, (ti + 1) * t); i++)
+        {
+            BasicComplexNum<T> toAdd = vector[i];
+            for (int j = 0; j < i; j++)
+                toAdd.subtractProduct(lu.at(i, j), vector[j]);
+            vector[i] = toAdd;
+        }
+        for (int tj = 0; tj <= ti; tj++)
+            lu.evict(ti, tj, false);
+    }
+
+    for (int ti = tiles - 1; ti >= 0; ti--)
+    {
+        if (ti > 0)
+            for (int tj = ti - 1; tj < tiles; tj++)
+                lu.prefetch(ti - 1, tj);
+        for (int i = std::min(n, (ti + 1) * t) - 1; i >= ti * t; i--)
+        {
+            BasicComplexNum<T> toAdd = vector[i];
+            for (int j = i + 1; j < n; j++)
+                toAdd.subtractProduct(lu.at(i, j), vector[j]);
+            vector[i] = toAdd / lu.at(i, i);
+        }
+        for (int tj = ti; tj < tiles; tj++)
+            lu.evict(ti, tj, false);
+    }
+}
+
+template class BasicOutOfCoreLUFactorization<float>;
+template class BasicOutOfCoreLUFactorization<double>;
+template class BasicOutOfCoreLUFactorization<long double>;
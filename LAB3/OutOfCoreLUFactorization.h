@@ -0,0 +1,37 @@
+#pragma once
+#include "OutOfCoreComplexMatrix.h"
+#include <vector>
+
+/// @brief Right-looking tile LU with partial pivoting that overwrites a square out-of-core matrix
+/// with its packed factors (unit-lower L below the diagonal, U on and above), like LUFactorization.
+/// Step K factorizes tile column K as a tall panel, solves the tiles of tile row K against the
+/// panel's unit-lower block, and updates every trailing tile with one in-memory tile product.
+/// Each tile of the trailing matrix is read and written once per step, the next tile is
+/// prefetched while one is processed, and tiles are evicted as soon as a step is done with them.
+template <typename T>
+class BasicOutOfCoreLUFactorization
+{
+private:
+    BasicOutOfCoreComplexMatrix<T>& lu;
+    std::vector<int> pivots;
+    bool invertible;
+
+    /// @brief Unblocked LU of the tall panel in tile column k; row swaps are applied to whole rows.
+    bool factorizePanel(int k);
+
+    /// @brief Tile (k, j) = L_kk^-1 * tile (k, j) for the unit-lower diagonal block of panel k.
+    void solveRowTile(int k, int j);
+
+public:
+    /// @brief Factorizes matrix in place; it must stay alive while the factorization is used.
+    explicit BasicOutOfCoreLUFactorization(BasicOutOfCoreComplexMatrix<T>& matrix);
+
+    bool isInvertible() const;
+
+    const std::vector<int>& getPivots() const;
+
+    /// @brief Solves A * x = b in place, streaming the factors one tile row at a time.
+    void solve(BasicComplexNum<T>* vector) const;
+};
+
+using OutOfCoreLUFactorization = BasicOutOfCoreLUFactorization<double>;
@@ -1,7 +1,8 @@
 #include "ParallelGaussJordanInverse.h"
 /// @brief Constructs a ParallelGaussJordanInverse object with the specified matrix.
 /// @param matrix The input matrix for which to calculate the inverse.
-ParallelGaussJordanInverse::ParallelGaussJordanInverse(ComplexMatrix matrix) {
+template <typename T>
+BasicParallelGaussJordanInverse<T>::BasicParallelGaussJordanInverse(BasicComplexMatrix<T> matrix) {
     A = matrix;
     rank = A.getRows();
     columns = A.getColumns();
@@ -9,7 +10,7 @@ ParallelGaussJordanInverse::ParallelGaussJordanInverse(ComplexMatrix matrix) {
     assert(rank == columns);
     assert(rank == A.getRank());
 
-    tempMatrix = ComplexMatrix(rank, 2 * rank);
+    tempMatrix = BasicComplexMatrix<T>(rank, 2 * rank, StorageLayout::Split);
 
     // Setting the temp matrix
     for (int i = 0; i < rank; i++) {
@@ -17,20 +18,21 @@ ParallelGaussJordanInverse::ParallelGaussJordanInverse(ComplexMatrix matrix) {
             if (j < rank)
                 tempMatrix.set(i, j, A.get(i, j));
             if (j == (i + rank))
-                tempMatrix.set(i, j, ComplexNum(1, 0));
+                tempMatrix.set(i, j, BasicComplexNum<T>(1, 0));
         }
     }
 
     for (int i = 0; i < rank; i++) {
-        tempMatrix.set(i, i + rank, ComplexNum(1, 0));
+        tempMatrix.set(i, i + rank, BasicComplexNum<T>(1, 0));
     }
 }
 /// @brief Calculates the inverse of the input matrix using the Gauss-Jordan elimination algorithm in parallel.
 /// @return The calculated inverse matrix.
-ComplexMatrix ParallelGaussJordanInverse::calculateParallelGaussJordanInverse() {
+template <typename T>
+BasicComplexMatrix<T> BasicParallelGaussJordanInverse<T>::calculateParallelGaussJordanInverse() {
     for (int i = 0; i < rank; i++) {
         bool swapped = false;
-        while (tempMatrix.get(i, i) == ComplexNum(0, 0)) {
+        while (tempMatrix.get(i, i) == BasicComplexNum<T>(0, 0)) {
             tempMatrix.swapRows(i, i + 1);
             swapped = true;
         }
@@ -38,7 +40,7 @@ ComplexMatrix ParallelGaussJordanInverse::calculateParallelGaussJordanInverse()
             i = std::max(0, i - 1);
             continue;
         }
-        if (tempMatrix.get(i, i) == ComplexNum(0, 0))
+        if (tempMatrix.get(i, i) == BasicComplexNum<T>(0, 0))
             throw std::exception(); // Checking nulls on a principal diagonal
 
         std::vector<std::thread> threads;
@@ -46,12 +48,10 @@ ComplexMatrix ParallelGaussJordanInverse::calculateParallelGaussJordanInverse()
 
         for (int j = 0; j < rank; j++) {
             if (i != j) {
-                ComplexNum temp = tempMatrix.get(j, i) / tempMatrix.get(i, i);
+                BasicComplexNum<T> temp = tempMatrix.get(j, i) / tempMatrix.get(i, i);
 
                 threads.emplace_back([this, i, j, temp]() {
-                    for (int k = 0; k < 2 * rank; k++) {
-                        tempMatrix.set(j, k, tempMatrix.get(j, k) - tempMatrix.get(i, k) * temp);
-                    }
+                    tempMatrix.subtractRowMultiple(j, i, temp);
                     });
             }
         }
@@ -62,13 +62,10 @@ ComplexMatrix ParallelGaussJordanInverse::calculateParallelGaussJordanInverse()
     }
 
     for (int i = 0; i < rank; i++) {
-        ComplexNum temp = tempMatrix.get(i, i);
-        for (int j = 0; j < 2 * rank; j++) {
-            tempMatrix.set(i, j, tempMatrix.get(i, j) / temp);
-        }
+        tempMatrix.divideRow(i, tempMatrix.get(i, i));
     }
 
-    ComplexMatrix resMatrix(rank, rank);
+    BasicComplexMatrix<T> resMatrix(rank, rank);
 
     for (int i = 0; i < rank; i++) {
         for (int j = 0; j < rank; j++) {
@@ -78,3 +75,7 @@ ComplexMatrix ParallelGaussJordanInverse::calculateParallelGaussJordanInverse()
 
     return resMatrix;
 }
+
+template class BasicParallelGaussJordanInverse<float>;
+template class BasicParallelGaussJordanInverse<double>;
+template class BasicParallelGaussJordanInverse<long double>;
@@ -5,17 +5,19 @@
 #include <algorithm>
 #include <thread>
 
-class ParallelGaussJordanInverse {
+template <typename T>
+class BasicParallelGaussJordanInverse {
 private:
-    ComplexMatrix A; 
+    BasicComplexMatrix<T> A; 
     int rank;
     int columns; 
-    ComplexMatrix tempMatrix; 
+    BasicComplexMatrix<T> tempMatrix; 
     std::mutex mtx;
 
 public:
-    ParallelGaussJordanInverse(ComplexMatrix matrix);
+    BasicParallelGaussJordanInverse(BasicComplexMatrix<T> matrix);
 
-    ComplexMatrix calculateParallelGaussJordanInverse();
+    BasicComplexMatrix<T> calculateParallelGaussJordanInverse();
 };
 
+using ParallelGaussJordanInverse = BasicParallelGaussJordanInverse<double>;
@@ -2,22 +2,19 @@
 #include <iostream>
 #include "ComplexNum.h"
 #include "ComplexMatrix.h"
-#include "Strassen.h"
+#include "LUFactorization.h"
 #include <thread>
 #include <vector>
 
-class ParallelLUInverse {
+template <typename T>
+class BasicParallelLUInverse {
 public:
 
-    static bool parallelLUDecomposition(ComplexMatrix a, ComplexMatrix& l, ComplexMatrix& u);
+    /// @brief Factorizes with the trailing update of each step split between the threads of the active TuningProfile.
+    static BasicLUFactorization<T> parallelLUDecomposition(const BasicComplexMatrix<T>& a);
 
-
-    static ComplexNum* createEmpty(int n);
-
-
-    static ComplexNum* forwardSubstitution(ComplexMatrix l, ComplexNum* vector, int n);
-
-    static ComplexNum* backSubstitution(ComplexMatrix u, ComplexNum* vector, int n);
-
-    static ComplexMatrix calculateParallelLUInverse(ComplexMatrix a);
+    /// @brief Inverts by solving the columns of the identity on the threads of the active TuningProfile.
+    static BasicComplexMatrix<T> calculateParallelLUInverse(const BasicComplexMatrix<T>& a);
 };
+
+using ParallelLUInverse = BasicParallelLUInverse<double>;
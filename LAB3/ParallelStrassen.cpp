@@ -1,171 +1,155 @@
 #include "ParallelStrassen.h"
 
-ComplexMatrix* ParallelStrassen::parallelMultiply(ComplexMatrix* a, ComplexMatrix* b) {
+template <typename T>
+BasicComplexMatrix<T>* BasicParallelStrassen<T>::parallelMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b) {
     assert(a->getColumns() == b->getRows());
-    int n = a->getColumns();
-    int m = a->getRows();
-    int q = b->getColumns();
-    ComplexMatrix* result = new ComplexMatrix(m, q);
+    BasicComplexMatrix<T>* result = new BasicComplexMatrix<T>(a->getRows(), b->getColumns(), a->getLayout());
 
-    parallelStrassen(a, b, result, n, m, q);
+    parallelStrassen(*a, *b, *result);
 
     return result;
 }
 
-void ParallelStrassen::strassenRecursion(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int n, int m, int q) {
-    if (n <= 8 || m <= 8 || q <= 8) {
-        ParallelStrassen::multiplyBlock(a, b, result, 0, 0, 0, n);
-        return;
-    }
-
-    int newN = n / 2 + n % 2;
-    int newM = m / 2 + m % 2;
-    int newQ = q / 2 + q % 2;
-
-    ComplexMatrix a11(newM, newN);
-    ComplexMatrix a12(newM, newN);
-    ComplexMatrix a21(newM, newN);
-    ComplexMatrix a22(newM, newN);
-
-    ComplexMatrix b11(newN, newQ);
-    ComplexMatrix b12(newN, newQ);
-    ComplexMatrix b21(newN, newQ);
-    ComplexMatrix b22(newN, newQ);
-
-    for (int i = 0; i < newM; i++) {
-        for (int j = 0; j < newN; j++) {
-            a11.set(i, j, a->get(i, j));
-            a12.set(i, j, ((j + newN) < n) ? a->get(i, j + newN) : ComplexNum(0, 0));
-            a21.set(i, j, ((i + newM) < m) ? a->get(i + newM, j) : ComplexNum(0, 0));
-            a22.set(i, j, ((i + newM) < m && (j + newN) < n) ? a->get(i + newM, j + newN) : ComplexNum(0, 0));
-        }
-    }
+template <typename T>
+BasicComplexMatrix<T>* BasicParallelStrassen<T>::strassenMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b) {
+    assert(a->getColumns() == b->getRows());
+    BasicComplexMatrix<T>* result = new BasicComplexMatrix<T>(a->getRows(), b->getColumns(), a->getLayout());
 
-    for (int i = 0; i < newN; i++) {
-        for (int j = 0; j < newQ; j++) {
-            b11.set(i, j, b->get(i, j));
-            b12.set(i, j, ((j + newQ) < q) ? b->get(i, j + newQ) : ComplexNum(0, 0));
-            b21.set(i, j, ((i + newN) < n) ? b->get(i + newN, j) : ComplexNum(0, 0));
-            b22.set(i, j, ((i + newN) < n && (j + newQ) < q) ? b->get(i + newN, j + newQ) : ComplexNum(0, 0));
-        }
-    }
+    strassenRecursion(*a, *b, *result, 0);
 
-    ComplexMatrix d1 = a11 + a22;
-    ComplexMatrix d2 = b11 + b22;
-    ComplexMatrix d3 = a21 + a22;
-    ComplexMatrix d4 = b12 - b22;
-    ComplexMatrix d5 = b21 - b11;
-    ComplexMatrix d6 = a11 + a12;
-    ComplexMatrix d7 = a21 - a11;
-    ComplexMatrix d8 = b11 + b12;
-    ComplexMatrix d9 = a12 - a22;
-    ComplexMatrix d10 = b21 + b22;
-
-    ComplexMatrix m1(newM, newQ);
-    ComplexMatrix m2(newM, newQ);
-    ComplexMatrix m3(newM, newQ);
-    ComplexMatrix m4(newM, newQ);
-    ComplexMatrix m5(newM, newQ);
-    ComplexMatrix m6(newM, newQ);
-    ComplexMatrix m7(newM, newQ);
-
-    std::thread t1(&ParallelStrassen::strassenRecursion, &d1, &d2, &m1, newN, newM, newQ);
-    std::thread t2(&ParallelStrassen::strassenRecursion, &d3, &b11, &m2, newN, newM, newQ);
-    std::thread t3(&ParallelStrassen::strassenRecursion, &a11, &d4, &m3, newN, newM, newQ);
-    std::thread t4(&ParallelStrassen::strassenRecursion, &a22, &d5, &m4, newN, newM, newQ);
-    std::thread t5(&ParallelStrassen::strassenRecursion, &d6, &b22, &m5, newN, newM, newQ);
-    std::thread t6(&ParallelStrassen::strassenRecursion, &d7, &d8, &m6, newN, newM, newQ);
-    std::thread t7(&ParallelStrassen::strassenRecursion, &d9, &d10, &m7, newN, newM, newQ);
-
-    t1.join();
-    t2.join();
-    t3.join();
-    t4.join();
-    t5.join();
-    t6.join();
-    t7.join();
-
-    ComplexMatrix r1 = m1 + m4 - m5 + m7;
-    ComplexMatrix r2 = m3 + m5;
-    ComplexMatrix r3 = m2 + m4;
-    ComplexMatrix r4 = m1 - m2 + m3 + m6;
-
-    for (int i = 0; i < newM; i++) {
-        for (int j = 0; j < newQ; j++) {
-            result->set(i, j, r1.get(i, j));
-            if ((j + newQ) < q) {
-                result->set(i, j + newQ, r2.get(i, j));
-            }
-            if ((i + newM) < m) {
-                result->set(i + newM, j, r3.get(i, j));
-            }
-            if ((i + newM) < m && (j + newQ) < q) {
-                result->set(i + newM, j + newQ, r4.get(i, j));
-            }
-        }
-    }
+    return result;
 }
 
-void ParallelStrassen::parallelStrassen(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int n, int m, int q) {
-    int blockSize = 256;
-    int numThreads = std::thread::hardware_concurrency();
-    int blocks = n / blockSize;
-
-    if (blocks * blockSize < n) {
-        blocks++;
+template <typename T>
+void BasicParallelStrassen<T>::strassenRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, int depth) {
+    int n = a.getColumns();
+    int m = a.getRows();
+    int q = b.getColumns();
+    const TuningProfile& tuning = TuningProfile::active();
+    int cutoff = BasicStrassen<T>::cutoff();
+    if (n <= cutoff || m <= cutoff || q <= cutoff) {
+        BasicParallelStrassen<T>::multiplyBlock(a, b, result);
+        return;
     }
-
-    std::vector<std::thread> threads;
-    threads.reserve(numThreads);
-
-    for (int i = 0; i < blocks; i++) {
-        for (int j = 0; j < blocks; j++) {
-            ComplexMatrix* blockResult = new ComplexMatrix(blockSize, blockSize);
-            int rowA = i * blockSize;
-            int colB = j * blockSize;
-
-            for (int k = 0; k < blocks; k++) {
-                int colA = k * blockSize;
-                multiplyBlock(a, b, blockResult, rowA, colA, colB, blockSize);
-                addBlock(result, blockResult, result, rowA, colB, 0, 0, blockSize);
-            }
-
-            delete blockResult;
-        }
+    if (depth >= tuning.strassenTaskDepth || std::min({ m, n, q }) <= tuning.strassenTaskSize) {
+        BasicStrassen<T>::strassenRecursion(a, b, result);
+        return;
     }
 
+    int newN = n / 2 + n % 2;
+    int newM = m / 2 + m % 2;
+    int newQ = q / 2 + q % 2;
+    StorageLayout layout = a.getLayout();
+
+    // A thread only runs sub-products of the levels it is inside of, so its arena holds one
+    // chain of levels at a time; reserving the whole chain when the arena is empty covers the
+    // nested levels, and for those this reserve finds the room already there.
+    StrassenWorkspace& workspace = StrassenWorkspace::local();
+    workspace.reserve(StrassenWorkspace::requiredBytes<T>(m, n, q, layout, cutoff));
+    std::size_t frame = workspace.mark();
+
+    BasicComplexMatrixView<T> a11 = a.block(0, 0, newM, newN);
+    BasicComplexMatrixView<T> a12 = a.block(0, newN, newM, newN);
+    BasicComplexMatrixView<T> a21 = a.block(newM, 0, newM, newN);
+    BasicComplexMatrixView<T> a22 = a.block(newM, newN, newM, newN);
+
+    BasicComplexMatrixView<T> b11 = b.block(0, 0, newN, newQ);
+    BasicComplexMatrixView<T> b12 = b.block(0, newQ, newN, newQ);
+    BasicComplexMatrixView<T> b21 = b.block(newN, 0, newN, newQ);
+    BasicComplexMatrixView<T> b22 = b.block(newN, newQ, newN, newQ);
+
+    BasicComplexMatrixView<T> d1 = workspace.template allocate<T>(newM, newN, layout);
+    d1.assign(a11 + a22);
+    BasicComplexMatrixView<T> d2 = workspace.template allocate<T>(newN, newQ, layout);
+    d2.assign(b11 + b22);
+    BasicComplexMatrixView<T> d3 = workspace.template allocate<T>(newM, newN, layout);
+    d3.assign(a21 + a22);
+    BasicComplexMatrixView<T> d4 = workspace.template allocate<T>(newN, newQ, layout);
+    d4.assign(b12 - b22);
+    BasicComplexMatrixView<T> d5 = workspace.template allocate<T>(newN, newQ, layout);
+    d5.assign(b21 - b11);
+    BasicComplexMatrixView<T> d6 = workspace.template allocate<T>(newM, newN, layout);
+    d6.assign(a11 + a12);
+    BasicComplexMatrixView<T> d7 = workspace.template allocate<T>(newM, newN, layout);
+    d7.assign(a21 - a11);
+    BasicComplexMatrixView<T> d8 = workspace.template allocate<T>(newN, newQ, layout);
+    d8.assign(b11 + b12);
+    BasicComplexMatrixView<T> d9 = workspace.template allocate<T>(newM, newN, layout);
+    d9.assign(a12 - a22);
+    BasicComplexMatrixView<T> d10 = workspace.template allocate<T>(newN, newQ, layout);
+    d10.assign(b21 + b22);
+
+    BasicComplexMatrixView<T> m1 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m2 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m3 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m4 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m5 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m6 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m7 = workspace.template allocate<T>(newM, newQ, layout);
+
+    const BasicComplexMatrixView<T>* left[7] = { &d1, &d3, &a11, &a22, &d6, &d7, &d9 };
+    const BasicComplexMatrixView<T>* right[7] = { &d2, &b11, &d4, &d5, &b22, &d8, &d10 };
+    BasicComplexMatrixView<T>* products[7] = { &m1, &m2, &m3, &m4, &m5, &m6, &m7 };
+    ThreadPool::shared().parallelFor(7, [&](int i) {
+        strassenRecursion(*left[i], *right[i], *products[i], depth + 1);
+    }, tuning.threadCount());
+
+    result.block(0, 0, newM, newQ).assign(m1 + m4 - m5 + m7);
+    result.block(0, newQ, newM, newQ).assign(m3 + m5);
+    result.block(newM, 0, newM, newQ).assign(m2 + m4);
+    result.block(newM, newQ, newM, newQ).assign(m1 - m2 + m3 + m6);
+
+    workspace.rewind(frame);
+}
 
-    for (std::thread& thread : threads) {
-        thread.join();
-    }
+template <typename T>
+void BasicParallelStrassen<T>::parallelStrassen(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result) {
+    int n = a.getColumns();
+    int m = a.getRows();
+    int q = b.getColumns();
+    const TuningProfile& tuning = TuningProfile::active();
+    unsigned int numThreads = tuning.threadCount();
+
+    // Shrink the tiles of small products until every thread has one, but not below a size the
+    // GEMM still runs efficiently on.
+    int blockSize = std::max(MIN_BLOCK_SIZE, tuning.parallelBlockSize);
+    while (blockSize / 2 >= MIN_BLOCK_SIZE && static_cast<unsigned int>(tileCount(m, blockSize) * tileCount(q, blockSize)) < numThreads)
+        blockSize /= 2;
+
+    int tileRows = tileCount(m, blockSize);
+    int tileColumns = tileCount(q, blockSize);
+
+    // Each task owns one tile of the result and runs the full depth through the GEMM, whose pack
+    // buffers are per thread, so tiles need no locking and nothing is allocated per tile.
+    // Tiles past the ragged edges are views clipped to the backed extent.
+    ThreadPool::shared().parallelFor(tileRows * tileColumns, [&](int tile) {
+        int row = tile / tileColumns * blockSize;
+        int col = tile % tileColumns * blockSize;
+        BasicComplexGemm<T>::multiply(a.block(row, 0, blockSize, n), b.block(0, col, n, blockSize), result.block(row, col, blockSize, blockSize));
+    }, numThreads);
 }
 
+template <typename T>
+int BasicParallelStrassen<T>::tileCount(int extent, int blockSize) {
+    return (extent + blockSize - 1) / blockSize;
+}
 
-void ParallelStrassen::multiplyBlock(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int rowA, int colA, int colB, int blockSize) {
-    for (int i = 0; i < blockSize; i++) {
-        for (int j = 0; j < blockSize; j++) {
-            ComplexNum sum(0, 0);
-            for (int k = 0; k < blockSize; k++) {
-                sum = sum + a->get(rowA + i, colA + k) * b->get(colA + k, colB + j);
-            }
-            result->set(i, j, sum);
-        }
-    }
+template <typename T>
+void BasicParallelStrassen<T>::multiplyBlock(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result) {
+    BasicComplexMatrixView<T>::multiply(a, b, result);
 }
 
-void ParallelStrassen::addBlock(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int rowA, int colA, int rowB, int colB, int blockSize) {
-    for (int i = 0; i < blockSize; i++) {
-        for (int j = 0; j < blockSize; j++) {
-            result->set(rowA + i, colA + j, a->get(rowA + i, colA + j) + b->get(rowB + i, colB + j));
-        }
-    }
+template <typename T>
+void BasicParallelStrassen<T>::addBlock(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result) {
+    BasicComplexMatrixView<T>::add(a, b, result);
 }
 
 
-void ParallelStrassen::subtractBlock(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int rowA, int colA, int rowB, int colB, int blockSize) {
-    for (int i = 0; i < blockSize; i++) {
-        for (int j = 0; j < blockSize; j++) {
-            result->set(rowA + i, colA + j, a->get(rowA + i, colA + j) - b->get(rowB + i, colB + j));
-        }
-    }
+template <typename T>
+void BasicParallelStrassen<T>::subtractBlock(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result) {
+    BasicComplexMatrixView<T>::subtract(a, b, result);
 }
+
+template class BasicParallelStrassen<float>;
+template class BasicParallelStrassen<double>;
+template class BasicParallelStrassen<long double>;
@@ -1,25 +1,47 @@
 #pragma once
 #include <iostream>
 #include "ComplexMatrix.h"
+#include "ComplexMatrixView.h"
+#include "ComplexGemm.h"
+#include "Strassen.h"
+#include "StrassenWorkspace.h"
+#include "ThreadPool.h"
+#include "TuningProfile.h"
+#include <algorithm>
 #include <thread>
 #include <vector>
 
-class ParallelStrassen {
+template <typename T>
+class BasicParallelStrassen {
 public:
 
-    static ComplexMatrix* parallelMultiply(ComplexMatrix* a, ComplexMatrix* b);
+    /// @brief Smallest tile parallelMultiply splits a product into.
+    static constexpr int MIN_BLOCK_SIZE = 64;
+
+    /// @brief a * b with the result split into square tiles (the active TuningProfile's
+    /// parallelBlockSize) that the shared ThreadPool computes concurrently.
+    static BasicComplexMatrix<T>* parallelMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b);
+
+    /// @brief a * b by Strassen with the seven sub-products of the top levels run as tasks on the
+    /// shared ThreadPool. Task spawning stops after the active TuningProfile's strassenTaskDepth
+    /// levels or once a dimension is <= strassenTaskSize; below that BasicStrassen recurses
+    /// sequentially inside the task, so the thread count never exceeds the pool's.
+    static BasicComplexMatrix<T>* strassenMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b);
 private:
 
-    static void strassenRecursion(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int n, int m, int q);
+    static void strassenRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, int depth);
+
 
+    static void parallelStrassen(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result);
 
-    static void parallelStrassen(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int n, int m, int q);
+    static int tileCount(int extent, int blockSize);
 
-    static void multiplyBlock(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int rowA, int colA, int colB, int blockSize);
+    static void multiplyBlock(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result);
 
 
-    static void addBlock(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int rowA, int colA, int rowB, int colB, int blockSize);
+    static void addBlock(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result);
 
-    static void subtractBlock(ComplexMatrix* a, ComplexMatrix* b, ComplexMatrix* result, int rowA, int colA, int rowB, int colB, int blockSize);
+    static void subtractBlock(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result);
 };
 
+using ParallelStrassen = BasicParallelStrassen<double>;
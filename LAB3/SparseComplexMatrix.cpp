@@ -0,0 +1,353 @@
+#include "SparseComplexMatrix.h"
+#include <algorithm>
+#include <thread>
+
+namespace {
+    /// @brief Runs body(first, last) for each consecutive pair of bounds, one std::thread per range.
+    template <typename Body>
+    void forEachRange(const std::vector<int>& bounds, Body body)
+    {
+        if (bounds.size() <= 2)
+        {
+            body(bounds.front(), bounds.back());
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        for (std::size_t r = 0; r + 1 < bounds.size(); r++)
+            threads.emplace_back(body, bounds[r], bounds[r + 1]);
+        for (auto& thread : threads)
+            thread.join();
+    }
+}
+
+template <typename T>
+BasicSparseComplexMatrix<T>::BasicSparseComplexMatrix(int rows, int columns, SparseFormat format)
+    : rows(rows), columns(columns), format(format), offsets(), indices(), values()
+{
+    assert(rows >= 0 && columns >= 0);
+    offsets.assign(majorCount() + 1, 0);
+}
+
+template <typename T>
+int BasicSparseComplexMatrix<T>::majorCount() const
+{
+    return format == SparseFormat::CSR ? rows : columns;
+}
+
+template <typename T>
+std::vector<int> BasicSparseComplexMatrix<T>::partition(unsigned int threads) const
+{
+    const int lines = majorCount();
+    const int entries = nonZeros();
+    const int parts = std::max(1, std::min<int>(threads, lines));
+
+    std::vector<int> bounds(1, 0);
+    for (int p = 1; p < parts; p++)
+    {
+        long long target = static_cast<long long>(entries) * p / parts;
+        int line = static_cast<int>(std::lower_bound(offsets.begin(), offsets.end(), target) - offsets.begin());
+        line = std::min(std::max(line, bounds.back()), lines);
+        if (line > bounds.back() && line < lines)
+            bounds.push_back(line);
+    }
+    bounds.push_back(lines);
+    return bounds;
+}
+
+template <typename T>
+BasicSparseComplexMatrix<T> BasicSparseComplexMatrix<T>::fromDense(const BasicComplexMatrix<T>& dense, SparseFormat format)
+{
+    BasicSparseComplexMatrix<T> result(dense.getRows(), dense.getColumns(), format);
+    const int lines = result.majorCount();
+    const int length = format == SparseFormat::CSR ? dense.getColumns() : dense.getRows();
+
+    for (int m = 0; m < lines; m++)
+    {
+        for (int n = 0; n < length; n++)
+        {
+            BasicComplexNum<T> value = format == SparseFormat::CSR ? dense.get(m, n) : dense.get(n, m);
+            if (value.isNull())
+                continue;
+            result.indices.push_back(n);
+            result.values.push_back(value);
+        }
+        result.offsets[m + 1] = static_cast<int>(result.values.size());
+    }
+    return result;
+}
+
+template <typename T>
+BasicSparseComplexMatrix<T> BasicSparseComplexMatrix<T>::fromTriplets(int rows, int columns, const std::vector<Triplet>& triplets, SparseFormat format)
+{
+    BasicSparseComplexMatrix<T> result(rows, columns, format);
+    const bool byRow = format == SparseFormat::CSR;
+
+    std::vector<Triplet> sorted(triplets);
+    std::sort(sorted.begin(), sorted.end(), [byRow](const Triplet& a, const Triplet& b) {
+        int majorA = byRow ? a.row : a.column;
+        int majorB = byRow ? b.row : b.column;
+        if (majorA != majorB)
+            return majorA < majorB;
+        return (byRow ? a.column : a.row) < (byRow ? b.column : b.row);
+    });
+
+    int previousMajor = -1;
+    int previousMinor = -1;
+    for (const Triplet& triplet : sorted)
+    {
+        assert(triplet.row >= 0 && triplet.row < rows && triplet.column >= 0 && triplet.column < columns);
+        int major = byRow ? triplet.row : triplet.column;
+        int minor = byRow ? triplet.column : triplet.row;
+        if (major == previousMajor && minor == previousMinor)
+        {
+            result.values.back() += triplet.value;
+            continue;
+        }
+        result.indices.push_back(minor);
+        result.values.push_back(triplet.value);
+        result.offsets[major + 1]++;
+        previousMajor = major;
+        previousMinor = minor;
+    }
+
+    for (int m = 0; m < result.majorCount(); m++)
+        result.offsets[m + 1] += result.offsets[m];
+    return result;
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicSparseComplexMatrix<T>::toDense(StorageLayout layout) const
+{
+    BasicComplexMatrix<T> result(rows, columns, layout);
+    for (int m = 0; m < majorCount(); m++)
+    {
+        for (int p = offsets[m]; p < offsets[m + 1]; p++)
+        {
+            if (format == SparseFormat::CSR)
+                result.set(m, indices[p], values[p]);
+            else
+                result.set(indices[p], m, values[p]);
+        }
+    }
+    return result;
+}
+
+template <typename T>
+BasicSparseComplexMatrix<T> BasicSparseComplexMatrix<T>::toFormat(SparseFormat target) const
+{
+    if (target == format)
+        return *this;
+
+    BasicSparseComplexMatrix<T> result(rows, columns, target);
+    for (int index : indices)
+        result.offsets[index + 1]++;
+    for (int m = 0; m < result.majorCount(); m++)
+        result.offsets[m + 1] += result.offsets[m];
+
+    result.indices.resize(indices.size());
+    result.values.resize(values.size());
+    std::vector<int> next(result.offsets.begin(), result.offsets.end() - 1);
+    for (int m = 0; m < majorCount(); m++)
+    {
+        for (int p = offsets[m]; p < offsets[m + 1]; p++)
+        {
+            int slot = next[indices[p]]++;
+            result.indices[slot] = m;
+            result.values[slot] = values[p];
+        }
+    }
+    return result;
+}
+
+template <typename T>
+int BasicSparseComplexMatrix<T>::getRows() const
+{
+    return rows;
+}
+
+template <typename T>
+int BasicSparseComplexMatrix<T>::getColumns() const
+{
+    return columns;
+}
+
+template <typename T>
+SparseFormat BasicSparseComplexMatrix<T>::getFormat() const
+{
+    return format;
+}
+
+template <typename T>
+int BasicSparseComplexMatrix<T>::nonZeros() const
+{
+    return static_cast<int>(values.size());
+}
+
+template <typename T>
+const std::vector<int>& BasicSparseComplexMatrix<T>::getOffsets() const
+{
+    return offsets;
+}
+
+template <typename T>
+const std::vector<int>& BasicSparseComplexMatrix<T>::getIndices() const
+{
+    return indices;
+}
+
+template <typename T>
+const std::vector<BasicComplexNum<T>>& BasicSparseComplexMatrix<T>::getValues() const
+{
+    return values;
+}
+
+template <typename T>
+BasicComplexNum<T> BasicSparseComplexMatrix<T>::get(int i, int j) const
+{
+    assert(i >= 0 && i < rows && j >= 0 && j < columns);
+    int major = format == SparseFormat::CSR ? i : j;
+    int minor = format == SparseFormat::CSR ? j : i;
+
+    auto first = indices.begin() + offsets[major];
+    auto last = indices.begin() + offsets[major + 1];
+    auto found = std::lower_bound(first, last, minor);
+    if (found == last || *found != minor)
+        return BasicComplexNum<T>();
+    return values[found - indices.begin()];
+}
+
+template <typename T>
+void BasicSparseComplexMatrix<T>::multiply(const BasicComplexNum<T>* x, BasicComplexNum<T>* y, unsigned int threads) const
+{
+    if (format == SparseFormat::CSC)
+    {
+        if (threads > 1)
+        {
+            toFormat(SparseFormat::CSR).multiply(x, y, threads);
+            return;
+        }
+
+        std::fill(y, y + rows, BasicComplexNum<T>());
+        for (int j = 0; j < columns; j++)
+        {
+            const BasicComplexNum<T> xj = x[j];
+            for (int p = offsets[j]; p < offsets[j + 1]; p++)
+                y[indices[p]].addProduct(values[p], xj);
+        }
+        return;
+    }
+
+    forEachRange(partition(threads), [&](int firstRow, int lastRow) {
+        for (int i = firstRow; i < lastRow; i++)
+        {
+            BasicComplexNum<T> sum;
+            for (int p = offsets[i]; p < offsets[i + 1]; p++)
+                sum.addProduct(values[p], x[indices[p]]);
+            y[i] = sum;
+        }
+    });
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicSparseComplexMatrix<T>::multiply(const BasicComplexMatrix<T>& dense, unsigned int threads) const
+{
+    assert(columns == dense.getRows());
+    if (format == SparseFormat::CSC)
+        return toFormat(SparseFormat::CSR).multiply(dense, threads);
+
+    const int width = dense.getColumns();
+    BasicComplexMatrix<T> result(rows, width, dense.getLayout());
+    if (rows == 0 || width == 0)
+        return result;
+
+    forEachRange(partition(threads), [&](int firstRow, int lastRow) {
+        for (int i = firstRow; i < lastRow; i++)
+        {
+            if (dense.isSplit())
+            {
+                T* cr = result.realRow(i);
+                T* ci = result.imagRow(i);
+                for (int p = offsets[i]; p < offsets[i + 1]; p++)
+                {
+                    const T ar = values[p].getReal();
+                    const T ai = values[p].getImag();
+                    const T* br = dense.realRow(indices[p]);
+                    const T* bi = dense.imagRow(indices[p]);
+                    for (int j = 0; j < width; j++)
+                    {
+                        cr[j] += ar * br[j] - ai * bi[j];
+                        ci[j] += ar * bi[j] + ai * br[j];
+                    }
+                }
+            }
+            else
+            {
+                BasicComplexNum<T>* out = result.row(i);
+                for (int p = offsets[i]; p < offsets[i + 1]; p++)
+                {
+                    const BasicComplexNum<T> a = values[p];
+                    const BasicComplexNum<T>* b = dense.row(indices[p]);
+                    for (int j = 0; j < width; j++)
+                        out[j].addProduct(a, b[j]);
+                }
+            }
+        }
+    });
+    return result;
+}
+
+template <typename T>
+BasicComplexMatrix<T> BasicSparseComplexMatrix<T>::operator *(const BasicComplexMatrix<T>& dense) const
+{
+    return multiply(dense);
+}
+
+template <typename T>
+BasicSparseComplexMatrix<T> BasicSparseComplexMatrix<T>::operator +(const BasicSparseComplexMatrix<T>& other) const
+{
+    assert(rows == other.rows && columns == other.columns);
+    if (other.format != format)
+        return *this + other.toFormat(format);
+
+    BasicSparseComplexMatrix<T> result(rows, columns, format);
+    result.indices.reserve(indices.size() + other.indices.size());
+    result.values.reserve(values.size() + other.values.size());
+
+    for (int m = 0; m < majorCount(); m++)
+    {
+        int p = offsets[m];
+        int q = other.offsets[m];
+        while (p < offsets[m + 1] || q < other.offsets[m + 1])
+        {
+            int minor;
+            BasicComplexNum<T> value;
+            if (q == other.offsets[m + 1] || (p < offsets[m + 1] && indices[p] < other.indices[q]))
+            {
+                minor = indices[p];
+                value = values[p++];
+            }
+            else if (p == offsets[m + 1] || other.indices[q] < indices[p])
+            {
+                minor = other.indices[q];
+                value = other.values[q++];
+            }
+            else
+            {
+                minor = indices[p];
+                value = values[p++] + other.values[q++];
+            }
+
+            if (value.isNull())
+                continue;
+            result.indices.push_back(minor);
+            result.values.push_back(value);
+        }
+        result.offsets[m + 1] = static_cast<int>(result.values.size());
+    }
+    return result;
+}
+
+template class BasicSparseComplexMatrix<float>;
+template class BasicSparseComplexMatrix<double>;
+template class BasicSparseComplexMatrix<long double>;
@@ -0,0 +1,85 @@
+#pragma once
+#include "ComplexMatrix.h"
+#include <vector>
+
+/// @brief Compression direction: CSR stores rows contiguously, CSC stores columns.
+enum class SparseFormat {
+    CSR,
+    CSC
+};
+
+/// @brief Compressed sparse complex matrix over the scalar type T.
+/// offsets has one entry per major line (row for CSR, column for CSC) plus one; the non-zeros of
+/// line m are values[offsets[m] .. offsets[m + 1]) with their minor indices, sorted, in indices.
+/// Storage and multiplication cost scale with the number of stored entries, not rows x columns.
+template <typename T>
+class BasicSparseComplexMatrix
+{
+private:
+    int rows;
+    int columns;
+    SparseFormat format;
+    std::vector<int> offsets;
+    std::vector<int> indices;
+    std::vector<BasicComplexNum<T>> values;
+
+    int majorCount() const;
+
+    /// @brief Splits the major lines into at most threads ranges with about the same number of entries.
+    std::vector<int> partition(unsigned int threads) const;
+
+public:
+    struct Triplet {
+        int row;
+        int column;
+        BasicComplexNum<T> value;
+    };
+
+    BasicSparseComplexMatrix(int rows = 0, int columns = 0, SparseFormat format = SparseFormat::CSR);
+
+    /// @brief Keeps the elements of dense that are not exactly zero.
+    static BasicSparseComplexMatrix fromDense(const BasicComplexMatrix<T>& dense, SparseFormat format = SparseFormat::CSR);
+
+    /// @brief Builds from (row, column, value) entries in any order; duplicates are summed.
+    static BasicSparseComplexMatrix fromTriplets(int rows, int columns, const std::vector<Triplet>& triplets, SparseFormat format = SparseFormat::CSR);
+
+    BasicComplexMatrix<T> toDense(StorageLayout layout = StorageLayout::Interleaved) const;
+
+    /// @brief Same matrix compressed the other way (a counting-sort transpose of the arrays).
+    BasicSparseComplexMatrix toFormat(SparseFormat format) const;
+
+    int getRows() const;
+
+    int getColumns() const;
+
+    SparseFormat getFormat() const;
+
+    int nonZeros() const;
+
+    const std::vector<int>& getOffsets() const;
+
+    const std::vector<int>& getIndices() const;
+
+    const std::vector<BasicComplexNum<T>>& getValues() const;
+
+    /// @brief Element (i, j); zero when it is not stored. Binary search within the line.
+    BasicComplexNum<T> get(int i, int j) const;
+
+    /// @brief SpMV y = A * x; x has getColumns() elements and y getRows().
+    /// CSR rows are split between threads by entry count; a CSC matrix is converted to CSR first
+    /// when threads > 1, since its column scatter would race on y.
+    void multiply(const BasicComplexNum<T>* x, BasicComplexNum<T>* y, unsigned int threads = 1) const;
+
+    /// @brief SpMM A * dense, in dense's layout, with rows of the result split between threads
+    /// (a CSC matrix is converted to CSR first).
+    BasicComplexMatrix<T> multiply(const BasicComplexMatrix<T>& dense, unsigned int threads = 1) const;
+
+    BasicComplexMatrix<T> operator *(const BasicComplexMatrix<T>& dense) const;
+
+    /// @brief Sparse + sparse by merging the sorted lines; the result uses this matrix's format.
+    BasicSparseComplexMatrix operator +(const BasicSparseComplexMatrix& other) const;
+};
+
+using SparseComplexMatrixF = BasicSparseComplexMatrix<float>;
+using SparseComplexMatrix = BasicSparseComplexMatrix<double>;
+using SparseComplexMatrixL = BasicSparseComplexMatrix<long double>;
@@ -0,0 +1,9 @@
+#pragma once
+
+/// @brief Memory layout of a ComplexMatrix.
+/// Interleaved keeps {real, imag} pairs next to each other; Split keeps separate real and
+/// imaginary planes so element-wise kernels can run at full vector width without shuffles.
+enum class StorageLayout {
+    Interleaved,
+    Split
+};
@@ -1,110 +1,354 @@
 #include "Strassen.h"
+#include <algorithm>
+#include <cassert>
 
-ComplexMatrix* Strassen::regularMult(ComplexMatrix* a, ComplexMatrix* b) {
-    ComplexMatrix* result = new ComplexMatrix(a->getRows(), b->getColumns());
-    for (int i = 0; i < a->getRows(); i++) {
-        for (int j = 0; j < b->getColumns(); j++) {
-            for (int k = 0; k < b->getRows(); k++) {
-                result->set(i, j, result->get(i, j) + a->get(i, k) * b->get(k, j));
-            }
-        }
+namespace {
+    // Flat loops over quadrants of Morton blocks, which are contiguous runs of count elements.
+    template <typename T>
+    void addRuns(std::size_t count, const BasicComplexNum<T>* x, const BasicComplexNum<T>* y, BasicComplexNum<T>* out)
+    {
+        for (std::size_t k = 0; k < count; k++)
+            out[k] = x[k] + y[k];
     }
+
+    template <typename T>
+    void subtractRuns(std::size_t count, const BasicComplexNum<T>* x, const BasicComplexNum<T>* y, BasicComplexNum<T>* out)
+    {
+        for (std::size_t k = 0; k < count; k++)
+            out[k] = x[k] - y[k];
+    }
+
+    template <typename T>
+    void accumulateRun(std::size_t count, const BasicComplexNum<T>* x, BasicComplexNum<T>* out)
+    {
+        for (std::size_t k = 0; k < count; k++)
+            out[k] += x[k];
+    }
+
+    template <typename T>
+    void deductRun(std::size_t count, const BasicComplexNum<T>* x, BasicComplexNum<T>* out)
+    {
+        for (std::size_t k = 0; k < count; k++)
+            out[k] -= x[k];
+    }
+}
+
+template <typename T>
+int BasicStrassen<T>::cutoff() {
+    return TuningProfile::active().strassenCutoff;
+}
+
+template <typename T>
+BasicComplexMatrix<T>* BasicStrassen<T>::regularMult(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode) {
+    BasicComplexMatrix<T>* result = new BasicComplexMatrix<T>(a->getRows(), b->getColumns(), a->getLayout());
+    regularMult(BasicComplexMatrixView<T>(*a), BasicComplexMatrixView<T>(*b), BasicComplexMatrixView<T>(*result), mode);
+    return result;
+}
+
+template <typename T>
+void BasicStrassen<T>::regularMult(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, MultiplyMode mode) {
+    BasicComplexMatrixView<T>::multiply(a, b, result, mode);
+}
+
+template <typename T>
+BasicComplexMatrix<T>* BasicStrassen<T>::strassenRecursion(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode) {
+    BasicComplexMatrix<T>* result = new BasicComplexMatrix<T>(a->getRows(), b->getColumns(), a->getLayout());
+    strassenRecursion(BasicComplexMatrixView<T>(*a), BasicComplexMatrixView<T>(*b), BasicComplexMatrixView<T>(*result), mode);
     return result;
 }
 
-ComplexMatrix* Strassen::strassenRecursion(ComplexMatrix* a, ComplexMatrix* b) {
-    int n = a->getColumns();
-    int m = a->getRows();
-    int q = b->getColumns();
-    if (n <= 8 || m <= 8 || q <= 8) {
-        return regularMult(a, b);
+template <typename T>
+void BasicStrassen<T>::strassenRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, MultiplyMode mode) {
+    StrassenWorkspace& workspace = StrassenWorkspace::local();
+    workspace.reserve(StrassenWorkspace::requiredBytes<T>(a.getRows(), a.getColumns(), b.getColumns(), a.getLayout(), cutoff()));
+    strassenRecursion(a, b, result, workspace, mode);
+}
+
+template <typename T>
+void BasicStrassen<T>::strassenRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, StrassenWorkspace& workspace, MultiplyMode mode) {
+    int n = a.getColumns();
+    int m = a.getRows();
+    int q = b.getColumns();
+    if (n <= cutoff() || m <= cutoff() || q <= cutoff()) {
+        regularMult(a, b, result, mode);
+        return;
     }
     int newN = n / 2 + n % 2;
     int newM = m / 2 + m % 2;
     int newQ = q / 2 + q % 2;
-    ComplexMatrix a11(newM, newN);
-    ComplexMatrix a12(newM, newN);
-    ComplexMatrix a21(newM, newN);
-    ComplexMatrix a22(newM, newN);
-
-    for (int i = 0; i < newM; i++) {
-        for (int j = 0; j < newN; j++) {
-            a11.set(i, j, a->get(i, j));
-            a12.set(i, j, ((j + newN) < n) ? a->get(i, j + newN) : ComplexNum(0, 0));
-            a21.set(i, j, ((i + newM) < m) ? a->get(i + newM, j) : ComplexNum(0, 0));
-            a22.set(i, j, ((i + newM) < m && (j + newN) < n) ? a->get(i + newM, j + newN) : ComplexNum(0, 0));
-        }
+    StorageLayout layout = a.getLayout();
+    std::size_t frame = workspace.mark();
+
+    BasicComplexMatrixView<T> a11 = a.block(0, 0, newM, newN);
+    BasicComplexMatrixView<T> a12 = a.block(0, newN, newM, newN);
+    BasicComplexMatrixView<T> a21 = a.block(newM, 0, newM, newN);
+    BasicComplexMatrixView<T> a22 = a.block(newM, newN, newM, newN);
+
+    BasicComplexMatrixView<T> b11 = b.block(0, 0, newN, newQ);
+    BasicComplexMatrixView<T> b12 = b.block(0, newQ, newN, newQ);
+    BasicComplexMatrixView<T> b21 = b.block(newN, 0, newN, newQ);
+    BasicComplexMatrixView<T> b22 = b.block(newN, newQ, newN, newQ);
+
+    BasicComplexMatrixView<T> d1 = workspace.template allocate<T>(newM, newN, layout);
+    d1.assign(a11 + a22);
+    BasicComplexMatrixView<T> d2 = workspace.template allocate<T>(newN, newQ, layout);
+    d2.assign(b11 + b22);
+    BasicComplexMatrixView<T> d3 = workspace.template allocate<T>(newM, newN, layout);
+    d3.assign(a21 + a22);
+    BasicComplexMatrixView<T> d4 = workspace.template allocate<T>(newN, newQ, layout);
+    d4.assign(b12 - b22);
+    BasicComplexMatrixView<T> d5 = workspace.template allocate<T>(newN, newQ, layout);
+    d5.assign(b21 - b11);
+    BasicComplexMatrixView<T> d6 = workspace.template allocate<T>(newM, newN, layout);
+    d6.assign(a11 + a12);
+    BasicComplexMatrixView<T> d7 = workspace.template allocate<T>(newM, newN, layout);
+    d7.assign(a21 - a11);
+    BasicComplexMatrixView<T> d8 = workspace.template allocate<T>(newN, newQ, layout);
+    d8.assign(b11 + b12);
+    BasicComplexMatrixView<T> d9 = workspace.template allocate<T>(newM, newN, layout);
+    d9.assign(a12 - a22);
+    BasicComplexMatrixView<T> d10 = workspace.template allocate<T>(newN, newQ, layout);
+    d10.assign(b21 + b22);
+
+    BasicComplexMatrixView<T> m1 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m2 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m3 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m4 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m5 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m6 = workspace.template allocate<T>(newM, newQ, layout);
+    BasicComplexMatrixView<T> m7 = workspace.template allocate<T>(newM, newQ, layout);
+
+    strassenRecursion(d1, d2, m1, workspace, mode);
+    strassenRecursion(d3, b11, m2, workspace, mode);
+    strassenRecursion(a11, d4, m3, workspace, mode);
+    strassenRecursion(a22, d5, m4, workspace, mode);
+    strassenRecursion(d6, b22, m5, workspace, mode);
+    strassenRecursion(d7, d8, m6, workspace, mode);
+    strassenRecursion(d9, d10, m7, workspace, mode);
+
+    result.block(0, 0, newM, newQ).assign(m1 + m4 - m5 + m7);
+    result.block(0, newQ, newM, newQ).assign(m3 + m5);
+    result.block(newM, 0, newM, newQ).assign(m2 + m4);
+    result.block(newM, newQ, newM, newQ).assign(m1 - m2 + m3 + m6);
+
+    workspace.rewind(frame);
+}
+
+template <typename T>
+BasicComplexMatrix<T>* BasicStrassen<T>::strassenMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode) {
+    assert(a->getColumns() == b->getRows());
+    if (a->getColumns() <= cutoff() || a->getRows() <= cutoff() || b->getColumns() <= cutoff()) {
+        return regularMult(a, b, mode);
     }
 
-    ComplexMatrix b11(newN, newQ);
-    ComplexMatrix b12(newN, newQ);
-    ComplexMatrix b21(newN, newQ);
-    ComplexMatrix b22(newN, newQ);
-
-    for (int i = 0; i < newN; i++) {
-        for (int j = 0; j < newQ; j++) {
-            b11.set(i, j, b->get(i, j));
-            b12.set(i, j, ((j + newQ) < q) ? b->get(i, j + newQ) : ComplexNum(0, 0));
-            b21.set(i, j, ((i + newN) < n) ? b->get(i + newN, j) : ComplexNum(0, 0));
-            b22.set(i, j, ((i + newN) < n && (j + newQ) < q) ? b->get(i + newN, j + newQ) : ComplexNum(0, 0));
-        }
+    return strassenRecursion(a, b, mode);
+}
+
+template <typename T>
+void BasicStrassen<T>::winogradRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, MultiplyMode mode) {
+    assert(a.getColumns() == b.getRows());
+    assert(a.getRows() == result.getRows() && b.getColumns() == result.getColumns());
+
+    // The schedule stores intermediates in result's quadrants, which only works when every
+    // quadrant is fully backed; restrict the product to the backed extents and zero the rest.
+    int m = std::min(a.getValidRows(), result.getValidRows());
+    int n = std::min(a.getValidColumns(), b.getValidRows());
+    int q = std::min(b.getValidColumns(), result.getValidColumns());
+    if (m < result.getValidRows() || q < result.getValidColumns() || n == 0) {
+        for (int i = 0; i < result.getValidRows(); i++)
+            for (int j = 0; j < result.getValidColumns(); j++)
+                result.set(i, j, BasicComplexNum<T>());
     }
+    if (m == 0 || n == 0 || q == 0)
+        return;
 
-    ComplexMatrix d1 = a11 + a22;
-    ComplexMatrix d2 = b11 + b22;
-    ComplexMatrix d3 = a21 + a22;
-    ComplexMatrix d4 = b12 - b22;
-    ComplexMatrix d5 = b21 - b11;
-    ComplexMatrix d6 = a11 + a12;
-    ComplexMatrix d7 = a21 - a11;
-    ComplexMatrix d8 = b11 + b12;
-    ComplexMatrix d9 = a12 - a22;
-    ComplexMatrix d10 = b21 + b22;
-
-    ComplexMatrix* m1 = strassenRecursion(&d1, &d2);
-    ComplexMatrix* m2 = strassenRecursion(&d3, &b11);
-    ComplexMatrix* m3 = strassenRecursion(&a11, &d4);
-    ComplexMatrix* m4 = strassenRecursion(&a22, &d5);
-    ComplexMatrix* m5 = strassenRecursion(&d6, &(b22));
-    ComplexMatrix* m6 = strassenRecursion(&d7, &d8);
-    ComplexMatrix* m7 = strassenRecursion(&d9, &d10);
-
-    ComplexMatrix r1 = *m1 + *m4 - *m5 + *m7;
-    ComplexMatrix r2 = *m3 + *m5;
-    ComplexMatrix r3 = *m2 + *m4;
-    ComplexMatrix r4 = *m1 - *m2 + *m3 + *m6;
-
-    ComplexMatrix* result = new ComplexMatrix(m, q);
-    for (int i = 0; i < newM; i++) {
-        for (int j = 0; j < newQ; j++) {
-            result->set(i, j, r1.get(i, j));
-            if ((j + newQ) < q) {
-                result->set(i, j + newQ, r2.get(i, j));
-            }
-            if ((i + newM) < m) {
-                result->set(i + newM, j, r3.get(i, j));
-            }
-            if ((i + newM) < m && (j + newQ) < q) {
-                result->set(i + newM, j + newQ, r4.get(i, j));
-            }
-        }
+    StrassenWorkspace& workspace = StrassenWorkspace::local();
+    workspace.reserve(StrassenWorkspace::winogradRequiredBytes<T>(m, n, q, a.getLayout(), cutoff()));
+    winogradRecursion(a.block(0, 0, m, n), b.block(0, 0, n, q), result.block(0, 0, m, q), workspace, mode);
+}
+
+template <typename T>
+void BasicStrassen<T>::winogradRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, StrassenWorkspace& workspace, MultiplyMode mode) {
+    int n = a.getColumns();
+    int m = a.getRows();
+    int q = b.getColumns();
+    if (n <= cutoff() || m <= cutoff() || q <= cutoff()) {
+        regularMult(a, b, result, mode);
+        return;
     }
 
-    delete m1;
-    delete m2;
-    delete m3;
-    delete m4;
-    delete m5;
-    delete m6;
-    delete m7;
-    return result;
+    int evenM = m - m % 2;
+    int evenN = n - n % 2;
+    int evenQ = q - q % 2;
+    BasicComplexMatrixView<T> core = result.block(0, 0, evenM, evenQ);
+    winogradLevel(a.block(0, 0, evenM, evenN), b.block(0, 0, evenN, evenQ), core, workspace, mode);
+
+    // Peeled edges: the last inner index as a rank-1 update, then the last column and row of result.
+    if (n != evenN)
+        BasicComplexGemm<T>::multiply(a.block(0, evenN, evenM, 1), b.block(evenN, 0, 1, evenQ), core, true, mode);
+    if (q != evenQ)
+        BasicComplexGemm<T>::multiply(a, b.block(0, evenQ, n, 1), result.block(0, evenQ, m, 1), false, mode);
+    if (m != evenM)
+        BasicComplexGemm<T>::multiply(a.block(evenM, 0, 1, n), b.block(0, 0, n, evenQ), result.block(evenM, 0, 1, evenQ), false, mode);
 }
 
-ComplexMatrix* Strassen::strassenMultiply(ComplexMatrix* a, ComplexMatrix* b) {
+template <typename T>
+void BasicStrassen<T>::winogradLevel(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, StrassenWorkspace& workspace, MultiplyMode mode) {
+    int newM = a.getRows() / 2;
+    int newN = a.getColumns() / 2;
+    int newQ = b.getColumns() / 2;
+    StorageLayout layout = a.getLayout();
+    std::size_t frame = workspace.mark();
+
+    BasicComplexMatrixView<T> a11 = a.block(0, 0, newM, newN);
+    BasicComplexMatrixView<T> a12 = a.block(0, newN, newM, newN);
+    BasicComplexMatrixView<T> a21 = a.block(newM, 0, newM, newN);
+    BasicComplexMatrixView<T> a22 = a.block(newM, newN, newM, newN);
+
+    BasicComplexMatrixView<T> b11 = b.block(0, 0, newN, newQ);
+    BasicComplexMatrixView<T> b12 = b.block(0, newQ, newN, newQ);
+    BasicComplexMatrixView<T> b21 = b.block(newN, 0, newN, newQ);
+    BasicComplexMatrixView<T> b22 = b.block(newN, newQ, newN, newQ);
+
+    BasicComplexMatrixView<T> c11 = result.block(0, 0, newM, newQ);
+    BasicComplexMatrixView<T> c12 = result.block(0, newQ, newM, newQ);
+    BasicComplexMatrixView<T> c21 = result.block(newM, 0, newM, newQ);
+    BasicComplexMatrixView<T> c22 = result.block(newM, newQ, newM, newQ);
+
+    // X holds the A-side sums and later P1, Y the B-side sums.
+    BasicComplexMatrixView<T> x = workspace.template allocate<T>(newM, std::max(newN, newQ), layout);
+    BasicComplexMatrixView<T> s = x.block(0, 0, newM, newN);
+    BasicComplexMatrixView<T> p1 = x.block(0, 0, newM, newQ);
+    BasicComplexMatrixView<T> t = workspace.template allocate<T>(newN, newQ, layout);
+
+    s.assign(a11 - a21);                                  // S3
+    t.assign(b22 - b12);                                  // T3
+    winogradRecursion(s, t, c21, workspace, mode);        // P7 = S3 T3
+    s.assign(a21 + a22);                                  // S1
+    t.assign(b12 - b11);                                  // T1
+    winogradRecursion(s, t, c22, workspace, mode);        // P5 = S1 T1
+    s.assign(s - a11);                                    // S2 = S1 - A11
+    t.assign(b22 - t);                                    // T2 = B22 - T1
+    winogradRecursion(s, t, c12, workspace, mode);        // P6 = S2 T2
+    s.assign(a12 - s);                                    // S4 = A12 - S2
+    winogradRecursion(s, b22, c11, workspace, mode);      // P3 = S4 B22
+    winogradRecursion(a11, b11, p1, workspace, mode);     // P1 = A11 B11
+    c12.assign(p1 + c12);                                 // U2 = P1 + P6
+    c21.assign(c12 + c21);                                // U3 = U2 + P7
+    c12.assign(c12 + c22);                                // U4 = U2 + P5
+    c22.assign(c21 + c22);                                // U7 = U3 + P5
+    c12.assign(c12 + c11);                                // U5 = U4 + P3
+    t.assign(t - b21);                                    // T4 = T2 - B21
+    winogradRecursion(a22, t, c11, workspace, mode);      // P4 = A22 T4
+    c21.assign(c21 - c11);                                // U6 = U3 - P4
+    winogradRecursion(a12, b21, c11, workspace, mode);    // P2 = A12 B21
+    c11.assign(p1 + c11);                                 // U1 = P1 + P2
+
+    workspace.rewind(frame);
+}
+
+template <typename T>
+BasicComplexMatrix<T>* BasicStrassen<T>::winogradMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode) {
     assert(a->getColumns() == b->getRows());
-    if (a->getColumns() <= 8 || a->getRows() <= 8 || b->getColumns() <= 8) {
-        return regularMult(a, b);
+    BasicComplexMatrix<T>* result = new BasicComplexMatrix<T>(a->getRows(), b->getColumns(), a->getLayout());
+    winogradRecursion(BasicComplexMatrixView<T>(*a), BasicComplexMatrixView<T>(*b), BasicComplexMatrixView<T>(*result), mode);
+    return result;
+}
+
+template <typename T>
+void BasicStrassen<T>::mortonRecursion(const BasicMortonComplexMatrix<T>& a, const BasicMortonComplexMatrix<T>& b, BasicMortonComplexMatrix<T>& result, MultiplyMode mode) {
+    assert(a.getColumns() == b.getRows());
+    assert(a.getTile() == b.getTile() && a.getLevels() == b.getLevels());
+
+    result = BasicMortonComplexMatrix<T>(a.getRows(), b.getColumns(), a.getTile(), a.getLevels());
+    StrassenWorkspace& workspace = StrassenWorkspace::local();
+    workspace.reserve(StrassenWorkspace::mortonRequiredBytes<T>(a.getTile(), a.getLevels()));
+    mortonLevel(a.data(), b.data(), result.data(), a.getLevels(), a.getTile(), workspace, mode);
+}
+
+template <typename T>
+BasicComplexMatrix<T>* BasicStrassen<T>::mortonMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode) {
+    int tile = 1;
+    int levels = 0;
+    BasicMortonComplexMatrix<T>::shapeFor(std::max({ a->getRows(), a->getColumns(), b->getColumns() }), cutoff(), tile, levels);
+    BasicMortonComplexMatrix<T> product;
+    mortonRecursion(BasicMortonComplexMatrix<T>::fromMatrix(*a, tile, levels), BasicMortonComplexMatrix<T>::fromMatrix(*b, tile, levels), product, mode);
+    return new BasicComplexMatrix<T>(product.toMatrix(a->getLayout()));
+}
+
+template <typename T>
+void BasicStrassen<T>::mortonLevel(const BasicComplexNum<T>* a, const BasicComplexNum<T>* b, BasicComplexNum<T>* result, int level, int tile, StrassenWorkspace& workspace, MultiplyMode mode) {
+    if (level == 0) {
+        // Views are mutable handles, but the GEMM only reads through its operands.
+        regularMult(BasicComplexMatrixView<T>(const_cast<BasicComplexNum<T>*>(a), tile, tile, tile),
+            BasicComplexMatrixView<T>(const_cast<BasicComplexNum<T>*>(b), tile, tile, tile),
+            BasicComplexMatrixView<T>(result, tile, tile, tile), mode);
+        return;
     }
 
-    return strassenRecursion(a, b);
+    const std::size_t quarter = static_cast<std::size_t>(tile) * tile << (2 * (level - 1));
+    const BasicComplexNum<T>* a11 = a;
+    const BasicComplexNum<T>* a12 = a + quarter;
+    const BasicComplexNum<T>* a21 = a + 2 * quarter;
+    const BasicComplexNum<T>* a22 = a + 3 * quarter;
+    const BasicComplexNum<T>* b11 = b;
+    const BasicComplexNum<T>* b12 = b + quarter;
+    const BasicComplexNum<T>* b21 = b + 2 * quarter;
+    const BasicComplexNum<T>* b22 = b + 3 * quarter;
+    BasicComplexNum<T>* c11 = result;
+    BasicComplexNum<T>* c12 = result + quarter;
+    BasicComplexNum<T>* c21 = result + 2 * quarter;
+    BasicComplexNum<T>* c22 = result + 3 * quarter;
+
+    std::size_t frame = workspace.mark();
+    const std::size_t runBytes = quarter * sizeof(BasicComplexNum<T>);
+    BasicComplexNum<T>* left = static_cast<BasicComplexNum<T>*>(workspace.allocateBytes(runBytes));
+    BasicComplexNum<T>* right = static_cast<BasicComplexNum<T>*>(workspace.allocateBytes(runBytes));
+    BasicComplexNum<T>* product = static_cast<BasicComplexNum<T>*>(workspace.allocateBytes(runBytes));
+
+    // M1 = (A11 + A22)(B11 + B22) -> C11, C22
+    addRuns(quarter, a11, a22, left);
+    addRuns(quarter, b11, b22, right);
+    mortonLevel(left, right, c11, level - 1, tile, workspace, mode);
+    std::copy_n(c11, quarter, c22);
+
+    // M2 = (A21 + A22) B11 -> C21, -C22
+    addRuns(quarter, a21, a22, left);
+    mortonLevel(left, b11, c21, level - 1, tile, workspace, mode);
+    deductRun(quarter, c21, c22);
+
+    // M3 = A11 (B12 - B22) -> C12, C22
+    subtractRuns(quarter, b12, b22, right);
+    mortonLevel(a11, right, c12, level - 1, tile, workspace, mode);
+    accumulateRun(quarter, c12, c22);
+
+    // M4 = A22 (B21 - B11) -> C11, C21
+    subtractRuns(quarter, b21, b11, right);
+    mortonLevel(a22, right, product, level - 1, tile, workspace, mode);
+    accumulateRun(quarter, product, c11);
+    accumulateRun(quarter, product, c21);
+
+    // M5 = (A11 + A12) B22 -> -C11, C12
+    addRuns(quarter, a11, a12, left);
+    mortonLevel(left, b22, product, level - 1, tile, workspace, mode);
+    deductRun(quarter, product, c11);
+    accumulateRun(quarter, product, c12);
+
+    // M6 = (A21 - A11)(B11 + B12) -> C22
+    subtractRuns(quarter, a21, a11, left);
+    addRuns(quarter, b11, b12, right);
+    mortonLevel(left, right, product, level - 1, tile, workspace, mode);
+    accumulateRun(quarter, product, c22);
+
+    // M7 = (A12 - A22)(B21 + B22) -> C11
+    subtractRuns(quarter, a12, a22, left);
+    addRuns(quarter, b21, b22, right);
+    mortonLevel(left, right, product, level - 1, tile, workspace, mode);
+    accumulateRun(quarter, product, c11);
+
+    workspace.rewind(frame);
 }
+
+template class BasicStrassen<float>;
+template class BasicStrassen<double>;
+template class BasicStrassen<long double>;
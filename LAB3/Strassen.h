@@ -1,13 +1,69 @@
 #pragma once
 #include <iostream>
 #include "ComplexMatrix.h"
+#include "ComplexMatrixView.h"
+#include "StrassenWorkspace.h"
+#include "MortonComplexMatrix.h"
+#include "ComplexGemm.h"
+#include "TuningProfile.h"
 
-class Strassen {
+template <typename T>
+class BasicStrassen {
 public:
+    /// @brief Default recursion cutoff: the regular product takes over once a dimension is <= it.
+    constexpr static const int CUTOFF = TuningProfile::DEFAULT_STRASSEN_CUTOFF;
 
-    static ComplexMatrix* regularMult(ComplexMatrix* a, ComplexMatrix* b);
+    /// @brief Cutoff of the active TuningProfile, which every recursion level checks.
+    static int cutoff();
 
-    static ComplexMatrix* strassenRecursion(ComplexMatrix* a, ComplexMatrix* b);
+    static BasicComplexMatrix<T>* regularMult(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode = MultiplyMode::Classic);
 
-    static ComplexMatrix* strassenMultiply(ComplexMatrix* a, ComplexMatrix* b);
+    static void regularMult(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, MultiplyMode mode = MultiplyMode::Classic);
+
+    static BasicComplexMatrix<T>* strassenRecursion(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode = MultiplyMode::Classic);
+
+    /// @brief Writes a * b into result. Quadrants are taken as views of a, b and result, so odd
+    /// dimensions are handled by the views' implicit zero padding instead of copies.
+    /// Temporaries come from the calling thread's StrassenWorkspace, sized once per call.
+    /// With MultiplyMode::ThreeM the leaves use the 3M product, so each level's 7/8 of the
+    /// products compounds with the leaves' 3/4 of the real multiplies.
+    static void strassenRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, MultiplyMode mode = MultiplyMode::Classic);
+
+    static BasicComplexMatrix<T>* strassenMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode = MultiplyMode::Classic);
+
+    /// @brief Writes a * b into result with the Winograd variant (7 products, 15 additions) in the
+    /// memory-minimal schedule of Boyer, Dumas, Pernet and Zhou: each level needs one A-quadrant
+    /// and one B-quadrant temporary and keeps the other intermediates in the quadrants of result.
+    /// Odd dimensions are peeled off and finished with the GEMM, so every recursive operand is a
+    /// fully backed view; the scratch is a fraction of strassenRecursion's 17 blocks per level.
+    static void winogradRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, MultiplyMode mode = MultiplyMode::Classic);
+
+    static BasicComplexMatrix<T>* winogradMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode = MultiplyMode::Classic);
+
+    /// @brief result = a * b for Morton operands of one tile and level count; result is reset to
+    /// a.getRows() x b.getColumns() in that shape. A quadrant is a pointer offset, quadrant sums
+    /// are flat loops over contiguous runs and the leaves are tile x tile GEMMs, so every level
+    /// streams through contiguous memory without a cutoff of its own. Each level takes three
+    /// quadrant blocks from the calling thread's StrassenWorkspace and writes four of the seven
+    /// products straight into quadrants of result.
+    static void mortonRecursion(const BasicMortonComplexMatrix<T>& a, const BasicMortonComplexMatrix<T>& b, BasicMortonComplexMatrix<T>& result, MultiplyMode mode = MultiplyMode::Classic);
+
+    /// @brief Converts a and b to Morton layout with leaves of at most cutoff() per side, runs
+    /// mortonRecursion and converts the product back to a's storage layout.
+    static BasicComplexMatrix<T>* mortonMultiply(BasicComplexMatrix<T>* a, BasicComplexMatrix<T>* b, MultiplyMode mode = MultiplyMode::Classic);
+
+private:
+
+    /// @brief One level of mortonRecursion on blocks level levels above the leaves.
+    static void mortonLevel(const BasicComplexNum<T>* a, const BasicComplexNum<T>* b, BasicComplexNum<T>* result, int level, int tile, StrassenWorkspace& workspace, MultiplyMode mode);
+
+    /// @brief Winograd recursion over fully backed operands: peels odd edges, recurses on the even core.
+    static void winogradRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, StrassenWorkspace& workspace, MultiplyMode mode);
+
+    /// @brief One Winograd level on even dimensions, following the 22-step schedule.
+    static void winogradLevel(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, StrassenWorkspace& workspace, MultiplyMode mode);
+
+    static void strassenRecursion(const BasicComplexMatrixView<T>& a, const BasicComplexMatrixView<T>& b, BasicComplexMatrixView<T> result, StrassenWorkspace& workspace, MultiplyMode mode);
 };
+
+using Strassen = BasicStrassen<double>;
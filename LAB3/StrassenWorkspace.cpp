@@ -0,0 +1,163 @@
+#include "StrassenWorkspace.h"
+#include <algorithm>
+#include <stdexcept>
+
+StrassenWorkspace::StrassenWorkspace() : buffer(nullptr), capacity(0), offset(0), allocator(nullptr) {}
+
+StrassenWorkspace::~StrassenWorkspace()
+{
+    if (buffer)
+        allocator->deallocate(buffer, capacity);
+}
+
+StrassenWorkspace& StrassenWorkspace::local()
+{
+    thread_local StrassenWorkspace workspace;
+    return workspace;
+}
+
+std::size_t StrassenWorkspace::alignedBytes(std::size_t bytes)
+{
+    return (bytes + ComplexMatrix::ALIGNMENT - 1) / ComplexMatrix::ALIGNMENT * ComplexMatrix::ALIGNMENT;
+}
+
+template <typename T>
+std::size_t StrassenWorkspace::matrixBytes(int rows, int columns, StorageLayout layout)
+{
+    std::size_t elements = static_cast<std::size_t>(rows) * BasicComplexMatrix<T>::strideFor(columns, layout);
+    return alignedBytes(layout == StorageLayout::Split ? 2 * elements * sizeof(T) : elements * sizeof(BasicComplexNum<T>));
+}
+
+template <typename T>
+std::size_t StrassenWorkspace::levelBytes(int m, int n, int q, StorageLayout layout)
+{
+    int newN = n / 2 + n % 2;
+    int newM = m / 2 + m % 2;
+    int newQ = q / 2 + q % 2;
+    return 5 * matrixBytes<T>(newM, newN, layout) + 5 * matrixBytes<T>(newN, newQ, layout) + 7 * matrixBytes<T>(newM, newQ, layout);
+}
+
+template <typename T>
+std::size_t StrassenWorkspace::requiredBytes(int m, int n, int q, StorageLayout layout, int cutoff)
+{
+    std::size_t total = 0;
+    while (n > cutoff && m > cutoff && q > cutoff)
+    {
+        total += levelBytes<T>(m, n, q, layout);
+        n = n / 2 + n % 2;
+        m = m / 2 + m % 2;
+        q = q / 2 + q % 2;
+    }
+    return total;
+}
+
+template <typename T>
+std::size_t StrassenWorkspace::winogradLevelBytes(int m, int n, int q, StorageLayout layout)
+{
+    return matrixBytes<T>(m / 2, std::max(n / 2, q / 2), layout) + matrixBytes<T>(n / 2, q / 2, layout);
+}
+
+template <typename T>
+std::size_t StrassenWorkspace::winogradRequiredBytes(int m, int n, int q, StorageLayout layout, int cutoff)
+{
+    std::size_t total = 0;
+    while (n > cutoff && m > cutoff && q > cutoff)
+    {
+        total += winogradLevelBytes<T>(m, n, q, layout);
+        n /= 2;
+        m /= 2;
+        q /= 2;
+    }
+    return total;
+}
+
+template <typename T>
+std::size_t StrassenWorkspace::mortonRequiredBytes(int tile, int levels)
+{
+    std::size_t total = 0;
+    for (int level = levels; level > 0; level--)
+    {
+        std::size_t quarter = static_cast<std::size_t>(tile) * tile << (2 * (level - 1));
+        total += 3 * alignedBytes(quarter * sizeof(BasicComplexNum<T>));
+    }
+    return total;
+}
+
+void StrassenWorkspace::reserve(std::size_t bytes)
+{
+    if (capacity - offset >= bytes)
+        return;
+
+    // Views handed out point into the buffer, so it cannot be replaced under them.
+    if (offset != 0)
+        throw std::logic_error("StrassenWorkspace::reserve cannot grow while blocks are handed out");
+    if (buffer)
+        allocator->deallocate(buffer, capacity);
+    allocator = &MatrixAllocator::current();
+    buffer = static_cast<char*>(allocator->allocate(bytes));
+    capacity = bytes;
+}
+
+std::size_t StrassenWorkspace::mark() const
+{
+    return offset;
+}
+
+void StrassenWorkspace::rewind(std::size_t mark)
+{
+    assert(mark <= offset);
+    offset = mark;
+}
+
+std::size_t StrassenWorkspace::getCapacity() const
+{
+    return capacity;
+}
+
+void* StrassenWorkspace::allocateBytes(std::size_t bytes)
+{
+    bytes = alignedBytes(bytes);
+    assert(offset + bytes <= capacity);
+
+    char* block = buffer + offset;
+    offset += bytes;
+    return block;
+}
+
+template <typename T>
+BasicComplexMatrixView<T> StrassenWorkspace::allocate(int rows, int columns, StorageLayout layout)
+{
+    char* block = static_cast<char*>(allocateBytes(matrixBytes<T>(rows, columns, layout)));
+
+    int stride = BasicComplexMatrix<T>::strideFor(columns, layout);
+    if (layout == StorageLayout::Split)
+    {
+        T* real = reinterpret_cast<T*>(block);
+        return BasicComplexMatrixView<T>(real, real + static_cast<std::size_t>(rows) * stride, rows, columns, stride);
+    }
+    return BasicComplexMatrixView<T>(reinterpret_cast<BasicComplexNum<T>*>(block), rows, columns, stride);
+}
+
+template std::size_t StrassenWorkspace::matrixBytes<float>(int rows, int columns, StorageLayout layout);
+template std::size_t StrassenWorkspace::levelBytes<float>(int m, int n, int q, StorageLayout layout);
+template std::size_t StrassenWorkspace::requiredBytes<float>(int m, int n, int q, StorageLayout layout, int cutoff);
+template std::size_t StrassenWorkspace::winogradLevelBytes<float>(int m, int n, int q, StorageLayout layout);
+template std::size_t StrassenWorkspace::winogradRequiredBytes<float>(int m, int n, int q, StorageLayout layout, int cutoff);
+template std::size_t StrassenWorkspace::mortonRequiredBytes<float>(int tile, int levels);
+template BasicComplexMatrixView<float> StrassenWorkspace::allocate<float>(int rows, int columns, StorageLayout layout);
+
+template std::size_t StrassenWorkspace::matrixBytes<double>(int rows, int columns, StorageLayout layout);
+template std::size_t StrassenWorkspace::levelBytes<double>(int m, int n, int q, StorageLayout layout);
+template std::size_t StrassenWorkspace::requiredBytes<double>(int m, int n, int q, StorageLayout layout, int cutoff);
+template std::size_t StrassenWorkspace::winogradLevelBytes<double>(int m, int n, int q, StorageLayout layout);
+template std::size_t StrassenWorkspace::winogradRequiredBytes<double>(int m, int n, int q, StorageLayout layout, int cutoff);
+template std::size_t StrassenWorkspace::mortonRequiredBytes<double>(int tile, int levels);
+template BasicComplexMatrixView<double> StrassenWorkspace::allocate<double>(int rows, int columns, StorageLayout layout);
+
+template std::size_t StrassenWorkspace::matrixBytes<long double>(int rows, int columns, StorageLayout layout);
+template std::size_t StrassenWorkspace::levelBytes<long double>(int m, int n, int q, StorageLayout layout);
+template std::size_t StrassenWorkspace::requiredBytes<long double>(int m, int n, int q, StorageLayout layout, int cutoff);
+template std::size_t StrassenWorkspace::winogradLevelBytes<long double>(int m, int n, int q, StorageLayout layout);
+template std::size_t StrassenWorkspace::winogradRequiredBytes<long double>(int m, int n, int q, StorageLayout layout, int cutoff);
+template std::size_t StrassenWorkspace::mortonRequiredBytes<long double>(int tile, int levels);
+template BasicComplexMatrixView<long double> StrassenWorkspace::allocate<long double>(int rows, int columns, StorageLayout layout);
@@ -0,0 +1,75 @@
+#pragma once
+#include "ComplexMatrix.h"
+#include "ComplexMatrixView.h"
+#include <cstddef>
+
+/// @brief Bump-pointer arena for Strassen recursion temporaries.
+/// The scratch size of a whole multiplication is computed up front, reserved once, and handed
+/// out level by level; each level rewinds to its mark on return. One arena lives per thread
+/// (see local()) and keeps its buffer between calls, so repeated multiplies do not allocate.
+class StrassenWorkspace
+{
+private:
+    char* buffer;
+    std::size_t capacity;
+    std::size_t offset;
+    MatrixAllocator* allocator;
+
+public:
+    StrassenWorkspace();
+
+    StrassenWorkspace(const StrassenWorkspace&) = delete;
+
+    StrassenWorkspace& operator =(const StrassenWorkspace&) = delete;
+
+    ~StrassenWorkspace();
+
+    /// @brief Arena of the calling thread.
+    static StrassenWorkspace& local();
+
+    /// @brief bytes rounded up to a whole number of cache lines, the granule of the arena.
+    static std::size_t alignedBytes(std::size_t bytes);
+
+    template <typename T>
+    static std::size_t matrixBytes(int rows, int columns, StorageLayout layout);
+
+    /// @brief Scratch used by one recursion level: 10 operand sums and 7 products.
+    template <typename T>
+    static std::size_t levelBytes(int m, int n, int q, StorageLayout layout);
+
+    /// @brief Scratch used by a full sequential recursion that stops once a dimension is <= cutoff.
+    template <typename T>
+    static std::size_t requiredBytes(int m, int n, int q, StorageLayout layout, int cutoff);
+
+    /// @brief Scratch used by one Strassen-Winograd level: one A-quadrant sized block that also
+    /// holds P1, and one B-quadrant sized block. Odd dimensions are peeled, so halves round down.
+    template <typename T>
+    static std::size_t winogradLevelBytes(int m, int n, int q, StorageLayout layout);
+
+    /// @brief Scratch used by a full Strassen-Winograd recursion that stops once a dimension is <= cutoff.
+    template <typename T>
+    static std::size_t winogradRequiredBytes(int m, int n, int q, StorageLayout layout, int cutoff);
+
+    /// @brief Scratch used by a Strassen recursion over Morton operands with the given leaf side
+    /// and levels: three contiguous quadrant blocks per level.
+    template <typename T>
+    static std::size_t mortonRequiredBytes(int tile, int levels);
+
+    /// @brief Makes sure at least bytes are free. May only grow the buffer while nothing is handed
+    /// out; growing past a mark throws std::logic_error rather than free live scratch.
+    void reserve(std::size_t bytes);
+
+    std::size_t mark() const;
+
+    void rewind(std::size_t mark);
+
+    std::size_t getCapacity() const;
+
+    /// @brief Hands out an uninitialized rows x columns block with a cache-line aligned stride.
+    template <typename T>
+    BasicComplexMatrixView<T> allocate(int rows, int columns, StorageLayout layout);
+
+    /// @brief Hands out an uninitialized, cache-line aligned run of bytes, for scratch that is a
+    /// flat array rather than a matrix (e.g. Morton quadrants, which can exceed int elements).
+    void* allocateBytes(std::size_t bytes);
+};
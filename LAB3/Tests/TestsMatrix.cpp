@@ -3,6 +3,42 @@
 #include "../ComplexMatrix.h"
 #include "../MatrixInverseFactory.h"
 #include "../TimeMatrixInverseFactory.h"
+#include "../ParallelStrassen.h"
+#include "../FixedComplexMatrix.h"
+#include "../LUFactorization.h"
+#include "../SparseComplexMatrix.h"
+#include "../BandedLUFactorization.h"
+#include "../OutOfCoreLUFactorization.h"
+#include "../ComplexGemm.h"
+#include "../ComplexKernels.h"
+#include "../Autotuner.h"
+#include "../ThreadPool.h"
+#include "../ComplexBatch.h"
+#include "../ComplexGemv.h"
+#include "../ComplexHerk.h"
+#include "../MortonComplexMatrix.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <cstdint>
+#include <stdexcept>
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    /// @brief Tests run with a fixed profile instead of this host's tuned one, and with a small
+    /// cutoff so that the test-sized products actually go through the Strassen recursion.
+    TuningProfile testProfile()
+    {
+        TuningProfile profile = TuningProfile::defaults();
+        profile.strassenCutoff = 8;
+        return profile;
+    }
+
+    const bool testProfileActive = (TuningProfile::setActive(testProfile()), true);
+}
 
 bool isIdentityMatrix(ComplexMatrix& matrix) {
     int rows = matrix.getRows();
@@ -504,3 +540,1254 @@ TEST_CASE("Matrix Inverse Algorithms with complex values with random values and
         std::cout << "Average Parallel Gauss-Jordan Inverse Execution Time: " << averageExecutionTime << " seconds" << std::endl;
     }
 }
+
+TEST_CASE("ComplexMatrix contiguous storage") {
+    ComplexMatrix A(3, 5);
+    CHECK(A.getStride() >= A.getColumns());
+    CHECK(reinterpret_cast<std::uintptr_t>(A.data()) % ComplexMatrix::ALIGNMENT == 0);
+    CHECK(A.row(1) == A.data() + A.getStride());
+
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 5; j++)
+            A.set(i, j, ComplexNum(i, j));
+
+    ComplexMatrix B = A;
+    B.swapRows(0, 2);
+    for (int j = 0; j < 5; j++) {
+        CHECK(B.get(0, j) == ComplexNum(2, j));
+        CHECK(B.get(2, j) == ComplexNum(0, j));
+        CHECK(A.get(0, j) == ComplexNum(0, j));
+    }
+}
+
+TEST_CASE("ComplexMatrix move semantics and compound operators") {
+    ComplexMatrix A(4, 3);
+    ComplexMatrix B(4, 3);
+    A.auto_gen(-10, 10, -10, 10);
+    B.auto_gen(-10, 10, -10, 10);
+
+    ComplexMatrix sum = A + B;
+    ComplexMatrix C = A;
+    C += B;
+    CHECK(C == sum);
+    C -= B;
+    CHECK(C == A);
+
+    ComplexMatrix D;
+    A.subtractTo(B, D);
+    CHECK(D == A - B);
+
+    const ComplexNum* buffer = C.data();
+    ComplexMatrix moved = std::move(C);
+    CHECK(moved.data() == buffer);
+    CHECK(C.getRows() == 0);
+    CHECK(moved == A);
+}
+
+TEST_CASE("Strassen multiplication matches the naive product") {
+    ComplexMatrix A(37, 29);
+    ComplexMatrix B(29, 41);
+    A.auto_gen(-20, 20, -20, 20);
+    B.auto_gen(-20, 20, -20, 20);
+
+    ComplexMatrix* product = Strassen::strassenMultiply(&A, &B);
+    CHECK(*product == A * B);
+    delete product;
+}
+
+TEST_CASE("Split storage layout") {
+    ComplexMatrix A(19, 23);
+    ComplexMatrix B(23, 17);
+    A.auto_gen(-20, 20, -20, 20);
+    B.auto_gen(-20, 20, -20, 20);
+
+    ComplexMatrix splitA = A.toLayout(StorageLayout::Split);
+    ComplexMatrix splitB = B.toLayout(StorageLayout::Split);
+    CHECK(splitA.isSplit());
+    CHECK(splitA == A);
+    CHECK(splitA.toLayout(StorageLayout::Interleaved).data() != nullptr);
+
+    ComplexMatrix product = A * B;
+    CHECK(splitA * splitB == product);
+    CHECK(splitA * B == product);
+    CHECK(ComplexMatrix(splitA + splitA) == A + A);
+
+    ComplexMatrix* strassen = Strassen::strassenMultiply(&splitA, &splitB);
+    CHECK(strassen->isSplit());
+    CHECK(*strassen == product);
+    delete strassen;
+}
+
+TEST_CASE("ComplexMatrixView aliases its parent") {
+    ComplexMatrix A(5, 7);
+    A.auto_gen(-10, 10, -10, 10);
+
+    ComplexMatrixView view(A, 3, 4, 4, 4);
+    CHECK(view.getValidRows() == 2);
+    CHECK(view.getValidColumns() == 3);
+    CHECK(view.get(1, 2) == A.get(4, 6));
+    CHECK(view.get(3, 3) == ComplexNum(0, 0));
+
+    view.set(0, 0, ComplexNum(100, -100));
+    view.set(3, 3, ComplexNum(1, 1));
+    CHECK(A.get(3, 4) == ComplexNum(100, -100));
+
+    ComplexMatrixView inner = view.block(1, 1, 2, 2);
+    CHECK(inner.getValidRows() == 1);
+    CHECK(inner.get(0, 1) == A.get(4, 6));
+}
+
+TEST_CASE("Parallel Strassen multiplication handles ragged blocks") {
+    ComplexMatrix A(300, 270);
+    ComplexMatrix B(270, 290);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+
+    ComplexMatrix* product = ParallelStrassen::parallelMultiply(&A, &B);
+    CHECK(*product == A * B);
+    delete product;
+}
+
+TEST_CASE("Lazy matrix expressions") {
+    ComplexMatrix A(6, 5);
+    ComplexMatrix B(6, 5);
+    ComplexMatrix C(6, 5, StorageLayout::Split);
+    A.auto_gen(-10, 10, -10, 10);
+    B.auto_gen(-10, 10, -10, 10);
+    C.auto_gen(-10, 10, -10, 10);
+
+    ComplexMatrix fused = A + B - C + A;
+    ComplexNum factor(2, -1);
+    ComplexMatrix scaled = factor * conjugate(A - B);
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 5; j++) {
+            CHECK(fused.get(i, j) == A.get(i, j) + B.get(i, j) - C.get(i, j) + A.get(i, j));
+            ComplexNum diff = A.get(i, j) - B.get(i, j);
+            CHECK(scaled.get(i, j) == ComplexNum(diff.getReal(), -diff.getImag()) * factor);
+        }
+    }
+
+    ComplexMatrix acc = A;
+    acc += B - C;
+    CHECK(acc == fused - A);
+
+    ComplexMatrix target(8, 8);
+    ComplexMatrixView(target, 2, 3, 6, 5).assign(A + B);
+    CHECK(target.get(2, 3) == A.get(0, 0) + B.get(0, 0));
+    CHECK(target.get(7, 7) == A.get(5, 4) + B.get(5, 4));
+    CHECK(target.get(0, 0) == ComplexNum(0, 0));
+
+    // All-split operands take the dense path; a view past the backed extent takes the padded one.
+    ComplexMatrix splitA = A.toLayout(StorageLayout::Split);
+    ComplexMatrix splitB = B.toLayout(StorageLayout::Split);
+    ComplexMatrix splitSum = factor * (splitA + conjugate(splitB)) - C;
+    CHECK(splitSum.getLayout() == StorageLayout::Split);
+    ComplexMatrix padded(6, 5);
+    padded = ComplexMatrixView(A, 2, 1, 6, 5) + ComplexMatrixView(B);
+    bool match = true;
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 5; j++) {
+            ComplexNum b = B.get(i, j);
+            match = match && splitSum.get(i, j) == factor * (A.get(i, j) + ComplexNum(b.getReal(), -b.getImag())) - C.get(i, j);
+            ComplexNum shifted = i + 2 < 6 && j + 1 < 5 ? A.get(i + 2, j + 1) : ComplexNum();
+            match = match && padded.get(i, j) == shifted + B.get(i, j);
+        }
+    }
+    CHECK(match);
+}
+
+TEST_CASE("Strassen workspace is sized once and reused") {
+    ComplexMatrix A(70, 45);
+    ComplexMatrix B(45, 66);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+
+    std::size_t required = StrassenWorkspace::requiredBytes<double>(70, 45, 66, StorageLayout::Interleaved, Strassen::cutoff());
+    CHECK(required > 0);
+
+    ComplexMatrix* first = Strassen::strassenMultiply(&A, &B);
+    StrassenWorkspace& workspace = StrassenWorkspace::local();
+    std::size_t capacity = workspace.getCapacity();
+    CHECK(capacity >= required);
+    CHECK(workspace.mark() == 0);
+
+    ComplexMatrix* second = Strassen::strassenMultiply(&A, &B);
+    CHECK(workspace.getCapacity() == capacity);
+    CHECK(*first == A * B);
+    CHECK(*second == *first);
+    delete first;
+    delete second;
+
+    // Growing under live blocks would free them, so it fails instead; after a rewind it is allowed.
+    StrassenWorkspace scratch;
+    scratch.reserve(1024);
+    BasicComplexMatrixView<double> live = scratch.allocate<double>(4, 4, StorageLayout::Interleaved);
+    CHECK(live.getRows() == 4);
+    CHECK_THROWS_AS(scratch.reserve(1 << 20), std::logic_error);
+    scratch.rewind(0);
+    scratch.reserve(1 << 20);
+    CHECK(scratch.getCapacity() >= std::size_t(1 << 20));
+}
+
+TEST_CASE("Single precision engine") {
+    ComplexMatrixF A(20, 13);
+    ComplexMatrixF B(13, 17);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+
+    ComplexMatrixF* product = BasicStrassen<float>::strassenMultiply(&A, &B);
+    CHECK(*product == A * B);
+    delete product;
+
+    ComplexMatrixF M(3, 3);
+    M.set(0, 0, ComplexNumF(4, 1));
+    M.set(0, 1, ComplexNumF(1, 0));
+    M.set(1, 1, ComplexNumF(3, -1));
+    M.set(1, 2, ComplexNumF(1, 0));
+    M.set(2, 0, ComplexNumF(1, 0));
+    M.set(2, 2, ComplexNumF(2, 2));
+
+    ComplexMatrixF luInverse = BasicMatrixInverseFactory<float>::calculateInverse(M, InverseAlgorithm::LU);
+    ComplexMatrixF gjInverse = BasicMatrixInverseFactory<float>::calculateInverse(M, InverseAlgorithm::GaussJordan);
+    CHECK(luInverse == gjInverse);
+    CHECK(sizeof(ComplexNumF) * 2 == sizeof(ComplexNum));
+}
+
+TEST_CASE("Fixed-size matrices invert on the stack") {
+    ComplexMatrix A(4, 4);
+    A.auto_gen(-5, 5, -5, 5);
+    for (int i = 0; i < 4; i++)
+        A.set(i, i, A.get(i, i) + ComplexNum(40, 0));
+
+    FixedComplexMatrix<4> fixed(A);
+    FixedComplexMatrix<4> luInverse;
+    FixedComplexMatrix<4> gjInverse;
+    CHECK(fixed.luInverse(luInverse));
+    CHECK(fixed.gaussJordanInverse(gjInverse));
+    CHECK(fixed * luInverse == FixedComplexMatrix<4>::identity());
+    CHECK(luInverse == gjInverse);
+    CHECK(luInverse.toMatrix() == LUInverse::calculateLUInverse(A));
+
+    ComplexMatrix B(7, 7);
+    B.auto_gen(-5, 5, -5, 5);
+    for (int i = 0; i < 7; i++)
+        B.set(i, i, B.get(i, i) + ComplexNum(60, 0));
+    ComplexMatrix inverse = MatrixInverseFactory::calculateInverse(B, InverseAlgorithm::ParallelGaussJordan);
+    ComplexMatrix product = B * inverse;
+    CHECK(isIdentityMatrix(product));
+
+    FixedComplexMatrix<2> singular;
+    singular.set(0, 0, ComplexNum(1, 0));
+    singular.set(0, 1, ComplexNum(2, 0));
+    singular.set(1, 0, ComplexNum(2, 0));
+    singular.set(1, 1, ComplexNum(4, 0));
+    FixedComplexMatrix<2> unused;
+    CHECK_FALSE(singular.gaussJordanInverse(unused));
+    CHECK_FALSE(singular.luInverse(unused));
+
+    // A permutation has zeros on the diagonal; the pivoted LU inverts it to its transpose.
+    FixedComplexMatrix<4> permutation;
+    const int order[4] = { 2, 0, 3, 1 };
+    for (int i = 0; i < 4; i++)
+        permutation.set(i, order[i], ComplexNum(1, 0));
+    FixedComplexMatrix<4> permutationInverse;
+    REQUIRE(permutation.luInverse(permutationInverse));
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            CHECK(permutationInverse.get(i, j) == ComplexNum(order[j] == i ? 1 : 0, 0));
+
+    // A tiny leading pivot is swapped away instead of amplifying rounding.
+    ComplexMatrix C(4, 4);
+    C.auto_gen(-5, 5, -5, 5);
+    C.set(0, 0, ComplexNum(1e-5, 0));
+    FixedComplexMatrix<4> fixedC(C);
+    FixedComplexMatrix<4> luInverseC;
+    FixedComplexMatrix<4> gjInverseC;
+    REQUIRE(fixedC.luInverse(luInverseC));
+    REQUIRE(fixedC.gaussJordanInverse(gjInverseC));
+    for (const FixedComplexMatrix<4>& inverseC : { luInverseC, gjInverseC }) {
+        FixedComplexMatrix<4> identityC = fixedC * inverseC;
+        double error = 0;
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++) {
+                ComplexNum difference = identityC.get(i, j) - ComplexNum(i == j ? 1 : 0, 0);
+                error = std::max(error, std::abs(difference.getReal()) + std::abs(difference.getImag()));
+            }
+        CHECK(error < 1e-13);
+    }
+
+    // A singular small matrix is reported by the fixed path without running a dense algorithm.
+    ComplexMatrix singularDense = singular.toMatrix();
+    for (InverseAlgorithm algorithm : { InverseAlgorithm::LU, InverseAlgorithm::ParallelLU, InverseAlgorithm::GaussJordan, InverseAlgorithm::ParallelGaussJordan })
+        CHECK(MatrixInverseFactory::calculateInverse(singularDense, algorithm).getRows() == 0);
+}
+
+TEST_CASE("ComplexNum arithmetic is constexpr and inline") {
+    constexpr ComplexNum a(1, 2);
+    constexpr ComplexNum b(3, -1);
+    static_assert((a * b).getReal() == 5 && (a * b).getImag() == 5, "complex product");
+    static_assert(a + b == ComplexNum(4, 1), "complex sum");
+    static_assert(std::is_trivially_copyable<ComplexNum>::value, "ComplexNum is copied with memcpy");
+
+    ComplexNum acc(1, 1);
+    acc.addProduct(a, b);
+    CHECK(acc == ComplexNum(6, 6));
+    acc.subtractProduct(a, b);
+    CHECK(acc == ComplexNum(1, 1));
+    CHECK((a / b) * b == a);
+}
+
+TEST_CASE("Packed LU factorization with partial pivoting") {
+    ComplexMatrix A(3, 3);
+    A.set(0, 1, ComplexNum(2, 1));
+    A.set(0, 2, ComplexNum(1, 0));
+    A.set(1, 0, ComplexNum(3, 0));
+    A.set(1, 1, ComplexNum(1, -1));
+    A.set(2, 0, ComplexNum(1, 2));
+    A.set(2, 2, ComplexNum(4, 0));
+
+    LUFactorization factorization(A);
+    REQUIRE(factorization.isInvertible());
+    CHECK(factorization.getPivots()[0] == 1);
+
+    ComplexMatrix permuted = A;
+    for (int k = 0; k < 3; k++)
+        permuted.swapRows(k, factorization.getPivots()[k]);
+    ComplexMatrix L(3, 3);
+    ComplexMatrix U(3, 3);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            L.set(i, j, factorization.lower(i, j));
+            U.set(i, j, factorization.upper(i, j));
+        }
+    }
+    CHECK(L * U == permuted);
+    ComplexMatrix product = A * LUInverse::calculateLUInverse(A);
+    CHECK(isIdentityMatrix(product));
+
+    ComplexMatrix B(200, 200);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix sequential = LUFactorization(B).inverse();
+    ComplexMatrix parallel = ParallelLUInverse::calculateParallelLUInverse(B);
+    CHECK(parallel == sequential);
+    // Explicit thread counts split the trailing updates and the solves on the shared pool.
+    LUFactorization pooled(B, 4);
+    CHECK(pooled.packed() == LUFactorization(B).packed());
+    CHECK(pooled.inverse(4) == sequential);
+
+    ComplexMatrix singular(3, 3);
+    singular.set(0, 0, ComplexNum(1, 0));
+    singular.set(1, 0, ComplexNum(2, 0));
+    CHECK_FALSE(LUFactorization(singular).isInvertible());
+    CHECK(LUInverse::calculateLUInverse(singular).getRows() == 0);
+
+    // Only an exactly zero pivot column is singular; tiny but well-conditioned matrices invert.
+    ComplexMatrix tinyIdentity(20, 20);
+    for (int i = 0; i < 20; i++)
+        tinyIdentity.set(i, i, ComplexNum(1e-7, 0));
+    LUFactorization tinyFactorization(tinyIdentity);
+    REQUIRE(tinyFactorization.isInvertible());
+    CHECK(tinyFactorization.inverse().get(7, 7) == ComplexNum(1e7, 0));
+
+    ComplexMatrix tiny(20, 20);
+    tiny.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix unscaled = tiny;
+    tiny = ComplexNum(1e-8, 0) * unscaled;
+    ComplexMatrix tinyInverse = MatrixInverseFactory::calculateInverse(tiny, InverseAlgorithm::LU);
+    REQUIRE(tinyInverse.getRows() == 20);
+    ComplexMatrix tinyProduct = tiny * tinyInverse;
+    CHECK(isIdentityMatrix(tinyProduct));
+}
+
+TEST_CASE("Pluggable allocation backend") {
+    ComplexMatrix A(90, 70);
+    ComplexMatrix B(70, 80);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix expected = A * B;
+
+    AllocationPolicy policy;
+    policy.largeThreshold = 4096;
+    policy.placement = NumaPlacement::Interleave;
+    policy.prefaultThreads = 2;
+    static LargePageAllocator largePages(policy);
+    MatrixAllocator::setCurrent(&largePages);
+
+    ComplexMatrix mapped(90, 80, StorageLayout::Split);
+    CHECK(reinterpret_cast<std::uintptr_t>(mapped.realData()) % ComplexMatrix::ALIGNMENT == 0);
+    CHECK(mapped.get(89, 79) == ComplexNum(0, 0));
+    mapped = A.toLayout(StorageLayout::Split) * B.toLayout(StorageLayout::Split);
+    ComplexMatrix* strassen = Strassen::strassenMultiply(&A, &B);
+
+    MatrixAllocator::setCurrent(nullptr);
+    CHECK(mapped == expected);
+    CHECK(*strassen == expected);
+    delete strassen;
+
+#ifdef __linux__
+    // FirstTouch faults every page in from the pool at allocation; Default leaves them unmapped.
+    auto residentPages = [](void* pointer, std::size_t bytes) {
+        const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        std::vector<unsigned char> residency((bytes + page - 1) / page);
+        mincore(pointer, bytes, residency.data());
+        return std::count_if(residency.begin(), residency.end(), [](unsigned char flags) { return flags & 1; });
+    };
+    const std::size_t bytes = std::size_t(8) << 20;
+    AllocationPolicy firstTouchPolicy;
+    firstTouchPolicy.placement = NumaPlacement::FirstTouch;
+    LargePageAllocator firstTouch(firstTouchPolicy);
+    void* touched = firstTouch.allocate(bytes);
+    CHECK(residentPages(touched, bytes) * sysconf(_SC_PAGESIZE) >= static_cast<long>(bytes));
+    CHECK(static_cast<char*>(touched)[bytes - 1] == 0);
+    firstTouch.deallocate(touched, bytes);
+
+    AllocationPolicy lazyPolicy;
+    lazyPolicy.hugePages = false;
+    LargePageAllocator lazy(lazyPolicy);
+    void* untouched = lazy.allocate(bytes);
+    CHECK(residentPages(untouched, bytes) == 0);
+    lazy.deallocate(untouched, bytes);
+#endif
+}
+
+TEST_CASE("Sparse complex matrices") {
+    ComplexMatrix dense(40, 30);
+    for (int i = 0; i < 40; i++) {
+        dense.set(i, (i * 7) % 30, ComplexNum(i + 1, -i));
+        dense.set(i, (i * 11 + 3) % 30, ComplexNum(2, i % 5));
+    }
+
+    SparseComplexMatrix csr = SparseComplexMatrix::fromDense(dense);
+    SparseComplexMatrix csc = csr.toFormat(SparseFormat::CSC);
+    CHECK(csr.nonZeros() == csc.nonZeros());
+    CHECK(csr.nonZeros() <= 80);
+    CHECK(csr.toDense() == dense);
+    CHECK(csc.toDense() == dense);
+    CHECK(csc.get(5, 5) == dense.get(5, 5));
+    CHECK(csr.get(0, 1) == ComplexNum(0, 0));
+
+    ComplexMatrix B(30, 17);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix expected = dense * B;
+    CHECK(csr * B == expected);
+    CHECK(csc.multiply(B, 4) == expected);
+    CHECK(csr.multiply(B.toLayout(StorageLayout::Split), 3) == expected);
+
+    std::vector<ComplexNum> x(30);
+    for (int j = 0; j < 30; j++)
+        x[j] = ComplexNum(j, 1);
+    std::vector<ComplexNum> y(40);
+    std::vector<ComplexNum> yColumns(40);
+    csr.multiply(x.data(), y.data(), 4);
+    csc.multiply(x.data(), yColumns.data());
+    for (int i = 0; i < 40; i++) {
+        ComplexNum sum;
+        for (int j = 0; j < 30; j++)
+            sum.addProduct(dense.get(i, j), x[j]);
+        CHECK(y[i] == sum);
+        CHECK(yColumns[i] == sum);
+    }
+
+    SparseComplexMatrix doubled = csr + csc;
+    CHECK(doubled.toDense() == dense + dense);
+    CHECK((csr + SparseComplexMatrix::fromTriplets(40, 30, { { 0, 0, ComplexNum(1, 0) }, { 0, 0, ComplexNum(0, 1) } })).get(0, 0)
+        == dense.get(0, 0) + ComplexNum(1, 1));
+}
+
+TEST_CASE("Banded and tridiagonal solvers") {
+    const int n = 60;
+    ComplexMatrix dense(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = std::max(0, i - 2); j <= std::min(n - 1, i + 1); j++)
+            dense.set(i, j, ComplexNum((i * 3 + j * 5) % 7 - 3, (i + 2 * j) % 5 - 2));
+    }
+    dense.set(0, 0, ComplexNum(0, 0));
+
+    int lower = 0;
+    int upper = 0;
+    BandedComplexMatrix::bandwidth(dense, lower, upper);
+    CHECK(lower == 2);
+    CHECK(upper == 1);
+
+    BandedComplexMatrix banded = BandedComplexMatrix::fromDense(dense, lower, upper);
+    CHECK(banded.toDense() == dense);
+
+    BandedLUFactorization factorization(banded);
+    REQUIRE(factorization.isInvertible());
+    std::vector<ComplexNum> x(n);
+    for (int i = 0; i < n; i++)
+        x[i] = ComplexNum(i % 4, 1);
+    std::vector<ComplexNum> b(n);
+    banded.multiply(x.data(), b.data());
+    std::vector<ComplexNum> solved = factorization.solve(b);
+    for (int i = 0; i < n; i++)
+        CHECK(solved[i] == x[i]);
+
+    ComplexMatrix inverse = MatrixInverseFactory::calculateInverse(dense, InverseAlgorithm::GaussJordan);
+    ComplexMatrix product = dense * inverse;
+    CHECK(isIdentityMatrix(product));
+    CHECK(inverse == LUInverse::calculateLUInverse(dense));
+
+    const int large = 100000;
+    TridiagonalComplexMatrix tridiagonal(large);
+    for (int i = 0; i < large; i++) {
+        tridiagonal.set(i, i, ComplexNum(-2, 0.5));
+        if (i + 1 < large) {
+            tridiagonal.set(i, i + 1, ComplexNum(1, 0));
+            tridiagonal.set(i + 1, i, ComplexNum(1, 0));
+        }
+    }
+    std::vector<ComplexNum> ones(large, ComplexNum(1, -1));
+    std::vector<ComplexNum> rhs(large);
+    tridiagonal.multiply(ones.data(), rhs.data());
+    std::vector<ComplexNum> recovered = BandedLUFactorization(tridiagonal).solve(rhs);
+    CHECK(recovered[0] == ones[0]);
+    CHECK(recovered[large / 2] == ones[large / 2]);
+    CHECK(recovered[large - 1] == ones[large - 1]);
+
+    // A band whose entries are all far below ComplexNum's epsilon is still invertible.
+    ComplexMatrix tiny = ComplexNum(1e-8, 0) * dense;
+    BandedLUFactorization tinyFactorization(BandedComplexMatrix::fromDense(tiny, lower, upper));
+    CHECK(tinyFactorization.isInvertible());
+    ComplexMatrix tinyInverse = MatrixInverseFactory::calculateInverse(tiny, InverseAlgorithm::LU);
+    REQUIRE(tinyInverse.getRows() == n);
+    ComplexMatrix tinyProduct = tiny * tinyInverse;
+    CHECK(isIdentityMatrix(tinyProduct));
+}
+
+TEST_CASE("Out-of-core tiled matrices") {
+    const std::string directory = std::filesystem::temp_directory_path().string();
+    const std::string pathA = directory + "/lab3_ooc_a.bin";
+    const std::string pathB = directory + "/lab3_ooc_b.bin";
+    const std::string pathC = directory + "/lab3_ooc_c.bin";
+
+    ComplexMatrix A(70, 45);
+    ComplexMatrix B(45, 52);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+
+    {
+        OutOfCoreComplexMatrix diskA = OutOfCoreComplexMatrix::fromMatrix(pathA, A, 16);
+        OutOfCoreComplexMatrix diskB = OutOfCoreComplexMatrix::fromMatrix(pathB, B, 16);
+        OutOfCoreComplexMatrix diskC = OutOfCoreComplexMatrix::create(pathC, 70, 52, 16);
+        CHECK(diskA.getTileRows() == 5);
+        CHECK(diskA.get(69, 44) == A.get(69, 44));
+        CHECK(diskA.tile(4, 2).getValidRows() == 6);
+
+        OutOfCoreComplexMatrix::multiply(diskA, diskB, diskC);
+        CHECK(diskC.toMatrix() == A * B);
+    }
+    CHECK(OutOfCoreComplexMatrix::open(pathC).toMatrix() == A * B);
+
+    ComplexMatrix M(50, 50);
+    M.auto_gen(-5, 5, -5, 5);
+    {
+        OutOfCoreComplexMatrix diskM = OutOfCoreComplexMatrix::fromMatrix(pathA, M, 16);
+        OutOfCoreLUFactorization factorization(diskM);
+        REQUIRE(factorization.isInvertible());
+
+        std::vector<ComplexNum> x(50);
+        for (int i = 0; i < 50; i++)
+            x[i] = ComplexNum(i % 3, -1);
+        std::vector<ComplexNum> b(50);
+        for (int i = 0; i < 50; i++)
+            for (int j = 0; j < 50; j++)
+                b[i].addProduct(M.get(i, j), x[j]);
+        factorization.solve(b.data());
+        for (int i = 0; i < 50; i++)
+            CHECK(b[i] == x[i]);
+        CHECK(diskM.toMatrix() == LUFactorization(M).packed());
+    }
+    {
+        // Entries far below ComplexNum's epsilon still give non-zero pivots.
+        ComplexMatrix tiny = ComplexNum(1e-8, 0) * M;
+        OutOfCoreComplexMatrix diskTiny = OutOfCoreComplexMatrix::fromMatrix(pathA, tiny, 16);
+        OutOfCoreLUFactorization factorization(diskTiny);
+        CHECK(factorization.isInvertible());
+    }
+
+    std::remove(pathA.c_str());
+    std::remove(pathB.c_str());
+    std::remove(pathC.c_str());
+}
+
+TEST_CASE("Packed blocked GEMM") {
+    // Sizes straddle the MC/KC blocks and leave ragged MR x NR edges.
+    ComplexMatrix A(130, 300), B(300, 77);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+
+    ComplexMatrix expected(130, 77);
+    for (int i = 0; i < 130; i++) {
+        for (int j = 0; j < 77; j++) {
+            ComplexNum sum;
+            for (int k = 0; k < 300; k++)
+                sum.addProduct(A.get(i, k), B.get(k, j));
+            expected.set(i, j, sum);
+        }
+    }
+
+    CHECK(A * B == expected);
+    ComplexMatrix splitA = A.toLayout(StorageLayout::Split);
+    ComplexMatrix splitB = B.toLayout(StorageLayout::Split);
+    CHECK(splitA * B == expected);
+    CHECK(A * splitB == expected);
+    CHECK(splitA * splitB == expected);
+
+    ComplexMatrix splitC(130, 77, StorageLayout::Split);
+    ComplexGemm::multiply(ComplexMatrixView(splitA), ComplexMatrixView(B), ComplexMatrixView(splitC));
+    CHECK(splitC == expected);
+    ComplexGemm::multiply(ComplexMatrixView(A), ComplexMatrixView(splitB), ComplexMatrixView(splitC), true);
+    CHECK(splitC == expected + expected);
+
+    ComplexMatrix C(130, 77, StorageLayout::Interleaved);
+    ComplexGemm::multiply(ComplexMatrixView(A), ComplexMatrixView(B), ComplexMatrixView(C));
+    CHECK(C == expected);
+    ComplexGemm::multiply(ComplexMatrixView(A), ComplexMatrixView(B), ComplexMatrixView(C), true);
+    CHECK(C == expected + expected);
+
+    // Views past the parent's edge contribute zeros and drop writes.
+    ComplexMatrix D(5, 5);
+    ComplexGemm::multiply(ComplexMatrixView(A).block(128, 296, 5, 5), ComplexMatrixView(B).block(296, 75, 5, 5), ComplexMatrixView(D).block(0, 0, 5, 5));
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            ComplexNum sum;
+            for (int k = 296; k < 300; k++)
+                sum.addProduct(A.get(128 + i, k), B.get(k, 75 + j));
+            CHECK(D.get(i, j) == sum);
+        }
+    }
+    CHECK(D.get(4, 4) == ComplexNum(0, 0));
+}
+
+template <typename T>
+void checkKernelsAgainstScalar(SimdIsa isa) {
+    const BasicComplexKernels<T>& scalar = BasicComplexKernels<T>::forIsa(SimdIsa::Scalar);
+    const BasicComplexKernels<T>& vector = BasicComplexKernels<T>::forIsa(isa);
+    CHECK(static_cast<int>(vector.isa) <= static_cast<int>(detectSimdIsa()));
+
+    // Odd lengths exercise the scalar tails behind every vector width.
+    const int n = 37;
+    std::vector<BasicComplexNum<T>> x(n), y(n);
+    std::vector<T> xr(n), xi(n);
+    for (int j = 0; j < n; j++) {
+        x[j] = BasicComplexNum<T>(T(j % 7 - 3), T(j % 5 - 2));
+        y[j] = BasicComplexNum<T>(T(j % 3 - 1), T(j % 4 - 2));
+        xr[j] = x[j].getReal();
+        xi[j] = x[j].getImag();
+    }
+    const BasicComplexNum<T> alpha(T(2), T(-3));
+
+    CHECK(vector.dot(n, x.data(), y.data()) == scalar.dot(n, x.data(), y.data()));
+    CHECK(vector.dotc(n, x.data(), y.data()) == scalar.dotc(n, x.data(), y.data()));
+
+    std::vector<BasicComplexNum<T>> expected = y, actual = y;
+    scalar.axpy(n, alpha, x.data(), expected.data());
+    vector.axpy(n, alpha, x.data(), actual.data());
+    for (int j = 0; j < n; j++)
+        CHECK(actual[j] == expected[j]);
+
+    std::vector<T> yr(n), yi(n);
+    for (int j = 0; j < n; j++) {
+        yr[j] = y[j].getReal();
+        yi[j] = y[j].getImag();
+    }
+    vector.axpySplit(n, alpha, xr.data(), xi.data(), yr.data(), yi.data());
+    for (int j = 0; j < n; j++)
+        CHECK(BasicComplexNum<T>(yr[j], yi[j]) == expected[j]);
+
+    const int rows = BasicComplexKernels<T>::TILE_ROWS;
+    const int columns = BasicComplexKernels<T>::TILE_COLUMNS;
+    const int depth = 9;
+    std::vector<T> a(2 * rows * depth), b(2 * columns * depth);
+    for (std::size_t i = 0; i < a.size(); i++)
+        a[i] = T(int(i % 9) - 4);
+    for (std::size_t i = 0; i < b.size(); i++)
+        b[i] = T(int(i % 7) - 3);
+    std::vector<T> expectedRe(rows * columns), expectedIm(rows * columns), actualRe(rows * columns), actualIm(rows * columns);
+    scalar.gemmTile(depth, a.data(), b.data(), expectedRe.data(), expectedIm.data());
+    vector.gemmTile(depth, a.data(), b.data(), actualRe.data(), actualIm.data());
+    for (int i = 0; i < rows * columns; i++)
+        CHECK(BasicComplexNum<T>(actualRe[i], actualIm[i]) == BasicComplexNum<T>(expectedRe[i], expectedIm[i]));
+
+    const int realRows = BasicComplexKernels<T>::REAL_TILE_ROWS;
+    const int realColumns = BasicComplexKernels<T>::REAL_TILE_COLUMNS;
+    std::vector<T> ra(realRows * depth), rb(realColumns * depth), expectedTile(realRows * realColumns), actualTile(realRows * realColumns);
+    for (std::size_t i = 0; i < ra.size(); i++)
+        ra[i] = T(int(i % 5) - 2);
+    for (std::size_t i = 0; i < rb.size(); i++)
+        rb[i] = T(int(i % 11) - 5);
+    scalar.realGemmTile(depth, ra.data(), rb.data(), expectedTile.data());
+    vector.realGemmTile(depth, ra.data(), rb.data(), actualTile.data());
+    for (int i = 0; i < realRows * realColumns; i++)
+        CHECK(actualTile[i] == expectedTile[i]);
+}
+
+TEST_CASE("Vectorized complex kernels") {
+    for (SimdIsa isa : { SimdIsa::Sse2, SimdIsa::Avx2, SimdIsa::Avx512 }) {
+        checkKernelsAgainstScalar<double>(isa);
+        checkKernelsAgainstScalar<float>(isa);
+    }
+    CHECK(BasicComplexKernels<long double>::active().isa == SimdIsa::Scalar);
+    CHECK(ComplexKernels::active().isa == detectSimdIsa());
+}
+
+TEST_CASE("3M complex multiplication") {
+    ComplexMatrix A(70, 130), B(130, 45);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix expected = A * B;
+
+    CHECK(A.multiply(B, MultiplyMode::ThreeM) == expected);
+    ComplexMatrix splitA = A.toLayout(StorageLayout::Split);
+    ComplexMatrix splitB = B.toLayout(StorageLayout::Split);
+    CHECK(splitA.multiply(B, MultiplyMode::ThreeM) == expected);
+    CHECK(splitA.multiply(splitB, MultiplyMode::ThreeM) == expected);
+
+    ComplexMatrix C(70, 45, StorageLayout::Interleaved);
+    ComplexGemm::multiply(ComplexMatrixView(A), ComplexMatrixView(B), ComplexMatrixView(C), false, MultiplyMode::ThreeM);
+    CHECK(C == expected);
+    ComplexGemm::multiply(ComplexMatrixView(A), ComplexMatrixView(B), ComplexMatrixView(C), true, MultiplyMode::ThreeM);
+    CHECK(C == expected + expected);
+
+    ComplexMatrix splitC(70, 45, StorageLayout::Split);
+    ComplexGemm::multiply(ComplexMatrixView(splitA), ComplexMatrixView(splitB), ComplexMatrixView(splitC), false, MultiplyMode::ThreeM);
+    CHECK(splitC == expected);
+
+    ComplexMatrix* strassen = Strassen::strassenMultiply(&A, &B, MultiplyMode::ThreeM);
+    CHECK(*strassen == expected);
+    delete strassen;
+
+    BasicComplexMatrix<float> F(33, 33);
+    F.auto_gen(-3, 3, -3, 3);
+    CHECK(F.multiply(F, MultiplyMode::ThreeM) == F * F);
+}
+
+TEST_CASE("Strassen-Winograd low-memory schedule") {
+    ComplexMatrix A(67, 45), B(45, 83);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix expected = A * B;
+
+    ComplexMatrix* winograd = Strassen::winogradMultiply(&A, &B);
+    CHECK(*winograd == expected);
+    delete winograd;
+
+    ComplexMatrix splitA = A.toLayout(StorageLayout::Split);
+    ComplexMatrix splitB = B.toLayout(StorageLayout::Split);
+    winograd = Strassen::winogradMultiply(&splitA, &splitB, MultiplyMode::ThreeM);
+    CHECK(*winograd == expected);
+    delete winograd;
+
+    winograd = Strassen::winogradMultiply(&splitA, &B);
+    CHECK(*winograd == expected);
+    delete winograd;
+
+    ComplexMatrix S(100, 100);
+    S.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix* square = Strassen::winogradMultiply(&S, &S);
+    CHECK(*square == S * S);
+    delete square;
+
+    // Views past the backed extent read as zero, the same as in strassenRecursion.
+    ComplexMatrix padded(70, 90);
+    Strassen::winogradRecursion(ComplexMatrixView(A).block(0, 0, 70, 50), ComplexMatrixView(B).block(0, 0, 50, 90), ComplexMatrixView(padded));
+    bool matches = true;
+    for (int i = 0; i < 70; i++)
+        for (int j = 0; j < 90; j++)
+            matches = matches && padded.get(i, j) == (i < 67 && j < 83 ? expected.get(i, j) : ComplexNum());
+    CHECK(matches);
+
+    CHECK(StrassenWorkspace::winogradRequiredBytes<double>(256, 256, 256, StorageLayout::Split, Strassen::cutoff())
+          < StrassenWorkspace::requiredBytes<double>(256, 256, 256, StorageLayout::Split, Strassen::cutoff()) / 4);
+}
+
+TEST_CASE("Autotuner profiles") {
+    CHECK(TuningProfile::active() == testProfile());
+    CHECK(Strassen::cutoff() == 8);
+
+    std::string path = (std::filesystem::temp_directory_path() / "lab3-tuning-test" / "host.profile").string();
+    AutotuneOptions options;
+    options.size = 48;
+    options.repetitions = 1;
+    options.strassenCutoffs = { 8, 16 };
+    options.gemmRowBlocks = { 32, 64 };
+    options.gemmDepthBlocks = { 16, 64 };
+    options.gemmColumnBlocks = { 24, 512 };
+    options.parallelBlockSizes = { 20, 48 };
+    options.threads = { 1, 2 };
+    options.luRowsPerThread = { 8 };
+    options.strassenTaskDepths = { 1 };
+    options.strassenTaskSizes = { 16 };
+    TuningProfile tuned = Autotuner::tuneAndSave(path, options);
+    CHECK(TuningProfile::active() == tuned);
+    CHECK((tuned.strassenCutoff == 8 || tuned.strassenCutoff == 16));
+    CHECK((tuned.gemmDepthBlock == 16 || tuned.gemmDepthBlock == 64));
+    CHECK((tuned.threads == 1 || tuned.threads == 2));
+    CHECK(TuningProfile::load(path) == tuned);
+
+    // Odd blocks and the tuned parameters give the same products.
+    ComplexMatrix A(45, 37), B(37, 51);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+    TuningProfile odd = tuned;
+    odd.gemmRowBlock = 7;
+    odd.gemmDepthBlock = 5;
+    odd.gemmColumnBlock = 9;
+    TuningProfile::setActive(odd);
+    ComplexMatrix expected = A * B;
+    CHECK(A.multiply(B, MultiplyMode::ThreeM) == expected);
+    TuningProfile::setActive(tuned);
+    CHECK(A * B == expected);
+    ComplexMatrix* parallel = ParallelStrassen::parallelMultiply(&A, &B);
+    CHECK(*parallel == expected);
+    delete parallel;
+
+    {
+        std::ofstream file(path);
+        file << "# partial profile\nstrassen_cutoff = 96\ngemm_row_block = -3\nunknown = 1\nthreads=0\n";
+    }
+    TuningProfile partial = TuningProfile::load(path);
+    CHECK(partial.strassenCutoff == 96);
+    CHECK(partial.gemmRowBlock == TuningProfile::DEFAULT_GEMM_ROW_BLOCK);
+    CHECK(partial.threads == 0);
+    CHECK(partial.threadCount() >= 1);
+    CHECK_THROWS_AS(TuningProfile::load(path + ".missing"), std::runtime_error);
+
+    std::filesystem::remove_all(std::filesystem::path(path).parent_path());
+    TuningProfile::setActive(testProfile());
+}
+
+TEST_CASE("Thread pool and parallel tiled multiply") {
+    ThreadPool pool(4);
+    CHECK(pool.size() == 4);
+
+    std::vector<int> hits(1000, 0);
+    pool.parallelFor(1000, [&](int i) { hits[i]++; });
+    CHECK(std::count(hits.begin(), hits.end(), 1) == 1000);
+
+    // Nested loops finish even though every worker is blocked in an outer task.
+    std::vector<int> nested(8 * 50, 0);
+    pool.parallelFor(8, [&](int i) {
+        pool.parallelFor(50, [&](int j) { nested[i * 50 + j]++; });
+    });
+    CHECK(std::count(nested.begin(), nested.end(), 1) == 8 * 50);
+
+    TuningProfile profile = testProfile();
+    profile.threads = 3;
+    profile.parallelBlockSize = 64;
+    TuningProfile::setActive(profile);
+    ComplexMatrix A(200, 130), B(130, 150);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix* product = ParallelStrassen::parallelMultiply(&A, &B);
+    CHECK(*product == A * B);
+    delete product;
+
+    ComplexMatrix splitA = A.toLayout(StorageLayout::Split);
+    ComplexMatrix small(5, 130);
+    small.auto_gen(-5, 5, -5, 5);
+    product = ParallelStrassen::parallelMultiply(&small, &B);
+    CHECK(*product == small * B);
+    delete product;
+    product = ParallelStrassen::parallelMultiply(&splitA, &B);
+    CHECK(*product == A * B);
+    delete product;
+    TuningProfile::setActive(testProfile());
+}
+
+TEST_CASE("Task-parallel Strassen on the shared pool") {
+    ComplexMatrix A(200, 130), B(130, 150);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix expected = A * B;
+
+    TuningProfile profile = testProfile();
+    profile.threads = 3;
+    profile.strassenTaskSize = 16;
+    for (int depth : { 1, 3 }) {
+        profile.strassenTaskDepth = depth;
+        TuningProfile::setActive(profile);
+        ComplexMatrix* product = ParallelStrassen::strassenMultiply(&A, &B);
+        CHECK(*product == expected);
+        delete product;
+    }
+
+    ComplexMatrix splitA = A.toLayout(StorageLayout::Split);
+    ComplexMatrix splitB = B.toLayout(StorageLayout::Split);
+    ComplexMatrix* product = ParallelStrassen::strassenMultiply(&splitA, &splitB);
+    CHECK(*product == expected);
+    delete product;
+
+    // Spawning stops at the size bound, leaving the recursion to BasicStrassen.
+    profile.strassenTaskSize = 1000;
+    TuningProfile::setActive(profile);
+    product = ParallelStrassen::strassenMultiply(&A, &B);
+    CHECK(*product == expected);
+    delete product;
+    TuningProfile::setActive(testProfile());
+}
+
+TEST_CASE("Batched small-matrix products and inverses") {
+    // Dense row-major copies, the layout the batch API takes.
+    auto pack = [](const ComplexMatrix& matrix, std::vector<ComplexNum>& out) {
+        for (int i = 0; i < matrix.getRows(); i++)
+            for (int j = 0; j < matrix.getColumns(); j++)
+                out.push_back(matrix.get(i, j));
+    };
+    auto unpack = [](const ComplexNum* data, int rows, int columns) {
+        ComplexMatrix matrix(rows, columns);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < columns; j++)
+                matrix.set(i, j, data[i * columns + j]);
+        return matrix;
+    };
+
+    const int count = 37;
+    std::vector<ComplexMatrix> as, bs;
+    std::vector<ComplexNum> a, b;
+    for (int k = 0; k < count; k++) {
+        as.emplace_back(5, 7);
+        bs.emplace_back(7, 6);
+        as.back().auto_gen(-5, 5, -5, 5);
+        bs.back().auto_gen(-5, 5, -5, 5);
+        pack(as.back(), a);
+        pack(bs.back(), b);
+    }
+    std::vector<ComplexNum> c(count * 5 * 6);
+    ComplexBatch::multiply(count, 5, 7, 6, a.data(), 35, b.data(), 42, c.data(), 30);
+    bool productsMatch = true;
+    for (int k = 0; k < count; k++)
+        productsMatch = productsMatch && unpack(c.data() + k * 30, 5, 6) == as[k] * bs[k];
+    CHECK(productsMatch);
+
+    // Variable sizes: interleaved shapes are grouped, results land at their own offsets.
+    std::vector<BatchProduct> products;
+    std::vector<ComplexNum> va, vb;
+    std::size_t offsetC = 0;
+    std::vector<ComplexMatrix> expected;
+    for (int k = 0; k < 20; k++) {
+        int rows = 2 + k % 3, depth = 4 + k % 2, columns = 3;
+        ComplexMatrix x(rows, depth), y(depth, columns);
+        x.auto_gen(-5, 5, -5, 5);
+        y.auto_gen(-5, 5, -5, 5);
+        products.push_back({ rows, depth, columns, va.size(), vb.size(), offsetC });
+        pack(x, va);
+        pack(y, vb);
+        offsetC += rows * columns;
+        expected.push_back(x * y);
+    }
+    std::vector<ComplexNum> vc(offsetC);
+    ComplexBatch::multiply(products, va.data(), vb.data(), vc.data());
+    bool variableMatch = true;
+    for (int k = 0; k < 20; k++)
+        variableMatch = variableMatch && unpack(vc.data() + products[k].c, products[k].rows, products[k].columns) == expected[k];
+    CHECK(variableMatch);
+
+    // Inverses of mixed sizes, with one singular matrix among them.
+    std::vector<BatchInverse> inverses;
+    std::vector<ComplexMatrix> originals;
+    std::vector<ComplexNum> ia;
+    for (int k = 0; k < 19; k++) {
+        int size = k % 2 == 0 ? 4 : 9;
+        ComplexMatrix m(size, size);
+        m.auto_gen(-5, 5, -5, 5);
+        if (k == 6)
+            for (int j = 0; j < size; j++)
+                m.set(2, j, ComplexNum(0, 0));
+        inverses.push_back({ size, ia.size(), ia.size() });
+        pack(m, ia);
+        originals.push_back(m);
+    }
+    std::vector<ComplexNum> inv(ia.size());
+    bool invertible[19];
+    CHECK(ComplexBatch::invert(inverses, ia.data(), inv.data(), invertible) == 18);
+    CHECK_FALSE(invertible[6]);
+    CHECK(unpack(inv.data() + inverses[6].inverse, 4, 4) == ComplexMatrix(4, 4));
+    bool identities = true;
+    for (int k = 0; k < 19; k++) {
+        if (k == 6)
+            continue;
+        ComplexMatrix product = originals[k] * unpack(inv.data() + inverses[k].inverse, inverses[k].size, inverses[k].size);
+        identities = identities && invertible[k] && isIdentityMatrix(product);
+    }
+    CHECK(identities);
+
+    // Fixed stride with a gap between matrices, in single precision.
+    std::vector<ComplexNumF> fa(count * 20), fi(count * 20);
+    for (int k = 0; k < count; k++)
+        for (int e = 0; e < 16; e++)
+            fa[k * 20 + e] = ComplexNumF(static_cast<float>((e * 7 + k) % 11) - 5, e % 5 == e / 4 ? 9.0f : 0.5f);
+    CHECK(ComplexBatchF::invert(count, 4, fa.data(), 20, fi.data(), 20) == count);
+    bool floatIdentities = true;
+    for (int k = 0; k < count; k++) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                ComplexNumF sum;
+                for (int p = 0; p < 4; p++)
+                    sum = sum + fa[k * 20 + i * 4 + p] * fi[k * 20 + p * 4 + j];
+                floatIdentities = floatIdentities && sum == ComplexNumF(i == j ? 1.0f : 0.0f, 0.0f);
+            }
+        }
+    }
+    CHECK(floatIdentities);
+}
+
+TEST_CASE("Complex GEMV") {
+    ComplexNum alpha(0.5, -1.5), beta(2, 0.25);
+    // 300 x 310 is past PARALLEL_THRESHOLD; 70 x 1100 straddles ROW_BLOCK and COLUMN_BLOCK.
+    for (auto shape : { std::pair<int, int>(5, 7), std::pair<int, int>(70, 1100), std::pair<int, int>(300, 310) }) {
+        for (StorageLayout layout : { StorageLayout::Interleaved, StorageLayout::Split }) {
+            ComplexMatrix A(shape.first, shape.second, layout);
+            A.auto_gen(-1, 1, -1, 1);
+            for (GemvOperation operation : { GemvOperation::NoTranspose, GemvOperation::Transpose, GemvOperation::ConjugateTranspose }) {
+                bool transposed = operation != GemvOperation::NoTranspose;
+                int n = transposed ? A.getRows() : A.getColumns();
+                int m = transposed ? A.getColumns() : A.getRows();
+                std::vector<ComplexNum> x(n), y(m), expected(m);
+                for (int j = 0; j < n; j++)
+                    x[j] = ComplexNum(j % 5 - 2, 1 - j % 3);
+                for (int i = 0; i < m; i++) {
+                    y[i] = ComplexNum(i % 4, -1);
+                    ComplexNum sum;
+                    for (int j = 0; j < n; j++) {
+                        ComplexNum element = transposed ? A.get(j, i) : A.get(i, j);
+                        if (operation == GemvOperation::ConjugateTranspose)
+                            element = ComplexNum(element.getReal(), -element.getImag());
+                        sum.addProduct(element, x[j]);
+                    }
+                    expected[i] = alpha * sum + beta * y[i];
+                }
+                ComplexGemv::multiply(operation, alpha, ComplexMatrixView(A), x.data(), beta, y.data());
+                bool match = true;
+                for (int i = 0; i < m; i++)
+                    match = match && y[i] == expected[i];
+                CHECK(match);
+            }
+        }
+    }
+
+    // beta == 0 overwrites y even when it holds garbage, and operator* matches the GEMM.
+    ComplexMatrix A(40, 30);
+    A.auto_gen(-5, 5, -5, 5);
+    std::vector<ComplexNum> x(30);
+    ComplexMatrix column(30, 1);
+    for (int j = 0; j < 30; j++) {
+        x[j] = ComplexNum(j, 1);
+        column.set(j, 0, x[j]);
+    }
+    std::vector<ComplexNum> y(40, ComplexNum(std::nan(""), 0));
+    ComplexGemv::multiply(GemvOperation::NoTranspose, ComplexNum(1, 0), ComplexMatrixView(A), x.data(), ComplexNum(), y.data());
+    ComplexMatrix product = A * column;
+    std::vector<ComplexNum> viaOperator = A * x;
+    for (int i = 0; i < 40; i++) {
+        CHECK(y[i] == product.get(i, 0));
+        CHECK(viaOperator[i] == product.get(i, 0));
+    }
+
+    // Several right-hand sides at once, as columns of strided views.
+    ComplexMatrix X(40, 3), Y(30, 3);
+    X.auto_gen(-1, 1, -1, 1);
+    Y.auto_gen(-1, 1, -1, 1);
+    ComplexMatrix expectedY = Y;
+    for (int r = 0; r < 3; r++) {
+        std::vector<ComplexNum> xr(40), yr(30);
+        for (int i = 0; i < 40; i++)
+            xr[i] = X.get(i, r);
+        for (int i = 0; i < 30; i++)
+            yr[i] = Y.get(i, r);
+        ComplexGemv::multiply(GemvOperation::ConjugateTranspose, alpha, ComplexMatrixView(A), xr.data(), beta, yr.data());
+        for (int i = 0; i < 30; i++)
+            expectedY.set(i, r, yr[i]);
+    }
+    ComplexGemv::multiply(GemvOperation::ConjugateTranspose, alpha, ComplexMatrixView(A), ComplexMatrixView(X), beta, ComplexMatrixView(Y));
+    CHECK(Y == expectedY);
+
+    // The blocked LU solve crosses several SOLVE_BLOCKs.
+    ComplexMatrix M(150, 150);
+    M.auto_gen(-5, 5, -5, 5);
+    LUFactorization factorization(M);
+    REQUIRE(factorization.isInvertible());
+    std::vector<ComplexNum> solution(150);
+    for (int i = 0; i < 150; i++)
+        solution[i] = ComplexNum(i % 7 - 3, i % 2);
+    std::vector<ComplexNum> b = M * solution;
+    factorization.solve(b.data());
+    bool solved = true;
+    for (int i = 0; i < 150; i++)
+        solved = solved && b[i] == solution[i];
+    CHECK(solved);
+}
+
+TEST_CASE("Hermitian rank-k update and Cholesky inverse") {
+    // 300 rows span three column blocks and take the pool path; 5 rows fit in one diagonal tile.
+    for (auto shape : { std::pair<int, int>(5, 3), std::pair<int, int>(300, 50) }) {
+        int n = shape.first;
+        int depth = shape.second;
+        ComplexMatrix A(n, depth, StorageLayout::Split);
+        A.auto_gen(-3, 3, -3, 3);
+        ComplexMatrix AH(depth, n);
+        for (int i = 0; i < n; i++)
+            for (int p = 0; p < depth; p++)
+                AH.set(p, i, ComplexNum(A.get(i, p).getReal(), -A.get(i, p).getImag()));
+        ComplexMatrix gram = A * AH;
+
+        for (HermitianTriangle triangle : { HermitianTriangle::Lower, HermitianTriangle::Upper })
+        for (StorageLayout layout : { StorageLayout::Interleaved, StorageLayout::Split }) {
+            ComplexMatrix C(n, n, layout);
+            C.auto_gen(-3, 3, -3, 3);
+            ComplexMatrix before = C;
+            ComplexHerk::update(triangle, 0.5, ComplexMatrixView(A), -2, ComplexMatrixView(C));
+            bool match = true;
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++) {
+                    bool inside = triangle == HermitianTriangle::Lower ? i >= j : i <= j;
+                    ComplexNum expected = inside ? ComplexNum(0.5, 0) * gram.get(i, j) + ComplexNum(-2, 0) * before.get(i, j) : before.get(i, j);
+                    if (i == j)
+                        expected = ComplexNum(expected.getReal(), 0);
+                    match = match && C.get(i, j) == expected;
+                }
+            CHECK(match);
+        }
+
+        ComplexMatrix product = ComplexHerk::product(A);
+        CHECK(product.isHermitian());
+        CHECK(product == gram);
+    }
+
+    // A * A^H + I is Hermitian positive definite; the factory takes the Cholesky path for it.
+    ComplexMatrix A(90, 40);
+    A.auto_gen(-2, 2, -2, 2);
+    ComplexMatrix M = ComplexHerk::product(A);
+    for (int i = 0; i < 90; i++)
+        M.set(i, i, M.get(i, i) + ComplexNum(1, 0));
+    CHECK_FALSE(M.isHermitian());
+    M.setHermitian(true);
+
+    CholeskyFactorization cholesky(M);
+    REQUIRE(cholesky.isPositiveDefinite());
+    std::vector<ComplexNum> x(90);
+    for (int i = 0; i < 90; i++)
+        x[i] = ComplexNum(i % 5 - 2, i % 3);
+    std::vector<ComplexNum> b = M * x;
+    cholesky.solve(b.data());
+    bool solved = true;
+    for (int i = 0; i < 90; i++)
+        solved = solved && b[i] == x[i];
+    CHECK(solved);
+    CHECK(cholesky.inverse(4) == cholesky.inverse());
+
+    ComplexMatrix identity(90, 90);
+    for (int i = 0; i < 90; i++)
+        identity.set(i, i, ComplexNum(1, 0));
+    for (InverseAlgorithm algorithm : { InverseAlgorithm::LU, InverseAlgorithm::ParallelLU }) {
+        ComplexMatrix inverse = MatrixInverseFactory::calculateInverse(M, algorithm);
+        CHECK(inverse.isHermitian());
+        CHECK(M * inverse == identity);
+        CHECK(inverse.get(3, 70).getImag() == -inverse.get(70, 3).getImag());
+    }
+
+    // A write through a view keeps the flag, but the factory sees A != A^H and uses LU instead.
+    ComplexMatrix edited = M;
+    ComplexMatrixView(edited).set(0, 89, ComplexNum(3, 1));
+    REQUIRE(edited.isHermitian());
+    ComplexMatrix editedInverse = MatrixInverseFactory::calculateInverse(edited, InverseAlgorithm::LU);
+    CHECK_FALSE(editedInverse.isHermitian());
+    ComplexMatrix editedProduct = edited * editedInverse;
+    CHECK(editedProduct == identity);
+
+    // Copies keep the flag and sums of flagged matrices keep it; writes through the matrix drop it.
+    ComplexMatrix copy = M;
+    CHECK(copy.isHermitian());
+    ComplexMatrix sum;
+    M.addTo(copy, sum);
+    CHECK(sum.isHermitian());
+    CHECK(M.toLayout(StorageLayout::Split).isHermitian());
+    copy.set(0, 1, ComplexNum(1, 1));
+    CHECK_FALSE(copy.isHermitian());
+    M.addTo(copy, sum);
+    CHECK_FALSE(sum.isHermitian());
+
+    // A flagged Hermitian matrix that is indefinite falls back to LU.
+    ComplexMatrix indefinite(20, 20);
+    for (int i = 0; i < 20; i++)
+        indefinite.set(i, i, ComplexNum(i % 2 == 0 ? 1 : -1, 0));
+    indefinite.setHermitian(true);
+    CHECK_FALSE(CholeskyFactorization(indefinite).isPositiveDefinite());
+    ComplexMatrix indefiniteInverse = MatrixInverseFactory::calculateInverse(indefinite, InverseAlgorithm::LU);
+    CHECK(indefiniteInverse == indefinite);
+}
+
+TEST_CASE("Morton layout and Strassen on it") {
+    int tile = 0;
+    int levels = 0;
+    MortonComplexMatrix::shapeFor(1000, 256, tile, levels);
+    CHECK(levels == 2);
+    CHECK(tile == 250);
+    MortonComplexMatrix::shapeFor(100, 256, tile, levels);
+    CHECK(levels == 0);
+    CHECK(tile == 100);
+
+    // 300 x 300 converts on the pool; 37 x 53 leaves most leaves partly padded.
+    for (auto shape : { std::pair<int, int>(37, 53), std::pair<int, int>(300, 300) }) {
+        for (StorageLayout layout : { StorageLayout::Interleaved, StorageLayout::Split }) {
+            ComplexMatrix M(shape.first, shape.second, layout);
+            M.auto_gen(-5, 5, -5, 5);
+            MortonComplexMatrix::shapeFor(std::max(shape.first, shape.second), 20, tile, levels);
+            MortonComplexMatrix morton = MortonComplexMatrix::fromMatrix(M, tile, levels);
+            CHECK(morton.getSide() >= std::max(shape.first, shape.second));
+
+            bool match = true;
+            for (int i = 0; i < morton.getSide(); i++)
+                for (int j = 0; j < morton.getSide(); j++)
+                    match = match && morton.get(i, j) == (i < shape.first && j < shape.second ? M.get(i, j) : ComplexNum());
+            CHECK(match);
+            CHECK(morton.toMatrix(layout) == M);
+
+            // Each quadrant of the top level starts one quarter further into the buffer.
+            int half = morton.getSide() / 2;
+            std::size_t quarter = morton.quarterSize(morton.getLevels());
+            CHECK(morton.data()[quarter] == morton.get(0, half));
+            CHECK(morton.data()[2 * quarter] == morton.get(half, 0));
+            CHECK(morton.data()[3 * quarter + 1] == morton.get(half, half + 1));
+        }
+    }
+
+    // The test profile's cutoff of 8 makes these several levels deep.
+    ComplexMatrix A(70, 45), B(45, 90, StorageLayout::Split);
+    A.auto_gen(-5, 5, -5, 5);
+    B.auto_gen(-5, 5, -5, 5);
+    ComplexMatrix expected = A * B;
+    for (MultiplyMode mode : { MultiplyMode::Classic, MultiplyMode::ThreeM }) {
+        ComplexMatrix* product = Strassen::mortonMultiply(&A, &B, mode);
+        CHECK(*product == expected);
+        delete product;
+    }
+
+    MortonComplexMatrix::shapeFor(90, Strassen::cutoff(), tile, levels);
+    MortonComplexMatrix product;
+    Strassen::mortonRecursion(MortonComplexMatrix::fromMatrix(A, tile, levels), MortonComplexMatrix::fromMatrix(B, tile, levels), product);
+    CHECK(product.getRows() == 70);
+    CHECK(product.getColumns() == 90);
+    CHECK(product.toMatrix() == expected);
+
+    // A top-level quadrant of 256 << 8 per side has 2^32 elements, past int; the byte count must not wrap.
+    CHECK(StrassenWorkspace::mortonRequiredBytes<double>(256, 9) >= 3 * (std::size_t(1) << 32) * sizeof(ComplexNum));
+
+    // Storage comes from MatrixAllocator, and copies and moves own their buffers.
+    CHECK(reinterpret_cast<std::uintptr_t>(product.data()) % MatrixAllocator::ALIGNMENT == 0);
+    MortonComplexMatrix copy = product;
+    CHECK(copy.data() != product.data());
+    CHECK(copy.toMatrix() == expected);
+    MortonComplexMatrix moved = std::move(copy);
+    CHECK(moved.toMatrix() == expected);
+    copy = moved;
+    CHECK(copy.toMatrix() == expected);
+
+    BasicComplexMatrix<float> F(40, 40);
+    F.auto_gen(-3, 3, -3, 3);
+    MortonComplexMatrixF::shapeFor(40, 16, tile, levels);
+    MortonComplexMatrixF mortonF = MortonComplexMatrixF::fromMatrix(F, tile, levels);
+    CHECK(reinterpret_cast<std::uintptr_t>(mortonF.data()) % MatrixAllocator::ALIGNMENT == 0);
+    CHECK(mortonF.toMatrix() == F);
+}
@@ -0,0 +1,164 @@
+#include "ThreadPool.h"
+#include "TuningProfile.h"
+#include <algorithm>
+
+namespace {
+    /// @brief Pool and deque index of the calling thread when it is a pool worker.
+    thread_local ThreadPool* currentPool = nullptr;
+    thread_local int currentWorker = -1;
+
+    /// @brief Progress of one parallelFor. Shared with the helper jobs, which may start only after
+    /// the call has returned (every index already taken) and must still find it alive.
+    struct ParallelForState {
+        std::atomic<int> next{ 0 };
+        int count = 0;
+        int finished = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    /// @brief Claims and runs indices until none are left.
+    void drain(ParallelForState& state, const std::function<void(int)>& task)
+    {
+        int completed = 0;
+        for (int i = state.next.fetch_add(1); i < state.count; i = state.next.fetch_add(1))
+        {
+            task(i);
+            completed++;
+        }
+        if (completed == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.finished += completed;
+        if (state.finished == state.count)
+            state.done.notify_all();
+    }
+}
+
+ThreadPool::ThreadPool(unsigned int threads) : pending(0), stopping(false)
+{
+    unsigned int count = std::max(1u, threads) - 1;
+    queues.reserve(count);
+    for (unsigned int i = 0; i < count; i++)
+        queues.push_back(std::make_unique<WorkerQueue>());
+    workers.reserve(count);
+    for (unsigned int i = 0; i < count; i++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<int>(i));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+unsigned int ThreadPool::size() const
+{
+    return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+void ThreadPool::workerLoop(int index)
+{
+    currentPool = this;
+    currentWorker = index;
+    for (;;)
+    {
+        std::function<void()> job;
+        if (take(index, job))
+        {
+            job();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        available.wait(lock, [this]() { return stopping || pending.load() > 0; });
+        if (stopping && pending.load() == 0)
+            return;
+    }
+}
+
+bool ThreadPool::take(int index, std::function<void()>& job)
+{
+    auto popFront = [&job](WorkerQueue& queue) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            return false;
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    };
+
+    bool found = false;
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+    if (!found)
+        found = popFront(injected);
+    int count = static_cast<int>(queues.size());
+    for (int offset = 1; !found && offset < count; offset++)
+        found = popFront(*queues[(index + offset) % count]);
+
+    if (found)
+        pending.fetch_sub(1);
+    return found;
+}
+
+void ThreadPool::post(std::function<void()> job)
+{
+    WorkerQueue& queue = currentPool == this ? *queues[currentWorker] : injected;
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+    {
+        // Raised under the sleep lock so a worker deciding to sleep cannot miss it.
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending.fetch_add(1);
+    }
+    available.notify_one();
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task, unsigned int maxThreads)
+{
+    if (count <= 0)
+        return;
+
+    unsigned int threads = maxThreads == 0 ? size() : std::min(maxThreads, size());
+    int helpers = std::min<int>(static_cast<int>(threads) - 1, count - 1);
+    if (helpers <= 0)
+    {
+        for (int i = 0; i < count; i++)
+            task(i);
+        return;
+    }
+
+    // Helpers copy the task, so a late starter never reads the caller's stack.
+    auto state = std::make_shared<ParallelForState>();
+    state->count = count;
+    auto shared = std::make_shared<std::function<void(int)>>(task);
+    for (int h = 0; h < helpers; h++)
+        post([state, shared]() { drain(*state, *shared); });
+
+    drain(*state, task);
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state]() { return state->finished == state->count; });
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool(TuningProfile::active().threadCount());
+    return pool;
+}
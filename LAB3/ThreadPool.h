@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Fixed set of worker threads shared by the parallel engines, so a multiply does not
+/// pay for creating and joining threads. Work is handed out through parallelFor, where the
+/// calling thread takes part too; a parallelFor issued from inside a task therefore makes
+/// progress even when every worker is busy.
+/// Scheduling is work-stealing: each worker owns a deque that the jobs it posts go to and that
+/// it pops newest-first, jobs from other threads go to a shared injection queue, and an idle
+/// worker takes from its own deque, then the injection queue, then the oldest job of another.
+class ThreadPool
+{
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    WorkerQueue injected;
+    std::atomic<int> pending;
+    std::mutex sleepMutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void workerLoop(int index);
+
+    void post(std::function<void()> job);
+
+    /// @brief Next job for worker index in the order above; false when every queue is empty.
+    bool take(int index, std::function<void()>& job);
+
+public:
+    /// @brief Starts threads - 1 workers; the thread calling parallelFor is the last one.
+    explicit ThreadPool(unsigned int threads);
+
+    ThreadPool(const ThreadPool&) = delete;
+
+    ThreadPool& operator =(const ThreadPool&) = delete;
+
+    /// @brief Finishes the queued jobs and joins the workers.
+    ~ThreadPool();
+
+    /// @brief Threads that run tasks: the workers plus the caller.
+    unsigned int size() const;
+
+    /// @brief Runs task(0) .. task(count - 1), each exactly once, on up to maxThreads threads
+    /// (0 means size()), and returns when all have finished. Indices are claimed dynamically,
+    /// so uneven tasks balance out. While waiting, the caller only runs indices of this call,
+    /// so per-thread scratch used in a stack-like way (StrassenWorkspace) stays consistent.
+    /// Tasks must not throw.
+    void parallelFor(int count, const std::function<void(int)>& task, unsigned int maxThreads = 0);
+
+    /// @brief Pool of the process, sized from the active TuningProfile on first use.
+    static ThreadPool& shared();
+};
@@ -0,0 +1,193 @@
+#include "TuningProfile.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace {
+    /// @brief Parses a positive integer field; anything else leaves the field unchanged.
+    void readPositive(const std::string& value, int& field)
+    {
+        std::istringstream stream(value);
+        long parsed = 0;
+        if (stream >> parsed && stream.eof() && parsed > 0 && parsed <= (1 << 20))
+            field = static_cast<int>(parsed);
+    }
+
+    std::string trim(const std::string& text)
+    {
+        std::size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos)
+            return std::string();
+        std::size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    std::string hostName()
+    {
+#ifdef __linux__
+        char name[256] = {};
+        if (gethostname(name, sizeof(name) - 1) == 0 && name[0] != '\0')
+            return name;
+#endif
+        return "localhost";
+    }
+
+    TuningProfile loadHostProfile()
+    {
+        std::string path = TuningProfile::hostPath();
+        std::error_code error;
+        if (!std::filesystem::exists(path, error))
+            return TuningProfile::defaults();
+        try
+        {
+            return TuningProfile::load(path);
+        }
+        catch (const std::runtime_error&)
+        {
+            return TuningProfile::defaults();
+        }
+    }
+
+    TuningProfile& activeProfile()
+    {
+        static TuningProfile profile = loadHostProfile();
+        return profile;
+    }
+}
+
+TuningProfile TuningProfile::defaults()
+{
+    TuningProfile profile;
+    profile.strassenCutoff = DEFAULT_STRASSEN_CUTOFF;
+    profile.gemmRowBlock = DEFAULT_GEMM_ROW_BLOCK;
+    profile.gemmDepthBlock = DEFAULT_GEMM_DEPTH_BLOCK;
+    profile.gemmColumnBlock = DEFAULT_GEMM_COLUMN_BLOCK;
+    profile.parallelBlockSize = DEFAULT_PARALLEL_BLOCK_SIZE;
+    profile.luRowsPerThread = DEFAULT_LU_ROWS_PER_THREAD;
+    profile.strassenTaskDepth = DEFAULT_STRASSEN_TASK_DEPTH;
+    profile.strassenTaskSize = DEFAULT_STRASSEN_TASK_SIZE;
+    profile.threads = 0;
+    return profile;
+}
+
+const TuningProfile& TuningProfile::active()
+{
+    return activeProfile();
+}
+
+void TuningProfile::setActive(const TuningProfile& profile)
+{
+    activeProfile() = profile;
+}
+
+TuningProfile TuningProfile::load(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Cannot open tuning profile " + path);
+
+    TuningProfile profile = defaults();
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.erase(comment);
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos)
+            continue;
+
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+        if (key == "strassen_cutoff")
+            readPositive(value, profile.strassenCutoff);
+        else if (key == "gemm_row_block")
+            readPositive(value, profile.gemmRowBlock);
+        else if (key == "gemm_depth_block")
+            readPositive(value, profile.gemmDepthBlock);
+        else if (key == "gemm_column_block")
+            readPositive(value, profile.gemmColumnBlock);
+        else if (key == "parallel_block_size")
+            readPositive(value, profile.parallelBlockSize);
+        else if (key == "lu_rows_per_thread")
+            readPositive(value, profile.luRowsPerThread);
+        else if (key == "strassen_task_depth")
+            readPositive(value, profile.strassenTaskDepth);
+        else if (key == "strassen_task_size")
+            readPositive(value, profile.strassenTaskSize);
+        else if (key == "threads")
+        {
+            int threads = static_cast<int>(profile.threads);
+            if (value == "0")
+                threads = 0;
+            else
+                readPositive(value, threads);
+            profile.threads = static_cast<unsigned int>(threads);
+        }
+    }
+    return profile;
+}
+
+void TuningProfile::save(const std::string& path) const
+{
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    std::error_code error;
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, error);
+
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("Cannot write tuning profile " + path);
+
+    file << "# Written by Autotuner for " << hostName() << "\n"
+        << "strassen_cutoff = " << strassenCutoff << "\n"
+        << "gemm_row_block = " << gemmRowBlock << "\n"
+        << "gemm_depth_block = " << gemmDepthBlock << "\n"
+        << "gemm_column_block = " << gemmColumnBlock << "\n"
+        << "parallel_block_size = " << parallelBlockSize << "\n"
+        << "lu_rows_per_thread = " << luRowsPerThread << "\n"
+        << "strassen_task_depth = " << strassenTaskDepth << "\n"
+        << "strassen_task_size = " << strassenTaskSize << "\n"
+        << "threads = " << threads << "\n";
+    if (!file.flush())
+        throw std::runtime_error("Cannot write tuning profile " + path);
+}
+
+std::string TuningProfile::hostPath()
+{
+    const char* overridePath = std::getenv("LAB3_TUNING_PROFILE");
+    if (overridePath != nullptr && overridePath[0] != '\0')
+        return overridePath;
+
+    const char* home = std::getenv("HOME");
+    std::string base = home != nullptr && home[0] != '\0' ? home : ".";
+    return base + "/.cache/lab3/tuning-" + hostName() + ".profile";
+}
+
+unsigned int TuningProfile::threadCount() const
+{
+    if (threads != 0)
+        return threads;
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+bool TuningProfile::operator ==(const TuningProfile& other) const
+{
+    return strassenCutoff == other.strassenCutoff
+        && gemmRowBlock == other.gemmRowBlock
+        && gemmDepthBlock == other.gemmDepthBlock
+        && gemmColumnBlock == other.gemmColumnBlock
+        && parallelBlockSize == other.parallelBlockSize
+        && luRowsPerThread == other.luRowsPerThread
+        && strassenTaskDepth == other.strassenTaskDepth
+        && strassenTaskSize == other.strassenTaskSize
+        && threads == other.threads;
+}
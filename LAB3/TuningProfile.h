@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+
+/// @brief Machine-dependent parameters of the multiply and factorization engines.
+/// The engines read the active profile on every call instead of compiled-in constants. On first
+/// use it is loaded from the per-host file written by the Autotuner (see hostPath()); hosts that
+/// were never tuned run with defaults(). The file is plain "key = value" lines; unknown keys and
+/// values out of range are ignored, so an old profile keeps working after a parameter is added.
+/// setActive() is not synchronized with running engines: call it before starting them.
+class TuningProfile
+{
+public:
+    static constexpr int DEFAULT_STRASSEN_CUTOFF = 256;
+    static constexpr int DEFAULT_GEMM_ROW_BLOCK = 128;
+    static constexpr int DEFAULT_GEMM_DEPTH_BLOCK = 256;
+    static constexpr int DEFAULT_GEMM_COLUMN_BLOCK = 2048;
+    static constexpr int DEFAULT_PARALLEL_BLOCK_SIZE = 256;
+    static constexpr int DEFAULT_LU_ROWS_PER_THREAD = 64;
+    static constexpr int DEFAULT_STRASSEN_TASK_DEPTH = 2;
+    static constexpr int DEFAULT_STRASSEN_TASK_SIZE = 512;
+
+    /// @brief Strassen recursion falls back to the GEMM once a dimension is <= this.
+    int strassenCutoff;
+    /// @brief GEMM blocking: rows of A packed per block (MC), shared depth (KC) and columns of B (NC).
+    int gemmRowBlock;
+    int gemmDepthBlock;
+    int gemmColumnBlock;
+    /// @brief Edge of the blocks ParallelStrassen splits a product into.
+    int parallelBlockSize;
+    /// @brief Rows of the LU trailing update handed to one thread.
+    int luRowsPerThread;
+    /// @brief Parallel Strassen runs its seven sub-products as pool tasks on the first
+    /// strassenTaskDepth levels, and only while every dimension exceeds strassenTaskSize.
+    int strassenTaskDepth;
+    int strassenTaskSize;
+    /// @brief Worker threads of the parallel engines; 0 means every hardware thread. The shared
+    /// ThreadPool is sized from the profile active when it is first used, so raising this later
+    /// in a process only caps the engines at the existing pool; the pool grows at the next start.
+    unsigned int threads;
+
+    /// @brief The compiled-in parameters.
+    static TuningProfile defaults();
+
+    /// @brief Profile the engines use, loaded from hostPath() on first call.
+    static const TuningProfile& active();
+
+    static void setActive(const TuningProfile& profile);
+
+    /// @brief Reads a profile written by save(); keys it does not set keep their defaults.
+    /// Throws std::runtime_error when the file cannot be opened.
+    static TuningProfile load(const std::string& path);
+
+    /// @brief Writes the profile, creating missing parent directories.
+    /// Throws std::runtime_error when the file cannot be written.
+    void save(const std::string& path) const;
+
+    /// @brief $LAB3_TUNING_PROFILE when set, otherwise ~/.cache/lab3/tuning-<hostname>.profile.
+    static std::string hostPath();
+
+    /// @brief threads with 0 resolved to the hardware thread count (at least 1).
+    unsigned int threadCount() const;
+
+    bool operator ==(const TuningProfile& other) const;
+};